@@ -1702,6 +1702,7 @@ do_connections_show (NmCli *nmc, int argc, char **argv)
 		const char *fields_str = NULL;
 		char *fields_common = NMC_FIELDS_CON_SHOW_COMMON;
 		const NMMetaAbstractInfo *const*tmpl;
+		const char *header_name;
 		NmcOutputField *arr;
 		NMC_OUTPUT_DATA_DEFINE_SCOPED (out);
 
@@ -1723,25 +1724,29 @@ do_connections_show (NmCli *nmc, int argc, char **argv)
 		arr = nmc_dup_fields_array (tmpl, NMC_OF_FLAG_MAIN_HEADER_ADD | NMC_OF_FLAG_FIELD_NAMES);
 		g_ptr_array_add (out.output_data, arr);
 
+		header_name = active_only
+		              ? _("NetworkManager active profiles")
+		              : _("NetworkManager connection profiles");
+
 		/* There might be active connections not present in connection list
 		 * (e.g. private connections of a different user). Show them as well. */
 		invisibles = get_invisible_active_connections (nmc);
-		for (i = 0; i < invisibles->len; i++)
+		for (i = 0; i < invisibles->len; i++) {
 			fill_output_connection_for_invisible (invisibles->pdata[i], nmc->nmc_config.print_output, out.output_data);
+			print_data_stream (&nmc->nmc_config, out_indices, header_name, 0, &out, FALSE);
+		}
 		g_ptr_array_free (invisibles, TRUE);
 
-		/* Sort the connections and fill the output data */
+		/* Sort the connections and print them as they are filled */
 		connections = nm_client_get_connections (nmc->client);
 		sorted_cons = sort_connections (connections, nmc, order);
-		for (i = 0; i < sorted_cons->len; i++)
+		for (i = 0; i < sorted_cons->len; i++) {
 			fill_output_connection (sorted_cons->pdata[i], nmc->client, nmc->nmc_config.print_output, out.output_data, active_only);
+			print_data_stream (&nmc->nmc_config, out_indices, header_name, 0, &out, FALSE);
+		}
 		g_ptr_array_free (sorted_cons, TRUE);
 
-		print_data_prepare_width (out.output_data);
-		print_data (&nmc->nmc_config, out_indices,
-		            active_only ? _("NetworkManager active profiles")
-		                        : _("NetworkManager connection profiles"),
-		            0, &out);
+		print_data_stream (&nmc->nmc_config, out_indices, header_name, 0, &out, TRUE);
 	} else {
 		gboolean new_line = FALSE;
 		gboolean without_fields = (nmc->required_fields == NULL);
@@ -193,6 +193,7 @@ usage (void)
 	              "  -f[ields] <field1,field2,...>|all|common       specify fields to output\n"
 	              "  -g[et-values] <field1,field2,...>|all|common   shortcut for -m tabular -t -f\n"
 	              "  -e[scape] yes|no                               escape columns separators in values\n"
+	              "  -j[son]                                        print one JSON object per line\n"
 	              "  -a[sk]                                         ask for missing parameters\n"
 	              "  -s[how-secrets]                                allow displaying passwords\n"
 	              "  -w[ait] <seconds>                              set timeout waiting for finishing operations\n"
@@ -276,6 +277,7 @@ static gboolean
 process_command_line (NmCli *nmc, int argc, char **argv)
 {
 	char *base;
+	gboolean get_values = FALSE;
 
 	base = strrchr (argv[0], '/');
 	if (base == NULL)
@@ -298,7 +300,7 @@ process_command_line (NmCli *nmc, int argc, char **argv)
 
 		if (argc == 1 && nmc->complete) {
 			nmc_complete_strings (argv[0], "--terse", "--pretty", "--mode", "--colors", "--escape",
-			                           "--fields", "--nocheck", "--get-values",
+			                           "--json", "--fields", "--nocheck", "--get-values",
 			                            "--wait", "--version", "--help", NULL);
 		}
 
@@ -309,7 +311,12 @@ process_command_line (NmCli *nmc, int argc, char **argv)
 		}
 
 		if (matches_arg (nmc, &argc, &argv, "-terse", NULL)) {
-			if (nmc->nmc_config.print_output == NMC_PRINT_TERSE) {
+			if (nmc->nmc_config.json_output) {
+				g_string_printf (nmc->return_text, _("Error: Option '--terse' is mutually exclusive with '--json'."));
+				nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+				return FALSE;
+			}
+			else if (nmc->nmc_config.print_output == NMC_PRINT_TERSE) {
 				g_string_printf (nmc->return_text, _("Error: Option '--terse' is specified the second time."));
 				nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
 				return FALSE;
@@ -332,8 +339,37 @@ process_command_line (NmCli *nmc, int argc, char **argv)
 				nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
 				return FALSE;
 			}
+			else if (nmc->nmc_config.json_output) {
+				g_string_printf (nmc->return_text, _("Error: Option '--pretty' is mutually exclusive with '--json'."));
+				nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+				return FALSE;
+			}
 			else
 				nmc->nmc_config_mutable.print_output = NMC_PRINT_PRETTY;
+		} else if (matches_arg (nmc, &argc, &argv, "-json", NULL)) {
+			if (nmc->nmc_config.json_output) {
+				g_string_printf (nmc->return_text, _("Error: Option '--json' is specified the second time."));
+				nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+				return FALSE;
+			}
+			else if (get_values) {
+				g_string_printf (nmc->return_text, _("Error: Option '--json' is mutually exclusive with '--get-values'."));
+				nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+				return FALSE;
+			}
+			else if (nmc->nmc_config.print_output == NMC_PRINT_TERSE) {
+				g_string_printf (nmc->return_text, _("Error: Option '--json' is mutually exclusive with '--terse'."));
+				nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+				return FALSE;
+			}
+			else if (nmc->nmc_config.print_output == NMC_PRINT_PRETTY) {
+				g_string_printf (nmc->return_text, _("Error: Option '--json' is mutually exclusive with '--pretty'."));
+				nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+				return FALSE;
+			}
+			/* values are printed in parsable form, like for '--terse' */
+			nmc->nmc_config_mutable.json_output = TRUE;
+			nmc->nmc_config_mutable.print_output = NMC_PRINT_TERSE;
 		} else if (matches_arg (nmc, &argc, &argv, "-mode", &value)) {
 			nmc->mode_specified = TRUE;
 			if (argc == 1 && nmc->complete)
@@ -380,6 +416,12 @@ process_command_line (NmCli *nmc, int argc, char **argv)
 		} else if (matches_arg (nmc, &argc, &argv, "-get-values", &value)) {
 			if (argc == 1 && nmc->complete)
 				complete_fields (argv[0], value);
+			if (nmc->nmc_config.json_output) {
+				g_string_printf (nmc->return_text, _("Error: Option '--get-values' is mutually exclusive with '--json'."));
+				nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+				return FALSE;
+			}
+			get_values = TRUE;
 			nmc->required_fields = g_strdup (value);
 			nmc->nmc_config_mutable.print_output = NMC_PRINT_TERSE;
 			/* We want fixed tabular mode here, but just set the mode specified and rely on the initialization
@@ -577,6 +619,7 @@ nmc_init (NmCli *nmc)
 	nmc->ask = FALSE;
 	nmc->complete = FALSE;
 	nmc->nmc_config_mutable.show_secrets = FALSE;
+	nmc->nmc_config_mutable.json_output = FALSE;
 	nmc->nmc_config_mutable.use_colors = NMC_USE_COLOR_AUTO;
 	nmc->nmc_config_mutable.in_editor = FALSE;
 	nmc->editor_status_line = FALSE;
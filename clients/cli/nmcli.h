@@ -117,10 +117,12 @@ typedef struct _NmcConfig {
 	bool escape_values;                               /* Whether to escape ':' and '\' in terse tabular mode */
 	bool in_editor;                                   /* Whether running the editor - nmcli con edit' */
 	bool show_secrets;                                /* Whether to display secrets (both input and output): option '--show-secrets' */
+	bool json_output;                                 /* Print JSON objects, one per line: option '--json' */
 } NmcConfig;
 
 typedef struct _NmcOutputData {
 	GPtrArray *output_data;                           /* GPtrArray of arrays of NmcOutputField structs - accumulates data for output */
+	GArray *widths;                                   /* Column widths fixed by print_data_stream() */
 } NmcOutputData;
 
 /* NmCli - main structure */
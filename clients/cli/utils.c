@@ -975,8 +975,8 @@ nmc_dup_fields_array (const NMMetaAbstractInfo *const*fields, NmcOfFlags flags)
 	return row;
 }
 
-void
-nmc_empty_output_fields (NmcOutputData *output_data)
+static void
+_output_data_clear_rows (NmcOutputData *output_data)
 {
 	guint i;
 
@@ -991,6 +991,13 @@ nmc_empty_output_fields (NmcOutputData *output_data)
 		g_ptr_array_remove_range (output_data->output_data, 0, output_data->output_data->len);
 }
 
+void
+nmc_empty_output_fields (NmcOutputData *output_data)
+{
+	_output_data_clear_rows (output_data);
+	g_clear_pointer (&output_data->widths, g_array_unref);
+}
+
 /*****************************************************************************/
 
 typedef struct {
@@ -1222,16 +1229,16 @@ _print_fill (const NmcConfig *nmc_config,
 }
 
 static gboolean
-_print_skip_column (const NmcConfig *nmc_config,
-                    const PrintDataHeaderCell *header_cell)
+_print_skip_column (gboolean multiline,
+                    const PrintDataCol *col)
 {
 	const NMMetaSelectionItem *selection_item;
 	const NMMetaAbstractInfo *info;
 
-	selection_item = header_cell->col->selection_item;
+	selection_item = col->selection_item;
 	info = selection_item->info;
 
-	if (nmc_config->multiline_output) {
+	if (multiline) {
 		if (info->meta_type == &nm_meta_type_setting_info_editor) {
 			/* we skip the "name" entry for the setting in multiline output. */
 			return TRUE;
@@ -1305,7 +1312,7 @@ _print_do (const NmcConfig *nmc_config,
 			const PrintDataHeaderCell *header_cell = &header_row[i_col];
 			const char *title;
 
-			if (_print_skip_column (nmc_config, header_cell))
+			if (_print_skip_column (multiline, header_cell->col))
 				continue;
 
 			title = header_cell->title;
@@ -1338,7 +1345,7 @@ _print_do (const NmcConfig *nmc_config,
 			const char *const*lines = NULL;
 			guint i_lines, lines_len;
 
-			if (_print_skip_column (nmc_config, cell->header_cell))
+			if (_print_skip_column (multiline, cell->header_cell->col))
 				continue;
 
 			lines_len = 0;
@@ -1417,6 +1424,85 @@ _print_do (const NmcConfig *nmc_config,
 	}
 }
 
+static void
+_json_append_key (GString *str, const char *prefix, const char *name)
+{
+	if (str->len > 1)
+		g_string_append_c (str, ',');
+	if (prefix) {
+		gs_free char *key = g_strdup_printf ("%s.%s", prefix, name);
+
+		nmc_json_append_string (str, key);
+	} else
+		nmc_json_append_string (str, name);
+	g_string_append_c (str, ':');
+}
+
+/* Print one JSON object per target, containing only the selected fields.
+ * Unlike _print_fill(), the values are not kept around but written out as
+ * soon as they are fetched. */
+static void
+_print_json (const NmcConfig *nmc_config,
+             gpointer const *targets,
+             const PrintDataCol *cols,
+             guint cols_len)
+{
+	nm_auto_free_gstring GString *str = NULL;
+	NMMetaAccessorGetFlags text_get_flags;
+	guint i_row, i_col;
+
+	text_get_flags = NM_META_ACCESSOR_GET_FLAGS_ACCEPT_STRV;
+	if (nmc_config->show_secrets)
+		text_get_flags |= NM_META_ACCESSOR_GET_FLAGS_SHOW_SECRETS;
+
+	str = g_string_sized_new (200);
+
+	for (i_row = 0; targets && targets[i_row]; i_row++) {
+		gpointer target = targets[i_row];
+
+		g_string_append_c (str, '{');
+
+		for (i_col = 0; i_col < cols_len; i_col++) {
+			const PrintDataCol *col = &cols[i_col];
+			const NMMetaAbstractInfo *info;
+			NMMetaAccessorGetOutFlags text_out_flags;
+			gs_free gpointer to_free = NULL;
+			gconstpointer value;
+
+			if (   !col->is_leaf
+			    || _print_skip_column (FALSE, col))
+				continue;
+
+			info = col->selection_item->info;
+
+			_json_append_key (str,
+			                  col->parent_idx != PRINT_DATA_COL_PARENT_NIL
+			                  ? nm_meta_abstract_info_get_name (cols[col->parent_idx].selection_item->info, FALSE)
+			                  : NULL,
+			                  nm_meta_abstract_info_get_name (info, FALSE));
+
+			value = nm_meta_abstract_info_get (info,
+			                                   nmc_meta_environment,
+			                                   nmc_meta_environment_arg,
+			                                   target,
+			                                   NM_META_ACCESSOR_GET_TYPE_PARSABLE,
+			                                   text_get_flags,
+			                                   &text_out_flags,
+			                                   &to_free);
+			if (NM_FLAGS_HAS (text_out_flags, NM_META_ACCESSOR_GET_OUT_FLAGS_STRV)) {
+				nmc_json_append_strv (str, value);
+				if (to_free)
+					g_strfreev ((char **) g_steal_pointer (&to_free));
+			} else
+				nmc_json_append_string (str, value);
+		}
+
+		g_string_append (str, "}\n");
+		fputs (str->str, stdout);
+		g_string_truncate (str, 0);
+	}
+}
+
 gboolean
 nmc_print (const NmcConfig *nmc_config,
            gpointer const *targets,
@@ -1435,6 +1521,14 @@ nmc_print (const NmcConfig *nmc_config,
 	                              error))
 		return FALSE;
 
+	if (nmc_config->json_output) {
+		_print_json (nmc_config,
+		             targets,
+		             &g_array_index (cols, PrintDataCol, 0),
+		             cols->len);
+		return TRUE;
+	}
+
 	_print_fill (nmc_config,
 	             targets,
 	             &g_array_index (cols, PrintDataCol, 0),
@@ -1596,6 +1690,34 @@ get_value_to_print (NmcColorOption color_option,
 	return out;
 }
 
+static void
+print_required_fields_json (const GArray *indices,
+                            gboolean section_prefix,
+                            const NmcOutputField *field_values)
+{
+	nm_auto_free_gstring GString *str = NULL;
+	const char *prefix;
+	guint i;
+
+	prefix = section_prefix ? (const char *) field_values[0].value : NULL;
+
+	str = g_string_new ("{");
+	for (i = 0; i < indices->len; i++) {
+		int idx = g_array_index (indices, int, i);
+
+		if (section_prefix && idx == 0)
+			continue;
+
+		_json_append_key (str, prefix, nm_meta_abstract_info_get_name (field_values[idx].info, FALSE));
+		if (field_values[idx].value_is_array)
+			nmc_json_append_strv (str, field_values[idx].value);
+		else
+			nmc_json_append_string (str, field_values[idx].value);
+	}
+	g_string_append (str, "}\n");
+	fputs (str->str, stdout);
+}
+
 /*
  * Print both headers or values of 'field_values' array.
  * Entries to print and their order are specified via indices in
@@ -1623,6 +1745,12 @@ print_required_fields (const NmcConfig *nmc_config,
 	gboolean field_names = of_flags & NMC_OF_FLAG_FIELD_NAMES;
 	gboolean section_prefix = of_flags & NMC_OF_FLAG_SECTION_PREFIX;
 
+	if (nmc_config->json_output) {
+		if (!main_header_only && !field_names)
+			print_required_fields_json (indices, section_prefix, field_values);
+		return;
+	}
+
 	/* Optionally start paging the output. */
 	nmc_terminal_spawn_pager (nmc_config);
 
@@ -1834,3 +1962,59 @@ print_data (const NmcConfig *nmc_config,
 	}
 }
 
+/* Number of rows buffered by print_data_stream() to determine the column
+ * widths for tabular output. */
+#define PRINT_DATA_STREAM_WIDTH_ROWS 50
+
+/*
+ * Print the rows accumulated in @out and free them, so that the caller can
+ * print rows while producing them and memory use does not grow with the number
+ * of rows.
+ * Terse and multiline output don't align columns, so the rows are printed right
+ * away. For tabular output, the rows are buffered until PRINT_DATA_STREAM_WIDTH_ROWS
+ * rows are there (or @flush is set) and the column widths computed from them
+ * are used for all the following rows. Longer values in later rows are printed
+ * in full and only shift the rest of their line.
+ * Call with @flush set after the last row.
+ */
+void
+print_data_stream (const NmcConfig *nmc_config,
+                   const GArray *indices,
+                   const char *header_name,
+                   int indent,
+                   NmcOutputData *out,
+                   gboolean flush)
+{
+	GPtrArray *output_data = out->output_data;
+	NmcOutputField *row;
+	guint i, j;
+
+	if (output_data->len == 0)
+		return;
+
+	if (   nmc_config->print_output != NMC_PRINT_TERSE
+	    && !nmc_config->multiline_output) {
+		if (!out->widths) {
+			if (   !flush
+			    && output_data->len < PRINT_DATA_STREAM_WIDTH_ROWS)
+				return;
+
+			print_data_prepare_width (output_data);
+
+			row = g_ptr_array_index (output_data, 0);
+			out->widths = g_array_new (FALSE, FALSE, sizeof (int));
+			for (j = 0; row[j].info; j++)
+				g_array_append_val (out->widths, row[j].width);
+		} else {
+			for (i = 0; i < output_data->len; i++) {
+				row = g_ptr_array_index (output_data, i);
+				for (j = 0; row[j].info && j < out->widths->len; j++)
+					row[j].width = g_array_index (out->widths, int, j);
+			}
+		}
+	}
+
+	print_data (nmc_config, indices, header_name, indent, out);
+	_output_data_clear_rows (out);
+}
+
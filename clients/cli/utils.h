@@ -82,6 +82,12 @@ void print_data (const NmcConfig *nmc_config,
                  const char *header_name,
                  int indent,
                  const NmcOutputData *out);
+void print_data_stream (const NmcConfig *nmc_config,
+                        const GArray *indices,
+                        const char *header_name,
+                        int indent,
+                        NmcOutputData *out,
+                        gboolean flush);
 
 /*****************************************************************************/
 
@@ -194,6 +194,85 @@ matches (const char *cmd, const char *pattern)
 	return memcmp (pattern, cmd, len) == 0;
 }
 
+/*
+ * Append @value as JSON string, or "null" for %NULL. Control characters
+ * are escaped, other characters are appended as UTF-8. Bytes that are
+ * not part of a valid UTF-8 sequence are replaced by U+FFFD, so that the
+ * output is always valid JSON.
+ */
+void
+nmc_json_append_string (GString *str, const char *value)
+{
+	const char *p;
+
+	if (!value) {
+		g_string_append (str, "null");
+		return;
+	}
+
+	g_string_append_c (str, '"');
+	for (p = value; *p; ) {
+		gunichar c;
+		const char *next;
+
+		if ((guchar) *p >= 0x80) {
+			c = g_utf8_get_char_validated (p, -1);
+			if (c == (gunichar) -1 || c == (gunichar) -2) {
+				g_string_append (str, "\\ufffd");
+				p++;
+				continue;
+			}
+			next = g_utf8_next_char (p);
+			g_string_append_len (str, p, next - p);
+			p = next;
+			continue;
+		}
+
+		switch (*p) {
+		case '"':
+			g_string_append (str, "\\\"");
+			break;
+		case '\\':
+			g_string_append (str, "\\\\");
+			break;
+		case '\n':
+			g_string_append (str, "\\n");
+			break;
+		case '\r':
+			g_string_append (str, "\\r");
+			break;
+		case '\t':
+			g_string_append (str, "\\t");
+			break;
+		default:
+			if ((guchar) *p < 0x20)
+				g_string_append_printf (str, "\\u%04x", (guint) *p);
+			else
+				g_string_append_c (str, *p);
+			break;
+		}
+		p++;
+	}
+	g_string_append_c (str, '"');
+}
+
+/*
+ * Append @strv as JSON array of strings.
+ */
+void
+nmc_json_append_strv (GString *str, const char *const*strv)
+{
+	gsize i;
+
+	g_string_append_c (str, '[');
+	for (i = 0; strv && strv[i]; i++) {
+		if (i > 0)
+			g_string_append_c (str, ',');
+		nmc_json_append_string (str, strv[i]);
+	}
+	g_string_append_c (str, ']');
+}
+
 const char *
 nmc_bond_validate_mode (const char *mode, GError **error)
 {
@@ -44,6 +44,9 @@ gboolean nmc_string_to_tristate (const char *str, NMCTriStateValue *val, GError
 
 gboolean matches (const char *cmd, const char *pattern);
 
+void nmc_json_append_string (GString *str, const char *value);
+void nmc_json_append_strv (GString *str, const char *const*strv);
+
 /* FIXME: don't expose this function on it's own, at least not from this file. */
 const char *nmc_bond_validate_mode (const char *mode, GError **error);
 
@@ -24,6 +24,7 @@
 #include "nm-utils/nm-hash-utils.h"
 
 #include "nm-meta-setting-access.h"
+#include "nm-client-utils.h"
 
 #include "nm-utils/nm-test-utils.h"
 
@@ -149,6 +150,56 @@ test_client_meta_check (void)
 
 /*****************************************************************************/
 
+static void
+_assert_json_string (const char *value, const char *expected)
+{
+	nm_auto_free_gstring GString *str = g_string_new (NULL);
+
+	nmc_json_append_string (str, value);
+	g_assert_cmpstr (str->str, ==, expected);
+}
+
+static void
+test_client_json_string (void)
+{
+	_assert_json_string (NULL, "null");
+	_assert_json_string ("", "\"\"");
+	_assert_json_string ("eth0", "\"eth0\"");
+	_assert_json_string ("a \"b\" \\c/", "\"a \\\"b\\\" \\\\c/\"");
+	_assert_json_string ("a\nb\rc\td", "\"a\\nb\\rc\\td\"");
+	_assert_json_string ("\001\010\014\037 \177", "\"\\u0001\\u0008\\u000c\\u001f \177\"");
+
+	/* valid UTF-8 is kept as is. */
+	_assert_json_string ("caf\303\251 \342\202\254 \360\237\230\200", "\"caf\303\251 \342\202\254 \360\237\230\200\"");
+
+	/* invalid UTF-8 is replaced. */
+	_assert_json_string ("a\377b", "\"a\\ufffdb\"");
+	_assert_json_string ("a\303", "\"a\\ufffd\"");
+	_assert_json_string ("\303(", "\"\\ufffd(\"");
+	_assert_json_string ("\300\200", "\"\\ufffd\\ufffd\"");
+}
+
+static void
+test_client_json_strv (void)
+{
+	nm_auto_free_gstring GString *str = g_string_new (NULL);
+	const char *const strv[] = { "a", "b\"", "\n", NULL };
+	const char *const empty[] = { NULL };
+
+	nmc_json_append_strv (str, strv);
+	g_assert_cmpstr (str->str, ==, "[\"a\",\"b\\\"\",\"\\n\"]");
+
+	g_string_truncate (str, 0);
+	nmc_json_append_strv (str, empty);
+	g_assert_cmpstr (str->str, ==, "[]");
+
+	g_string_truncate (str, 0);
+	nmc_json_append_strv (str, NULL);
+	g_assert_cmpstr (str->str, ==, "[]");
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE ();
 
 int
@@ -157,6 +208,8 @@ main (int argc, char **argv)
 	nmtst_init (&argc, &argv, TRUE);
 
 	g_test_add_func ("/client/meta/check", test_client_meta_check);
+	g_test_add_func ("/client/json/string", test_client_json_string);
+	g_test_add_func ("/client/json/strv", test_client_json_strv);
 
 	return g_test_run ();
 }
@@ -282,9 +282,13 @@ nm_active_connection_get_default (NMActiveConnection *connection)
 NMIPConfig *
 nm_active_connection_get_ip4_config (NMActiveConnection *connection)
 {
+	NMActiveConnectionPrivate *priv;
+
 	g_return_val_if_fail (NM_IS_ACTIVE_CONNECTION (connection), NULL);
 
-	return NM_ACTIVE_CONNECTION_GET_PRIVATE (connection)->ip4_config;
+	priv = NM_ACTIVE_CONNECTION_GET_PRIVATE (connection);
+	_nm_object_ensure_lazy_property (NM_OBJECT (connection), &priv->ip4_config);
+	return priv->ip4_config;
 }
 
 /**
@@ -301,9 +305,13 @@ nm_active_connection_get_ip4_config (NMActiveConnection *connection)
 NMDhcpConfig *
 nm_active_connection_get_dhcp4_config (NMActiveConnection *connection)
 {
+	NMActiveConnectionPrivate *priv;
+
 	g_return_val_if_fail (NM_IS_ACTIVE_CONNECTION (connection), NULL);
 
-	return NM_ACTIVE_CONNECTION_GET_PRIVATE (connection)->dhcp4_config;
+	priv = NM_ACTIVE_CONNECTION_GET_PRIVATE (connection);
+	_nm_object_ensure_lazy_property (NM_OBJECT (connection), &priv->dhcp4_config);
+	return priv->dhcp4_config;
 }
 
 /**
@@ -335,9 +343,13 @@ nm_active_connection_get_default6 (NMActiveConnection *connection)
 NMIPConfig *
 nm_active_connection_get_ip6_config (NMActiveConnection *connection)
 {
+	NMActiveConnectionPrivate *priv;
+
 	g_return_val_if_fail (NM_IS_ACTIVE_CONNECTION (connection), NULL);
 
-	return NM_ACTIVE_CONNECTION_GET_PRIVATE (connection)->ip6_config;
+	priv = NM_ACTIVE_CONNECTION_GET_PRIVATE (connection);
+	_nm_object_ensure_lazy_property (NM_OBJECT (connection), &priv->ip6_config);
+	return priv->ip6_config;
 }
 
 /**
@@ -354,9 +366,13 @@ nm_active_connection_get_ip6_config (NMActiveConnection *connection)
 NMDhcpConfig *
 nm_active_connection_get_dhcp6_config (NMActiveConnection *connection)
 {
+	NMActiveConnectionPrivate *priv;
+
 	g_return_val_if_fail (NM_IS_ACTIVE_CONNECTION (connection), NULL);
 
-	return NM_ACTIVE_CONNECTION_GET_PRIVATE (connection)->dhcp6_config;
+	priv = NM_ACTIVE_CONNECTION_GET_PRIVATE (connection);
+	_nm_object_ensure_lazy_property (NM_OBJECT (connection), &priv->dhcp6_config);
+	return priv->dhcp6_config;
 }
 
 /**
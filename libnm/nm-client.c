@@ -110,6 +110,7 @@ typedef struct {
 	GDBusObjectManager *object_manager;
 	GCancellable *new_object_manager_cancellable;
 	struct udev *udev;
+	bool lazy_objects:1;
 } NMClientPrivate;
 
 enum {
@@ -141,6 +142,7 @@ enum {
 	PROP_DNS_RC_MANAGER,
 	PROP_DNS_CONFIGURATION,
 	PROP_CHECKPOINTS,
+	PROP_LAZY_OBJECTS,
 
 	LAST_PROP
 };
@@ -2389,7 +2391,8 @@ proxy_type (GDBusObjectManagerClient *manager,
 }
 
 static NMObject *
-obj_nm_for_gdbus_object (NMClient *self, GDBusObject *object, GDBusObjectManager *object_manager)
+obj_nm_for_gdbus_object (NMClient *self, GDBusObject *object, GDBusObjectManager *object_manager,
+                         gboolean create_lazy)
 {
 	NMClientPrivate *priv;
 	GList *interfaces;
@@ -2489,6 +2492,12 @@ obj_nm_for_gdbus_object (NMClient *self, GDBusObject *object, GDBusObjectManager
 	if (type == G_TYPE_INVALID)
 		return NULL;
 
+	/* In lazy mode, such objects are only created when they are accessed. */
+	if (   !create_lazy
+	    && NM_CLIENT_GET_PRIVATE (self)->lazy_objects
+	    && _nm_object_type_is_lazy (type))
+		return NULL;
+
 	obj_nm = g_object_new (type,
 	                       NM_OBJECT_DBUS_OBJECT, object,
 	                       NM_OBJECT_DBUS_OBJECT_MANAGER, object_manager,
@@ -2515,13 +2524,35 @@ obj_nm_inited (GObject *object, GAsyncResult *result, gpointer user_data)
 }
 
 
+static NMObject *
+obj_nm_create_lazy (GDBusObject *object, gpointer user_data)
+{
+	NMClient *client = user_data;
+	NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE (client);
+	NMObject *obj_nm;
+
+	nm_assert (priv->lazy_objects);
+
+	obj_nm = obj_nm_for_gdbus_object (client, object, priv->object_manager, TRUE);
+	if (!obj_nm)
+		return NULL;
+
+	/* Only loads the properties from the object manager. */
+	if (!g_initable_init (G_INITABLE (obj_nm), NULL, NULL)) {
+		/* This is a can-not-happen situation, the NMObject subclasses are not
+		 * supposed to fail initialization. */
+		g_warn_if_reached ();
+	}
+	return obj_nm;
+}
+
 static void
 object_added (GDBusObjectManager *object_manager, GDBusObject *object, gpointer user_data)
 {
 	NMClient *client = user_data;
 	NMObject *obj_nm;
 
-	obj_nm = obj_nm_for_gdbus_object (client, object, object_manager);
+	obj_nm = obj_nm_for_gdbus_object (client, object, object_manager, FALSE);
 	if (obj_nm) {
 		g_async_initable_init_async (G_ASYNC_INITABLE (obj_nm),
 		                             G_PRIORITY_DEFAULT, NULL,
@@ -2542,15 +2573,23 @@ objects_created (NMClient *client, GDBusObjectManager *object_manager, GError **
 	gs_unref_object GDBusObject *manager = NULL;
 	gs_unref_object GDBusObject *settings = NULL;
 	gs_unref_object GDBusObject *dns_manager = NULL;
+	gs_unref_ptrarray GPtrArray *objs_nm = NULL;
 	NMObject *obj_nm;
 	GList *objects, *iter;
 
 	/* First just ensure all the NMObjects for known GDBusObjects exist. */
 	objects = g_dbus_object_manager_get_objects (object_manager);
-	for (iter = objects; iter; iter = iter->next)
-		obj_nm_for_gdbus_object (client, iter->data, object_manager);
+	objs_nm = g_ptr_array_sized_new (g_list_length (objects));
+	for (iter = objects; iter; iter = iter->next) {
+		obj_nm = obj_nm_for_gdbus_object (client, iter->data, object_manager, FALSE);
+		if (obj_nm)
+			g_ptr_array_add (objs_nm, obj_nm);
+	}
 	g_list_free_full (objects, g_object_unref);
 
+	if (priv->lazy_objects)
+		_nm_object_manager_set_lazy (object_manager, obj_nm_create_lazy, client);
+
 	manager = g_dbus_object_manager_get_object (object_manager, NM_DBUS_PATH);
 	if (!manager) {
 		g_set_error_literal (error,
@@ -2631,6 +2670,10 @@ objects_created (NMClient *client, GDBusObjectManager *object_manager, GError **
 		                  G_CALLBACK (dns_notify), client);
 	}
 
+	/* The object manager already fetched the properties of all objects.
+	 * Initialize the objects from there at once, only the ones that need
+	 * more then their properties are initialized individually afterwards. */
+	_nm_object_init_bulk ((NMObject *const*) objs_nm->pdata, objs_nm->len);
 
 	/* The handlers don't really use the client instance. However
 	 * it makes it convenient to unhook them by data. */
@@ -2683,7 +2726,7 @@ init_sync (GInitable *initable, GCancellable *cancellable, GError **error)
 			NMObject *obj_nm;
 
 			obj_nm = g_object_get_qdata (iter->data, _nm_object_obj_nm_quark ());
-			if (!obj_nm)
+			if (!obj_nm || _nm_object_get_inited (obj_nm))
 				continue;
 
 			if (!g_initable_init (G_INITABLE (obj_nm), cancellable, NULL)) {
@@ -2777,6 +2820,8 @@ unhook_om (NMClient *self)
 		g_clear_object (&priv->dns_manager);
 	}
 
+	_nm_object_manager_set_lazy (priv->object_manager, NULL, NULL);
+
 	objects = g_dbus_object_manager_get_objects (priv->object_manager);
 	for (iter = objects; iter; iter = iter->next)
 		g_object_set_qdata (iter->data, _nm_object_obj_nm_quark (), NULL);
@@ -2826,7 +2871,7 @@ got_object_manager (GObject *object, GAsyncResult *result, gpointer user_data)
 			NMObject *obj_nm;
 
 			obj_nm = g_object_get_qdata (iter->data, _nm_object_obj_nm_quark ());
-			if (!obj_nm)
+			if (!obj_nm || _nm_object_get_inited (obj_nm))
 				continue;
 
 			init_data->pending_init++;
@@ -2935,6 +2980,7 @@ dispose (GObject *object)
 		GList *objects, *iter;
 
 		/* Unhook the NM objects. */
+		_nm_object_manager_set_lazy (priv->object_manager, NULL, NULL);
 		objects = g_dbus_object_manager_get_objects (priv->object_manager);
 		for (iter = objects; iter; iter = iter->next)
 			g_object_set_qdata (G_OBJECT (iter->data), _nm_object_obj_nm_quark (), NULL);
@@ -2967,6 +3013,10 @@ set_property (GObject *object, guint prop_id,
 		if (priv->manager)
 			g_object_set_property (G_OBJECT (priv->manager), pspec->name, value);
 		break;
+	case PROP_LAZY_OBJECTS:
+		/* construct-only */
+		priv->lazy_objects = g_value_get_boolean (value);
+		break;
 	default:
 		G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
 		break;
@@ -2984,6 +3034,9 @@ get_property (GObject *object, guint prop_id,
 	case PROP_NM_RUNNING:
 		g_value_set_boolean (value, nm_client_get_nm_running (self));
 		break;
+	case PROP_LAZY_OBJECTS:
+		g_value_set_boolean (value, priv->lazy_objects);
+		break;
 
 	/* Manager properties. */
 	case PROP_VERSION:
@@ -3481,6 +3534,30 @@ nm_client_class_init (NMClientClass *client_class)
 		                     G_PARAM_READABLE |
 		                     G_PARAM_STATIC_STRINGS));
 
+	/**
+	 * NMClient:lazy-objects:
+	 *
+	 * If %TRUE, the #NMAccessPoint, #NMIPConfig and #NMDhcpConfig objects
+	 * are only created when they are accessed for the first time, for
+	 * example via nm_device_wifi_get_access_points() or
+	 * nm_device_get_ip4_config(). Until then, changes to them are not
+	 * tracked and no signals are emitted for them; in particular,
+	 * #NMDeviceWifi::access-point-added is only emitted after the access
+	 * points of the device were fetched once.
+	 *
+	 * This saves memory and CPU time for clients that need only a part
+	 * of the information, like short lived command line tools.
+	 *
+	 * Since: 1.12
+	 */
+	g_object_class_install_property
+		(object_class, PROP_LAZY_OBJECTS,
+		 g_param_spec_boolean (NM_CLIENT_LAZY_OBJECTS, "", "",
+		                       FALSE,
+		                       G_PARAM_READWRITE |
+		                       G_PARAM_CONSTRUCT_ONLY |
+		                       G_PARAM_STATIC_STRINGS));
+
 	/* signals */
 
 	/**
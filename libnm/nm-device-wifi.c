@@ -191,6 +191,7 @@ nm_device_wifi_get_capabilities (NMDeviceWifi *device)
 NMAccessPoint *
 nm_device_wifi_get_active_access_point (NMDeviceWifi *device)
 {
+	NMDeviceWifiPrivate *priv;
 	NMDeviceState state;
 
 	g_return_val_if_fail (NM_IS_DEVICE_WIFI (device), NULL);
@@ -211,7 +212,9 @@ nm_device_wifi_get_active_access_point (NMDeviceWifi *device)
 		break;
 	}
 
-	return NM_DEVICE_WIFI_GET_PRIVATE (device)->active_ap;
+	priv = NM_DEVICE_WIFI_GET_PRIVATE (device);
+	_nm_object_ensure_lazy_property (NM_OBJECT (device), &priv->active_ap);
+	return priv->active_ap;
 }
 
 /**
@@ -227,9 +230,13 @@ nm_device_wifi_get_active_access_point (NMDeviceWifi *device)
 const GPtrArray *
 nm_device_wifi_get_access_points (NMDeviceWifi *device)
 {
+	NMDeviceWifiPrivate *priv;
+
 	g_return_val_if_fail (NM_IS_DEVICE_WIFI (device), NULL);
 
-	return NM_DEVICE_WIFI_GET_PRIVATE (device)->aps;
+	priv = NM_DEVICE_WIFI_GET_PRIVATE (device);
+	_nm_object_ensure_lazy_property (NM_OBJECT (device), &priv->aps);
+	return priv->aps;
 }
 
 /**
@@ -1165,9 +1165,13 @@ nm_device_get_nm_plugin_missing (NMDevice *device)
 NMIPConfig *
 nm_device_get_ip4_config (NMDevice *device)
 {
+	NMDevicePrivate *priv;
+
 	g_return_val_if_fail (NM_IS_DEVICE (device), NULL);
 
-	return NM_DEVICE_GET_PRIVATE (device)->ip4_config;
+	priv = NM_DEVICE_GET_PRIVATE (device);
+	_nm_object_ensure_lazy_property (NM_OBJECT (device), &priv->ip4_config);
+	return priv->ip4_config;
 }
 
 /**
@@ -1185,9 +1189,13 @@ nm_device_get_ip4_config (NMDevice *device)
 NMDhcpConfig *
 nm_device_get_dhcp4_config (NMDevice *device)
 {
+	NMDevicePrivate *priv;
+
 	g_return_val_if_fail (NM_IS_DEVICE (device), NULL);
 
-	return NM_DEVICE_GET_PRIVATE (device)->dhcp4_config;
+	priv = NM_DEVICE_GET_PRIVATE (device);
+	_nm_object_ensure_lazy_property (NM_OBJECT (device), &priv->dhcp4_config);
+	return priv->dhcp4_config;
 }
 
 /**
@@ -1204,9 +1212,13 @@ nm_device_get_dhcp4_config (NMDevice *device)
 NMIPConfig *
 nm_device_get_ip6_config (NMDevice *device)
 {
+	NMDevicePrivate *priv;
+
 	g_return_val_if_fail (NM_IS_DEVICE (device), NULL);
 
-	return NM_DEVICE_GET_PRIVATE (device)->ip6_config;
+	priv = NM_DEVICE_GET_PRIVATE (device);
+	_nm_object_ensure_lazy_property (NM_OBJECT (device), &priv->ip6_config);
+	return priv->ip6_config;
 }
 
 /**
@@ -1224,9 +1236,13 @@ nm_device_get_ip6_config (NMDevice *device)
 NMDhcpConfig *
 nm_device_get_dhcp6_config (NMDevice *device)
 {
+	NMDevicePrivate *priv;
+
 	g_return_val_if_fail (NM_IS_DEVICE (device), NULL);
 
-	return NM_DEVICE_GET_PRIVATE (device)->dhcp6_config;
+	priv = NM_DEVICE_GET_PRIVATE (device);
+	_nm_object_ensure_lazy_property (NM_OBJECT (device), &priv->dhcp6_config);
+	return priv->dhcp6_config;
 }
 
 /**
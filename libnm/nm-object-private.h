@@ -43,6 +43,20 @@ void _nm_object_queue_notify (NMObject *object, const char *property);
 
 GDBusObjectManager *_nm_object_get_dbus_object_manager (NMObject *object);
 
+void _nm_object_init_bulk (NMObject *const*objects, guint n_objects);
+
+gboolean _nm_object_get_inited (NMObject *object);
+
+typedef NMObject *(*NMObjectLazyCreateFunc) (GDBusObject *object, gpointer user_data);
+
+void _nm_object_manager_set_lazy (GDBusObjectManager *object_manager,
+                                  NMObjectLazyCreateFunc create_func,
+                                  gpointer user_data);
+
+gboolean _nm_object_type_is_lazy (GType type);
+
+void _nm_object_ensure_lazy_property (NMObject *object, gpointer field);
+
 GQuark _nm_object_obj_nm_quark (void);
 
 /* DBus property accessors */
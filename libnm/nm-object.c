@@ -32,6 +32,9 @@
 #include "nm-object-private.h"
 #include "nm-dbus-helpers.h"
 #include "nm-client.h"
+#include "nm-access-point.h"
+#include "nm-dhcp-config.h"
+#include "nm-ip-config.h"
 #include "nm-core-internal.h"
 #include "nm-utils/c-list.h"
 
@@ -39,6 +42,7 @@ static gboolean debug = FALSE;
 #define dbgmsg(f,...) if (G_UNLIKELY (debug)) { g_message (f, ## __VA_ARGS__ ); }
 
 NM_CACHED_QUARK_FCN ("nm-obj-nm", _nm_object_obj_nm_quark)
+NM_CACHED_QUARK_FCN ("nm-obj-lazy", _nm_object_lazy_quark)
 
 static void nm_object_initable_iface_init (GInitableIface *iface);
 static void nm_object_async_initable_iface_init (GAsyncInitableIface *iface);
@@ -78,6 +82,12 @@ typedef struct {
 	GSList *waiters;        /* if async init did not finish, users of this object need
 	                         * to defer their notifications by adding themselves here. */
 
+	bool props_loaded:1;    /* the properties were loaded from the object manager. */
+	bool bulk_loading:1;    /* inside _nm_object_init_bulk(), don't resolve references yet. */
+	bool lazy_resolving:1;  /* inside _nm_object_ensure_lazy_property(). */
+
+	GHashTable *lazy_props; /* object properties that are not yet resolved, see LazyProp. */
+
 	CList notify_items;
 	guint notify_id;
 
@@ -337,6 +347,9 @@ typedef struct {
 
 	gboolean array;
 	const char *property_name;
+
+	/* resolved on first access, nobody could have seen the previous value. */
+	bool silent:1;
 } ObjectCreatedData;
 
 static void
@@ -448,11 +461,18 @@ static void
 object_property_maybe_complete (NMObject *self)
 {
 	NMObjectPrivate *priv = NM_OBJECT_GET_PRIVATE (self);
-	/* The odata may hold the last reference. */
-	_nm_unused gs_unref_object NMObject *self_keep_alive = g_object_ref (self);
+	_nm_unused gs_unref_object NMObject *self_keep_alive = NULL;
 	int i;
 	CList *iter, *safe;
 
+	/* During bulk initialization the referenced objects are not yet inited.
+	 * All the pending properties are completed at the end. */
+	if (priv->bulk_loading)
+		return;
+
+	/* The odata may hold the last reference. */
+	self_keep_alive = g_object_ref (self);
+
 	c_list_for_each_safe (iter, safe, &priv->pending) {
 		ObjectCreatedData *odata = c_list_entry (iter, ObjectCreatedData, lst_pending);
 		PropertyInfo *pi = odata->pi;
@@ -494,7 +514,7 @@ object_property_maybe_complete (NMObject *self)
 
 			*((GPtrArray **) pi->field) = new;
 
-			if (pi->signal_prefix) {
+			if (pi->signal_prefix && !odata->silent) {
 				GPtrArray *added = g_ptr_array_sized_new (3);
 				GPtrArray *removed = g_ptr_array_sized_new (3);
 
@@ -548,11 +568,12 @@ object_property_maybe_complete (NMObject *self)
 			*obj_p = odata->objects[0];
 		}
 
-		if (different && odata->property_name)
+		if (different && odata->property_name && !odata->silent)
 			_nm_object_queue_notify (self, odata->property_name);
 
+		/* don't emit pending notifications from within a getter. */
 		if (--priv->reload_remaining == 0)
-			reload_complete (self, TRUE);
+			reload_complete (self, !odata->silent);
 
 		odata_free (odata);
 	}
@@ -576,6 +597,175 @@ object_created (GObject *obj, const char *path, gpointer user_data)
 	object_property_maybe_complete (odata->self);
 }
 
+/*****************************************************************************/
+
+/* In lazy mode, the NMObjects of some types are only created when a property
+ * referring to them is accessed. Until then, the value of the property is
+ * kept as it was received. */
+
+typedef struct {
+	NMObjectLazyCreateFunc create_func;
+	gpointer user_data;
+} LazyInfo;
+
+typedef struct {
+	PropertyInfo *pi;
+	const char *property_name;
+	GVariant *value;
+	bool touched:1;
+} LazyProp;
+
+static void
+lazy_prop_free (gpointer data)
+{
+	LazyProp *lp = data;
+
+	if (lp->value)
+		g_variant_unref (lp->value);
+	g_slice_free (LazyProp, lp);
+}
+
+/**
+ * _nm_object_manager_set_lazy:
+ * @object_manager: the object manager
+ * @create_func: (allow-none): function that creates the #NMObject for
+ *   a #GDBusObject on demand, or %NULL to disable lazy mode.
+ * @user_data: data for @create_func
+ *
+ * Enables lazy mode for the NMObjects of @object_manager. In lazy mode, properties
+ * referring to objects of a type for which _nm_object_type_is_lazy() is
+ * %TRUE are resolved only when they are accessed for the first time, and
+ * the referred objects are created by @create_func.
+ */
+void
+_nm_object_manager_set_lazy (GDBusObjectManager *object_manager,
+                             NMObjectLazyCreateFunc create_func,
+                             gpointer user_data)
+{
+	LazyInfo *info = NULL;
+
+	if (create_func) {
+		info = g_new (LazyInfo, 1);
+		info->create_func = create_func;
+		info->user_data = user_data;
+	}
+	g_object_set_qdata_full (G_OBJECT (object_manager), _nm_object_lazy_quark (),
+	                         info, g_free);
+}
+
+static const LazyInfo *
+lazy_info_get (NMObject *self)
+{
+	NMObjectPrivate *priv = NM_OBJECT_GET_PRIVATE (self);
+
+	if (!priv->object_manager)
+		return NULL;
+	return g_object_get_qdata (G_OBJECT (priv->object_manager), _nm_object_lazy_quark ());
+}
+
+gboolean
+_nm_object_type_is_lazy (GType type)
+{
+	return    g_type_is_a (type, NM_TYPE_ACCESS_POINT)
+	       || g_type_is_a (type, NM_TYPE_IP_CONFIG)
+	       || g_type_is_a (type, NM_TYPE_DHCP_CONFIG);
+}
+
+static GObject *
+object_for_gdbus_object (NMObject *self, GDBusObject *object)
+{
+	GObject *obj;
+	const LazyInfo *info;
+
+	obj = g_object_get_qdata (G_OBJECT (object), _nm_object_obj_nm_quark ());
+	if (!obj) {
+		info = lazy_info_get (self);
+		if (info)
+			obj = (GObject *) info->create_func (object, info->user_data);
+	}
+	return obj;
+}
+
+/* Returns %TRUE if the property is not resolved now but kept for later. */
+static gboolean
+lazy_property_defer (NMObject *self, const char *property_name, GVariant *value,
+                     PropertyInfo *pi)
+{
+	NMObjectPrivate *priv = NM_OBJECT_GET_PRIVATE (self);
+	LazyProp *lp = NULL;
+
+	if (priv->lazy_props)
+		lp = g_hash_table_lookup (priv->lazy_props, pi->field);
+	else {
+		if (   !_nm_object_type_is_lazy (pi->object_type)
+		    || !lazy_info_get (self))
+			return FALSE;
+		priv->lazy_props = g_hash_table_new_full (NULL, NULL, NULL, lazy_prop_free);
+	}
+
+	if (!lp) {
+		if (!_nm_object_type_is_lazy (pi->object_type))
+			return FALSE;
+		lp = g_slice_new0 (LazyProp);
+		lp->pi = pi;
+		lp->property_name = property_name;
+		g_hash_table_insert (priv->lazy_props, pi->field, lp);
+	}
+
+	/* once the property was accessed, it is kept up to date. */
+	if (lp->touched)
+		return FALSE;
+
+	if (lp->value)
+		g_variant_unref (lp->value);
+	lp->value = g_variant_ref (value);
+	return TRUE;
+}
+
+static gboolean handle_object_property (NMObject *self, const char *property_name, GVariant *value,
+                                        PropertyInfo *pi);
+static gboolean handle_object_array_property (NMObject *self, const char *property_name, GVariant *value,
+                                              PropertyInfo *pi);
+
+/**
+ * _nm_object_ensure_lazy_property:
+ * @self: the #NMObject
+ * @field: the field of the property, as registered with
+ *   _nm_object_register_properties().
+ *
+ * In lazy mode, resolves the property backed by @field, creating the objects
+ * it refers to. To be called by the getters of lazy properties before
+ * reading the field.
+ */
+void
+_nm_object_ensure_lazy_property (NMObject *self, gpointer field)
+{
+	NMObjectPrivate *priv = NM_OBJECT_GET_PRIVATE (self);
+	gs_unref_variant GVariant *value = NULL;
+	LazyProp *lp;
+
+	if (G_LIKELY (!priv->lazy_props))
+		return;
+
+	lp = g_hash_table_lookup (priv->lazy_props, field);
+	if (!lp || lp->touched)
+		return;
+
+	lp->touched = TRUE;
+	value = g_steal_pointer (&lp->value);
+	if (!value)
+		return;
+
+	priv->lazy_resolving = TRUE;
+	if (g_variant_is_of_type (value, G_VARIANT_TYPE_OBJECT_PATH))
+		handle_object_property (self, lp->property_name, value, lp->pi);
+	else
+		handle_object_array_property (self, lp->property_name, value, lp->pi);
+	priv->lazy_resolving = FALSE;
+}
+
+/*****************************************************************************/
+
 static gboolean
 handle_object_property (NMObject *self, const char *property_name, GVariant *value,
                         PropertyInfo *pi)
@@ -593,6 +783,7 @@ handle_object_property (NMObject *self, const char *property_name, GVariant *val
 	odata->length = odata->remaining = 1;
 	odata->array = FALSE;
 	odata->property_name = property_name;
+	odata->silent = priv->lazy_resolving;
 
 	c_list_link_tail (&priv->pending, &odata->lst_pending);
 
@@ -624,7 +815,7 @@ handle_object_property (NMObject *self, const char *property_name, GVariant *val
 		return FALSE;
 	}
 
-	obj = g_object_get_qdata (G_OBJECT (object), _nm_object_obj_nm_quark ());
+	obj = object_for_gdbus_object (self, object);
 	object_created (obj, path, odata);
 
 	return TRUE;
@@ -650,6 +841,7 @@ handle_object_array_property (NMObject *self, const char *property_name, GVarian
 	odata->length = odata->remaining = npaths;
 	odata->array = TRUE;
 	odata->property_name = property_name;
+	odata->silent = priv->lazy_resolving;
 
 	c_list_link_tail (&priv->pending, &odata->lst_pending);
 
@@ -666,7 +858,7 @@ handle_object_array_property (NMObject *self, const char *property_name, GVarian
 
 		object = g_dbus_object_manager_get_object (priv->object_manager, path);
 		if (object) {
-			obj = g_object_get_qdata (G_OBJECT (object), _nm_object_obj_nm_quark ());
+			obj = object_for_gdbus_object (self, object);
 			object_created (obj, path, odata);
 		} else {
 			g_warning ("no object known for %s\n", path);
@@ -733,7 +925,9 @@ handle_property_changed (NMObject *self, const char *dbus_name, GVariant *value)
 	}
 
 	if (pspec && pi->object_type) {
-		if (g_variant_is_of_type (value, G_VARIANT_TYPE_OBJECT_PATH))
+		if (lazy_property_defer (self, pspec->name, value, pi))
+			success = TRUE;
+		else if (g_variant_is_of_type (value, G_VARIANT_TYPE_OBJECT_PATH))
 			success = handle_object_property (self, pspec->name, value, pi);
 		else if (g_variant_is_of_type (value, G_VARIANT_TYPE ("ao")))
 			success = handle_object_array_property (self, pspec->name, value, pi);
@@ -1057,27 +1251,30 @@ init_if (GDBusProxy *proxy, NMObject *self)
 	g_strfreev (props);
 }
 
-static gboolean
-init_sync (GInitable *initable, GCancellable *cancellable, GError **error)
+static void
+load_properties (NMObject *self)
 {
-	NMObject *self = NM_OBJECT (initable);
 	NMObjectPrivate *priv = NM_OBJECT_GET_PRIVATE (self);
-        GList *interfaces;
+	GList *interfaces;
 
 	g_assert (priv->object && priv->object_manager);
+	nm_assert (!priv->props_loaded);
 
-	NM_OBJECT_GET_CLASS (self)->init_dbus (self);
+	priv->props_loaded = TRUE;
 
-	priv->reload_remaining++;
+	NM_OBJECT_GET_CLASS (self)->init_dbus (self);
 
 	interfaces = g_dbus_object_get_interfaces (priv->object);
 	g_list_foreach (interfaces, (GFunc) init_if, self);
 	g_list_free_full (interfaces, g_object_unref);
+}
 
-	priv->inited = TRUE;
+static void
+set_inited (NMObject *self)
+{
+	NMObjectPrivate *priv = NM_OBJECT_GET_PRIVATE (self);
 
-	if (--priv->reload_remaining == 0)
-		reload_complete (self, TRUE);
+	priv->inited = TRUE;
 
 	/* There are some object properties whose creation couldn't proceed
 	 * because it depended on this object. */
@@ -1087,7 +1284,106 @@ init_sync (GInitable *initable, GCancellable *cancellable, GError **error)
 		priv->waiters = g_slist_remove (priv->waiters, odata);
 		object_property_maybe_complete (odata->self);
 	}
+}
+
+static gboolean init_sync (GInitable *initable, GCancellable *cancellable, GError **error);
+
+/* Whether the subclass overrides the initialization, because it needs to do
+ * more then loading the properties (e.g. fetching the settings of a
+ * connection). */
+static gboolean
+has_own_init (NMObject *self)
+{
+	GInitableIface *iface;
+
+	iface = g_type_interface_peek (G_OBJECT_GET_CLASS (self), G_TYPE_INITABLE);
+	return iface->init != init_sync;
+}
+
+/**
+ * _nm_object_init_bulk:
+ * @objects: the objects to initialize
+ * @n_objects: the number of objects
+ *
+ * Loads the properties of all @objects from the object manager that
+ * created them and resolves the references between them at once. This
+ * avoids that each object waits for the initialization of the objects it
+ * refers to.
+ *
+ * Afterwards, objects that don't override the initialization are inited
+ * and need not be initialized via #GInitable or #GAsyncInitable anymore.
+ * Other objects still must be, but won't load their properties again.
+ */
+void
+_nm_object_init_bulk (NMObject *const*objects, guint n_objects)
+{
+	NMObjectPrivate *priv;
+	guint i;
+
+	/* First load the properties of all objects. References to other
+	 * objects are only recorded. */
+	for (i = 0; i < n_objects; i++) {
+		priv = NM_OBJECT_GET_PRIVATE (objects[i]);
+
+		if (priv->props_loaded)
+			continue;
+
+		g_object_ref (objects[i]);
+		priv->bulk_loading = TRUE;
+		priv->reload_remaining++;
+		load_properties (objects[i]);
+	}
+
+	for (i = 0; i < n_objects; i++) {
+		priv = NM_OBJECT_GET_PRIVATE (objects[i]);
+
+		if (   priv->bulk_loading
+		    && !has_own_init (objects[i]))
+			priv->inited = TRUE;
+	}
+
+	/* Now all objects that will not do any further initialization are
+	 * marked as inited. Resolve the references. */
+	for (i = 0; i < n_objects; i++) {
+		NMObject *self = objects[i];
+
+		priv = NM_OBJECT_GET_PRIVATE (self);
+
+		if (!priv->bulk_loading)
+			continue;
+
+		priv->bulk_loading = FALSE;
+		object_property_maybe_complete (self);
+		if (--priv->reload_remaining == 0)
+			reload_complete (self, TRUE);
+		g_object_unref (self);
+	}
+}
+
+gboolean
+_nm_object_get_inited (NMObject *self)
+{
+	return NM_OBJECT_GET_PRIVATE (self)->inited;
+}
+
+static gboolean
+init_sync (GInitable *initable, GCancellable *cancellable, GError **error)
+{
+	NMObject *self = NM_OBJECT (initable);
+	NMObjectPrivate *priv = NM_OBJECT_GET_PRIVATE (self);
+
+	if (!priv->props_loaded) {
+		priv->reload_remaining++;
+
+		load_properties (self);
+
+		priv->inited = TRUE;
+
+		if (--priv->reload_remaining == 0)
+			reload_complete (self, TRUE);
+	}
 
+	set_inited (self);
 	return TRUE;
 }
 
@@ -1122,20 +1418,14 @@ init_async (GAsyncInitable *initable, int io_priority,
 	NMObject *self = NM_OBJECT (initable);
 	NMObjectPrivate *priv = NM_OBJECT_GET_PRIVATE (self);
 	NMObjectInitData *init_data;
-        GList *interfaces;
-
-	g_assert (priv->object && priv->object_manager);
-
-	NM_OBJECT_GET_CLASS (self)->init_dbus (self);
 
 	init_data = g_slice_new0 (NMObjectInitData);
 	init_data->object = self;
 	init_data->simple = g_simple_async_result_new (G_OBJECT (initable), callback, user_data, init_async);
 	init_data->cancellable = cancellable ? g_object_ref (cancellable) : NULL;
 
-	interfaces = g_dbus_object_get_interfaces (priv->object);
-	g_list_foreach (interfaces, (GFunc) init_if, self);
-	g_list_free_full (interfaces, g_object_unref);
+	if (!priv->props_loaded)
+		load_properties (self);
 
 	init_async_complete (init_data);
 }
@@ -1144,18 +1434,8 @@ static gboolean
 init_finish (GAsyncInitable *initable, GAsyncResult *result, GError **error)
 {
 	GSimpleAsyncResult *simple = G_SIMPLE_ASYNC_RESULT (result);
-	NMObjectPrivate *priv = NM_OBJECT_GET_PRIVATE (initable);
-
-	priv->inited = TRUE;
-
-	/* There are some object properties whose creation couldn't proceed
-	 * because it depended on this object. */
-	while (priv->waiters) {
-		ObjectCreatedData *odata = priv->waiters->data;
 
-		priv->waiters = g_slist_remove (priv->waiters, odata);
-		object_property_maybe_complete (odata->self);
-	}
+	set_inited (NM_OBJECT (initable));
 
 	if (g_simple_async_result_propagate_error (simple, error))
 		return FALSE;
@@ -1244,6 +1524,8 @@ dispose (GObject *object)
 
 	g_slist_free_full (priv->waiters, odata_free);
 
+	g_clear_pointer (&priv->lazy_props, g_hash_table_unref);
+
 	g_clear_object (&priv->object);
 	g_clear_object (&priv->object_manager);
 
@@ -1570,6 +1570,193 @@ test_connection_invalid (void)
 
 /*****************************************************************************/
 
+static void
+lazy_ap_added_cb (NMDeviceWifi *wifi, NMAccessPoint *ap, gpointer user_data)
+{
+	g_main_loop_quit (loop);
+}
+
+static void
+test_client_lazy_objects (void)
+{
+	gs_unref_object NMClient *client = NULL;
+	NMDeviceWifi *wifi;
+	const GPtrArray *aps;
+	GError *error = NULL;
+	guint i, timeout_id;
+
+	sinfo = nmtstc_service_init ();
+
+	for (i = 0; i < 4; i++) {
+		gs_unref_variant GVariant *ret = NULL;
+		gs_free char *ssid = NULL;
+		gs_free char *bssid = NULL;
+
+		if (i == 0) {
+			ret = g_dbus_proxy_call_sync (sinfo->proxy,
+			                              "AddWifiDevice",
+			                              g_variant_new ("(s)", "wlan0"),
+			                              G_DBUS_CALL_FLAGS_NO_AUTO_START,
+			                              3000,
+			                              NULL,
+			                              &error);
+			g_assert_no_error (error);
+			g_assert (ret);
+			continue;
+		}
+
+		ssid = g_strdup_printf ("test-ap-%u", i);
+		bssid = g_strdup_printf ("66:55:44:33:22:%02X", i);
+		ret = g_dbus_proxy_call_sync (sinfo->proxy,
+		                              "AddWifiAp",
+		                              g_variant_new ("(sss)", "wlan0", ssid, bssid),
+		                              G_DBUS_CALL_FLAGS_NO_AUTO_START,
+		                              3000,
+		                              NULL,
+		                              &error);
+		g_assert_no_error (error);
+		g_assert (ret);
+	}
+
+	client = g_initable_new (NM_TYPE_CLIENT, NULL, &error,
+	                         NM_CLIENT_LAZY_OBJECTS, TRUE,
+	                         NULL);
+	g_assert_no_error (error);
+	g_assert (client);
+
+	wifi = (NMDeviceWifi *) nm_client_get_device_by_iface (client, "wlan0");
+	g_assert (NM_IS_DEVICE_WIFI (wifi));
+
+	/* the access points are created on first access. */
+	aps = nm_device_wifi_get_access_points (wifi);
+	g_assert (aps);
+	g_assert_cmpint (aps->len, ==, 3);
+	for (i = 0; i < aps->len; i++) {
+		NMAccessPoint *ap = aps->pdata[i];
+
+		g_assert (NM_IS_ACCESS_POINT (ap));
+		g_assert (nm_device_wifi_get_access_point_by_path (wifi, nm_object_get_path (NM_OBJECT (ap))) == ap);
+		g_assert (g_str_has_prefix (nm_access_point_get_bssid (ap), "66:55:44:33:22:0"));
+	}
+
+	/* afterwards, the property is tracked. */
+	g_signal_connect (wifi, "access-point-added", G_CALLBACK (lazy_ap_added_cb), NULL);
+	{
+		gs_unref_variant GVariant *ret = NULL;
+
+		ret = g_dbus_proxy_call_sync (sinfo->proxy,
+		                              "AddWifiAp",
+		                              g_variant_new ("(sss)", "wlan0", "test-ap-4", "66:55:44:33:22:04"),
+		                              G_DBUS_CALL_FLAGS_NO_AUTO_START,
+		                              3000,
+		                              NULL,
+		                              &error);
+		g_assert_no_error (error);
+		g_assert (ret);
+	}
+	timeout_id = g_timeout_add_seconds (5, loop_quit, loop);
+	g_main_loop_run (loop);
+	g_source_remove (timeout_id);
+	g_signal_handlers_disconnect_by_func (wifi, lazy_ap_added_cb, NULL);
+
+	aps = nm_device_wifi_get_access_points (wifi);
+	g_assert_cmpint (aps->len, ==, 4);
+
+	g_clear_object (&client);
+	g_clear_pointer (&sinfo, nmtstc_service_cleanup);
+}
+
+/*****************************************************************************/
+
+static void
+_client_init_many_check (NMClient *client, guint n_objects)
+{
+	const GPtrArray *devices;
+	const GPtrArray *connections;
+	guint i;
+
+	devices = nm_client_get_devices (client);
+	g_assert (devices);
+	g_assert_cmpint (devices->len, ==, n_objects);
+	for (i = 0; i < devices->len; i++)
+		g_assert (NM_IS_DEVICE_ETHERNET (devices->pdata[i]));
+
+	connections = nm_client_get_connections (client);
+	g_assert (connections);
+	g_assert_cmpint (connections->len, ==, n_objects);
+	for (i = 0; i < connections->len; i++) {
+		g_assert (NM_IS_REMOTE_CONNECTION (connections->pdata[i]));
+		g_assert (nm_remote_connection_get_visible (connections->pdata[i]));
+		g_assert (nm_connection_get_id (connections->pdata[i]));
+	}
+}
+
+static void
+test_client_init_many (gconstpointer user_data)
+{
+	guint n_objects = GPOINTER_TO_UINT (user_data);
+	NMClient *client = NULL;
+	GError *error = NULL;
+	gint64 start, time_sync, time_async;
+	guint i;
+
+	if (n_objects > 100 && nmtst_test_quick ()) {
+		g_print ("Skipping test: don't run long running test %s (NMTST_DEBUG=slow)\n", g_get_prgname () ?: "test-nm-client");
+		g_test_skip ("Skip long running test");
+		return;
+	}
+
+	sinfo = nmtstc_service_init ();
+
+	/* Populate the stub service before any client exists. */
+	for (i = 0; i < n_objects; i++) {
+		gs_unref_object NMConnection *connection = NULL;
+		gs_unref_variant GVariant *ret = NULL;
+		gs_free char *ifname = g_strdup_printf ("eth%u", i);
+		gs_free char *id = g_strdup_printf ("test-client-init-many-%u", i);
+		const char *empty[] = { NULL };
+
+		ret = g_dbus_proxy_call_sync (sinfo->proxy,
+		                              "AddWiredDevice",
+		                              g_variant_new ("(ss^as)", ifname, "/", empty),
+		                              G_DBUS_CALL_FLAGS_NO_AUTO_START,
+		                              3000,
+		                              NULL,
+		                              &error);
+		g_assert_no_error (error);
+		g_assert (ret);
+
+		connection = nmtst_create_minimal_connection (id, NULL, NM_SETTING_WIRED_SETTING_NAME, NULL);
+		nmtst_connection_normalize (connection);
+		nmtstc_service_add_connection (sinfo, connection, TRUE, NULL);
+	}
+
+	start = g_get_monotonic_time ();
+	client = nm_client_new (NULL, &error);
+	time_sync = g_get_monotonic_time () - start;
+	g_assert_no_error (error);
+	g_assert (client);
+	_client_init_many_check (client, n_objects);
+	g_clear_object (&client);
+
+	start = g_get_monotonic_time ();
+	nm_client_new_async (NULL, new_client_cb, &client);
+	g_main_loop_run (loop);
+	time_async = g_get_monotonic_time () - start;
+	g_assert (client);
+	_client_init_many_check (client, n_objects);
+	g_clear_object (&client);
+
+	g_test_message ("nm_client_new() with %u devices and %u connections: sync %lld.%06lld sec, async %lld.%06lld sec",
+	                n_objects, n_objects,
+	                (long long) (time_sync / G_USEC_PER_SEC), (long long) (time_sync % G_USEC_PER_SEC),
+	                (long long) (time_async / G_USEC_PER_SEC), (long long) (time_async % G_USEC_PER_SEC));
+
+	g_clear_pointer (&sinfo, nmtstc_service_cleanup);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE ();
 
 int
@@ -1592,6 +1779,9 @@ main (int argc, char **argv)
 	g_test_add_func ("/libnm/activate-failed", test_activate_failed);
 	g_test_add_func ("/libnm/device-connection-compatibility", test_device_connection_compatibility);
 	g_test_add_func ("/libnm/connection/invalid", test_connection_invalid);
+	g_test_add_func ("/libnm/client-lazy-objects", test_client_lazy_objects);
+	g_test_add_data_func ("/libnm/client-init-many/50", GUINT_TO_POINTER (50), test_client_init_many);
+	g_test_add_data_func ("/libnm/client-init-many/1000", GUINT_TO_POINTER (1000), test_client_init_many);
 
 	return g_test_run ();
 }
@@ -48,6 +48,19 @@ nm_hash_complete (NMHashState *state)
 	return (((guint) (h >> 32)) ^ ((guint) h)) ?: 1396707757u;
 }
 
+static inline guint64
+nm_hash_complete_u64 (NMHashState *state)
+{
+	nm_assert (state);
+
+	/* this returns the native u64 hash value. Note that this differs
+	 * from nm_hash_complete() in two ways:
+	 *
+	 * - the type, guint64 vs. guint.
+	 * - nm_hash_complete() never returns zero. */
+	return siphash24_finalize (&state->_state);
+}
+
 static inline void
 nm_hash_update (NMHashState *state, const void *ptr, gsize n)
 {
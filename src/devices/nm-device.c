@@ -1986,7 +1986,6 @@ update_connectivity_state (NMDevice *self, NMConnectivityState state)
 		       nm_connectivity_state_to_string (state));
 #endif
 		priv->connectivity_state = state;
-		_notify (self, PROP_CONNECTIVITY);
 
 		if (   priv->state == NM_DEVICE_STATE_ACTIVATED
 		    && !nm_device_sys_iface_state_is_external (self)) {
@@ -1997,6 +1996,10 @@ update_connectivity_state (NMDevice *self, NMConnectivityState state)
 			    && !ip6_config_merge_and_apply (self, TRUE))
 				_LOGW (LOGD_IP6, "Failed to update IPv6 route metric");
 		}
+
+		/* notify only after the route metric penalty is applied, so that
+		 * NMPolicy re-evaluates the best device with the new metrics. */
+		_notify (self, PROP_CONNECTIVITY);
 	}
 }
 
@@ -11542,8 +11545,8 @@ _set_unmanaged_flags (NMDevice *self,
 		if (!NM_FLAGS_HAS (flags, NM_UNMANAGED_USER_SETTINGS)) {
 			gboolean unmanaged;
 
-			unmanaged = nm_device_spec_match_list (self,
-			                                       nm_settings_get_unmanaged_specs (NM_DEVICE_GET_PRIVATE (self)->settings));
+			unmanaged = nm_device_spec_match_compiled (self,
+			                                           nm_settings_get_unmanaged_specs_compiled (NM_DEVICE_GET_PRIVATE (self)->settings));
 			nm_device_set_unmanaged_flags (self,
 			                               NM_UNMANAGED_USER_SETTINGS,
 			                               !!unmanaged);
@@ -11699,8 +11702,8 @@ nm_device_set_unmanaged_by_user_settings (NMDevice *self)
 		return;
 	}
 
-	unmanaged = nm_device_spec_match_list (self,
-	                                       nm_settings_get_unmanaged_specs (NM_DEVICE_GET_PRIVATE (self)->settings));
+	unmanaged = nm_device_spec_match_compiled (self,
+	                                           nm_settings_get_unmanaged_specs_compiled (NM_DEVICE_GET_PRIVATE (self)->settings));
 
 	nm_device_set_unmanaged_by_flags (self,
 	                                  NM_UNMANAGED_USER_SETTINGS,
@@ -14009,6 +14012,55 @@ nm_device_spec_match_list_full (NMDevice *self, const GSList *specs, int no_matc
 	return no_match_value;
 }
 
+/**
+ * nm_device_spec_match_compiled:
+ * @self: an #NMDevice
+ * @specs: (allow-none): device specs, as parsed by nm_match_spec_device_compile()
+ *
+ * Like nm_device_spec_match_list(), but for a list of specs that was
+ * parsed ahead of time.
+ *
+ * Returns: #TRUE if @self matches one of the specs in @specs
+ */
+gboolean
+nm_device_spec_match_compiled (NMDevice *self, const NMMatchSpecDevice *specs)
+{
+	return nm_device_spec_match_compiled_full (self, specs, FALSE);
+}
+
+int
+nm_device_spec_match_compiled_full (NMDevice *self, const NMMatchSpecDevice *specs, int no_match_value)
+{
+	NMDeviceClass *klass;
+	NMMatchSpecMatchType m;
+
+	g_return_val_if_fail (NM_IS_DEVICE (self), FALSE);
+
+	if (!specs)
+		return no_match_value;
+
+	klass = NM_DEVICE_GET_CLASS (self);
+
+	m = nm_match_spec_device_compiled (specs,
+	                                   nm_device_get_iface (self),
+	                                   nm_device_get_type_description (self),
+	                                   nm_device_get_driver (self),
+	                                   nm_device_get_driver_version (self),
+	                                   nm_device_get_permanent_hw_address (self),
+	                                   klass->get_s390_subchannels ? klass->get_s390_subchannels (self) : NULL);
+
+	switch (m) {
+	case NM_MATCH_SPEC_MATCH:
+		return TRUE;
+	case NM_MATCH_SPEC_NEG_MATCH:
+		return FALSE;
+	case NM_MATCH_SPEC_NO_MATCH:
+		return no_match_value;
+	}
+	nm_assert_not_reached ();
+	return no_match_value;
+}
+
 guint
 nm_device_get_supplicant_timeout (NMDevice *self)
 {
@@ -528,6 +528,8 @@ gboolean nm_device_unmanage_on_quit (NMDevice *self);
 
 gboolean nm_device_spec_match_list (NMDevice *device, const GSList *specs);
 int      nm_device_spec_match_list_full (NMDevice *self, const GSList *specs, int no_match_value);
+gboolean nm_device_spec_match_compiled (NMDevice *device, const NMMatchSpecDevice *specs);
+int      nm_device_spec_match_compiled_full (NMDevice *self, const NMMatchSpecDevice *specs, int no_match_value);
 
 gboolean nm_device_is_activating (NMDevice *dev);
 gboolean nm_device_autoconnect_allowed (NMDevice *self);
@@ -27,6 +27,7 @@
 
 #include "platform/nm-platform.h"
 #include "nm-utils.h"
+#include "nm-core-internal.h"
 
 #include "systemd/nm-sd.h"
 
@@ -78,6 +79,14 @@ typedef struct {
 	sd_lldp      *lldp_handle;
 	GHashTable   *lldp_neighbors;
 
+	/* the entries of @lldp_neighbors, sorted by lldp_neighbor_id_cmp().
+	 * The hash table owns them. */
+	GPtrArray    *lldp_neighbors_sorted;
+
+	/* whether we ignored a neighbor due to MAX_NEIGHBORS. Then we cannot
+	 * skip refresh events, as the neighbor might fit now. */
+	bool          neighbors_dropped:1;
+
 	/* the timestamp in nsec until which we delay updates. */
 	gint64        ratelimit_next;
 	guint         ratelimit_id;
@@ -301,6 +310,12 @@ lldp_neighbor_id_cmp (gconstpointer a, gconstpointer b)
 	return c < 0 ? -1 : (c > 0 ? 1 : 0);
 }
 
+static int
+lldp_neighbor_id_cmp_with_data (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+	return lldp_neighbor_id_cmp (a, b);
+}
+
 static gboolean
 lldp_neighbor_id_equal (gconstpointer a, gconstpointer b)
 {
@@ -340,7 +355,7 @@ lldp_neighbor_equal (LldpNeighbor *a, LldpNeighbor *b)
 
 	if (   a->chassis_id_type != b->chassis_id_type
 	    || a->port_id_type != b->port_id_type
-	    || ether_addr_equal (&a->destination_address, &b->destination_address)
+	    || !ether_addr_equal (&a->destination_address, &b->destination_address)
 	    || !nm_streq0 (a->chassis_id, b->chassis_id)
 	    || !nm_streq0 (a->port_id, b->port_id))
 		return FALSE;
@@ -653,6 +668,16 @@ data_changed_schedule (NMLldpListener *self)
 		priv->ratelimit_id = g_timeout_add (NM_UTILS_NS_TO_MSEC_CEIL (priv->ratelimit_next - now), data_changed_timeout, self);
 }
 
+static gssize
+_neighbors_sorted_find (NMLldpListenerPrivate *priv, const LldpNeighbor *neigh)
+{
+	return _nm_utils_ptrarray_find_binary_search ((gconstpointer *) priv->lldp_neighbors_sorted->pdata,
+	                                              priv->lldp_neighbors_sorted->len,
+	                                              neigh,
+	                                              lldp_neighbor_id_cmp_with_data,
+	                                              NULL);
+}
+
 static void
 process_lldp_neighbor (NMLldpListener *self, sd_lldp_neighbor *neighbor_sd, gboolean neighbor_valid)
 {
@@ -662,6 +687,7 @@ process_lldp_neighbor (NMLldpListener *self, sd_lldp_neighbor *neighbor_sd, gboo
 	gs_free_error GError *parse_error = NULL;
 	GError **p_parse_error;
 	gboolean changed = FALSE;
+	gssize idx;
 
 	g_return_if_fail (NM_IS_LLDP_LISTENER (self));
 
@@ -688,6 +714,9 @@ process_lldp_neighbor (NMLldpListener *self, sd_lldp_neighbor *neighbor_sd, gboo
 			       "remove", LOG_NEIGH_ARG (neigh),
 			       NM_PRINT_FMT_QUOTED (parse_error, " (failed to parse: ", parse_error->message, ")", ""));
 
+			idx = _neighbors_sorted_find (priv, neigh_old);
+			nm_assert (idx >= 0);
+			g_ptr_array_remove_index (priv->lldp_neighbors_sorted, idx);
 			g_hash_table_remove (priv->lldp_neighbors, neigh_old);
 			changed = TRUE;
 			goto done;
@@ -703,6 +732,7 @@ process_lldp_neighbor (NMLldpListener *self, sd_lldp_neighbor *neighbor_sd, gboo
 	if (   !neigh_old /* only matters in the "add" case. */
 	    && (g_hash_table_size (priv->lldp_neighbors) + 1 > MAX_NEIGHBORS)) {
 		_LOGT ("process: ignore neighbor due to overall limit of %d", MAX_NEIGHBORS);
+		priv->neighbors_dropped = TRUE;
 		return;
 	}
 
@@ -710,6 +740,17 @@ process_lldp_neighbor (NMLldpListener *self, sd_lldp_neighbor *neighbor_sd, gboo
 	        neigh_old ? "update" : "new",
 	        LOG_NEIGH_ARG (neigh));
 
+	/* the ID is unchanged on update, so is the position in the sorted list.
+	 * The other neighbors keep their cached variant. */
+	idx = _neighbors_sorted_find (priv, neigh);
+	if (neigh_old) {
+		nm_assert (idx >= 0);
+		priv->lldp_neighbors_sorted->pdata[idx] = neigh;
+	} else {
+		nm_assert (idx < 0);
+		g_ptr_array_insert (priv->lldp_neighbors_sorted, ~idx, neigh);
+	}
+
 	changed = TRUE;
 	g_hash_table_add (priv->lldp_neighbors, g_steal_pointer (&neigh));
 
@@ -721,7 +762,15 @@ done:
 static void
 lldp_event_handler (sd_lldp *lldp, sd_lldp_event event, sd_lldp_neighbor *n, void *userdata)
 {
-	process_lldp_neighbor (userdata, n, event != SD_LLDP_EVENT_REMOVED);
+	NMLldpListener *self = userdata;
+
+	/* sd-lldp only signals a refresh if the received data is identical
+	 * to what it had before. There is no need to parse it again. */
+	if (   event == SD_LLDP_EVENT_REFRESHED
+	    && !NM_LLDP_LISTENER_GET_PRIVATE (self)->neighbors_dropped)
+		return;
+
+	process_lldp_neighbor (self, n, event != SD_LLDP_EVENT_REMOVED);
 }
 
 gboolean
@@ -810,6 +859,7 @@ nm_lldp_listener_stop (NMLldpListener *self)
 		priv->lldp_handle = NULL;
 
 		size = g_hash_table_size (priv->lldp_neighbors);
+		g_ptr_array_set_size (priv->lldp_neighbors_sorted, 0);
 		g_hash_table_remove_all (priv->lldp_neighbors);
 		if (size || priv->ratelimit_id)
 			changed = TRUE;
@@ -818,6 +868,7 @@ nm_lldp_listener_stop (NMLldpListener *self)
 	nm_clear_g_source (&priv->ratelimit_id);
 	priv->ratelimit_next = 0;
 	priv->ifindex = 0;
+	priv->neighbors_dropped = FALSE;
 
 	if (changed)
 		data_changed_notify (self, priv);
@@ -839,19 +890,18 @@ nm_lldp_listener_get_neighbors (NMLldpListener *self)
 {
 	NMLldpListenerPrivate *priv;
 	GVariantBuilder array_builder;
-	GList *neighbors, *iter;
+	guint i;
 
 	g_return_val_if_fail (NM_IS_LLDP_LISTENER (self), FALSE);
 
 	priv = NM_LLDP_LISTENER_GET_PRIVATE (self);
 
 	if (!priv->variant) {
+		/* only neighbors that were added or changed since the last call
+		 * need to be serialized, the others have their variant cached. */
 		g_variant_builder_init (&array_builder, G_VARIANT_TYPE ("aa{sv}"));
-		neighbors = g_hash_table_get_keys (priv->lldp_neighbors);
-		neighbors = g_list_sort (neighbors, lldp_neighbor_id_cmp);
-		for (iter = neighbors; iter; iter = iter->next)
-			g_variant_builder_add_value (&array_builder, lldp_neighbor_to_variant (iter->data));
-		g_list_free (neighbors);
+		for (i = 0; i < priv->lldp_neighbors_sorted->len; i++)
+			g_variant_builder_add_value (&array_builder, lldp_neighbor_to_variant (priv->lldp_neighbors_sorted->pdata[i]));
 		priv->variant = g_variant_ref_sink (g_variant_builder_end (&array_builder));
 	}
 	return priv->variant;
@@ -881,6 +931,7 @@ nm_lldp_listener_init (NMLldpListener *self)
 	priv->lldp_neighbors = g_hash_table_new_full (lldp_neighbor_id_hash,
 	                                              lldp_neighbor_id_equal,
 	                                              (GDestroyNotify) lldp_neighbor_free, NULL);
+	priv->lldp_neighbors_sorted = g_ptr_array_new ();
 
 	_LOGT ("lldp listener created");
 }
@@ -906,6 +957,7 @@ finalize (GObject *object)
 	NMLldpListenerPrivate *priv = NM_LLDP_LISTENER_GET_PRIVATE (self);
 
 	nm_lldp_listener_stop (self);
+	g_ptr_array_unref (priv->lldp_neighbors_sorted);
 	g_hash_table_unref (priv->lldp_neighbors);
 
 	nm_clear_g_variant (&priv->variant);
@@ -65,13 +65,22 @@ enum {
 
 static guint signals[LAST_SIGNAL] = { 0 };
 
+NM_GOBJECT_PROPERTIES_DEFINE_BASE (
+	PROP_SOCKET_PATH,
+);
+
 typedef struct {
 	GSocketClient *client;
 	GSocketConnection *conn;
 	GCancellable *cancellable;
 	char buf[4096];                 /* Input buffer */
-	size_t bufp;                    /* Last decoded byte in the input buffer. */
 	GString *input;                 /* JSON stream waiting for decoding. */
+	gsize input_scan;               /* Bytes of @input already seen by the framer. */
+	gsize input_start;              /* Start of the incomplete message in @input. */
+	guint input_depth;              /* Nesting level at @input_scan. */
+	bool input_in_string:1;         /* @input_scan is inside a JSON string. */
+	bool input_escape:1;            /* ... right after a backslash. */
+	char *socket_path;
 	GString *output;                /* JSON stream to be sent. */
 	gint64 seq;
 	GArray *calls;                  /* Method calls waiting for a response. */
@@ -106,6 +115,9 @@ static void ovsdb_disconnect (NMOvsdb *self);
 static void ovsdb_read (NMOvsdb *self);
 static void ovsdb_write (NMOvsdb *self);
 static void ovsdb_next_command (NMOvsdb *self);
+static void _free_bridge (gpointer data);
+static void _free_port (gpointer data);
+static void _free_interface (gpointer data);
 
 /*****************************************************************************/
 
@@ -124,6 +136,7 @@ typedef struct {
 	gint64 id;
 #define COMMAND_PENDING -1                      /* id not yet assigned */
 	OvsdbCommand command;
+	bool no_batch;                          /* don't merge with other calls */
 	OvsdbMethodCallback callback;
 	gpointer user_data;
 	union {
@@ -221,6 +234,125 @@ ovsdb_call_method (NMOvsdb *self, OvsdbCommand command,
 
 /* Create and process the JSON-RPC messages from ovsdb. */
 
+/* A copy of the bridges, ports and interfaces we know of. The add and
+ * delete operations of a batched transaction update it, so that each
+ * operation sees the state left by the ones before it in the same
+ * transaction. Rows that are inserted by the transaction are keyed by
+ * their uuid-name. */
+typedef struct {
+	GHashTable *bridges;
+	GHashTable *ports;
+	GHashTable *interfaces;
+} OvsdbCache;
+
+#define ROW_NAME_PREFIX "row"
+
+/* The most calls merged into a single transaction. Each add operation
+ * repeats the port list of its bridge, so this bounds the message size. */
+#define BATCH_MAX 256
+
+static GPtrArray *
+_uuids_dup (const GPtrArray *uuids)
+{
+	GPtrArray *dup;
+	guint i;
+
+	dup = g_ptr_array_new_full (uuids->len, g_free);
+	for (i = 0; i < uuids->len; i++)
+		g_ptr_array_add (dup, g_strdup (uuids->pdata[i]));
+	return dup;
+}
+
+static OpenvswitchBridge *
+_cache_add_bridge (OvsdbCache *cache, const char *uuid,
+                   const char *name, const char *connection_uuid, const GPtrArray *ports)
+{
+	OpenvswitchBridge *ovs_bridge;
+
+	ovs_bridge = g_slice_new (OpenvswitchBridge);
+	ovs_bridge->name = g_strdup (name);
+	ovs_bridge->connection_uuid = g_strdup (connection_uuid);
+	ovs_bridge->ports = ports ? _uuids_dup (ports) : g_ptr_array_new_with_free_func (g_free);
+	g_hash_table_insert (cache->bridges, g_strdup (uuid), ovs_bridge);
+	return ovs_bridge;
+}
+
+static OpenvswitchPort *
+_cache_add_port (OvsdbCache *cache, const char *uuid,
+                 const char *name, const char *connection_uuid, const GPtrArray *interfaces)
+{
+	OpenvswitchPort *ovs_port;
+
+	ovs_port = g_slice_new (OpenvswitchPort);
+	ovs_port->name = g_strdup (name);
+	ovs_port->connection_uuid = g_strdup (connection_uuid);
+	ovs_port->interfaces = interfaces ? _uuids_dup (interfaces) : g_ptr_array_new_with_free_func (g_free);
+	g_hash_table_insert (cache->ports, g_strdup (uuid), ovs_port);
+	return ovs_port;
+}
+
+static OpenvswitchInterface *
+_cache_add_interface (OvsdbCache *cache, const char *uuid,
+                      const char *name, const char *type, const char *connection_uuid)
+{
+	OpenvswitchInterface *ovs_interface;
+
+	ovs_interface = g_slice_new (OpenvswitchInterface);
+	ovs_interface->name = g_strdup (name);
+	ovs_interface->type = g_strdup (type);
+	ovs_interface->connection_uuid = g_strdup (connection_uuid);
+	g_hash_table_insert (cache->interfaces, g_strdup (uuid), ovs_interface);
+	return ovs_interface;
+}
+
+static void
+_cache_init (OvsdbCache *cache, NMOvsdbPrivate *priv)
+{
+	GHashTableIter iter;
+	const char *uuid;
+	OpenvswitchBridge *ovs_bridge;
+	OpenvswitchPort *ovs_port;
+	OpenvswitchInterface *ovs_interface;
+
+	cache->bridges = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, _free_bridge);
+	cache->ports = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, _free_port);
+	cache->interfaces = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, _free_interface);
+
+	g_hash_table_iter_init (&iter, priv->bridges);
+	while (g_hash_table_iter_next (&iter, (gpointer) &uuid, (gpointer) &ovs_bridge))
+		_cache_add_bridge (cache, uuid, ovs_bridge->name, ovs_bridge->connection_uuid, ovs_bridge->ports);
+
+	g_hash_table_iter_init (&iter, priv->ports);
+	while (g_hash_table_iter_next (&iter, (gpointer) &uuid, (gpointer) &ovs_port))
+		_cache_add_port (cache, uuid, ovs_port->name, ovs_port->connection_uuid, ovs_port->interfaces);
+
+	g_hash_table_iter_init (&iter, priv->interfaces);
+	while (g_hash_table_iter_next (&iter, (gpointer) &uuid, (gpointer) &ovs_interface))
+		_cache_add_interface (cache, uuid, ovs_interface->name, ovs_interface->type, ovs_interface->connection_uuid);
+}
+
+static void
+_cache_clear (OvsdbCache *cache)
+{
+	g_clear_pointer (&cache->bridges, g_hash_table_unref);
+	g_clear_pointer (&cache->ports, g_hash_table_unref);
+	g_clear_pointer (&cache->interfaces, g_hash_table_unref);
+}
+
+/**
+ * _uuid_ref:
+ *
+ * Returns a reference to a row, which is a named-uuid for rows that are
+ * inserted by the transaction (see #OvsdbCache).
+ */
+static json_t *
+_uuid_ref (const char *uuid)
+{
+	return json_pack ("[s, s]",
+	                  g_str_has_prefix (uuid, ROW_NAME_PREFIX) ? "named-uuid" : "uuid",
+	                  uuid);
+}
+
 /**
  * _expect_ovs_bridges:
  *
@@ -338,7 +470,7 @@ _set_port_interfaces (json_t *params, const char *ifname, json_t *new_interfaces
  * Returns an commands that adds new interface from a given connection.
  */
 static void
-_insert_interface (json_t *params, NMConnection *interface)
+_insert_interface (json_t *params, NMConnection *interface, const char *uuid_name)
 {
 	const char *type = NULL;
 	NMSettingOvsInterface *s_ovs_iface;
@@ -366,7 +498,7 @@ _insert_interface (json_t *params, NMConnection *interface)
 		           "type", type ? type : "",
 		           "options", options,
 		           "external_ids", "map", "NM.connection.uuid", nm_connection_get_uuid (interface),
-		           "uuid-name", "rowInterface"));
+		           "uuid-name", uuid_name));
 }
 
 /**
@@ -375,7 +507,7 @@ _insert_interface (json_t *params, NMConnection *interface)
  * Returns an commands that adds new port from a given connection.
  */
 static void
-_insert_port (json_t *params, NMConnection *port, json_t *new_interfaces)
+_insert_port (json_t *params, NMConnection *port, json_t *new_interfaces, const char *uuid_name)
 {
 	NMSettingOvsPort *s_ovs_port;
 	const char *vlan_mode = NULL;
@@ -421,7 +553,7 @@ _insert_port (json_t *params, NMConnection *port, json_t *new_interfaces)
 	/* Create a new one. */
 	json_array_append_new (params,
 		json_pack ("{s:s, s:s, s:o, s:s}", "op", "insert", "table", "Port",
-		           "row", row, "uuid-name", "rowPort"));
+		           "row", row, "uuid-name", uuid_name));
 }
 
 /**
@@ -430,7 +562,7 @@ _insert_port (json_t *params, NMConnection *port, json_t *new_interfaces)
  * Returns an commands that adds new bridge from a given connection.
  */
 static void
-_insert_bridge (json_t *params, NMConnection *bridge, json_t *new_ports)
+_insert_bridge (json_t *params, NMConnection *bridge, json_t *new_ports, const char *uuid_name)
 {
 	NMSettingOvsBridge *s_ovs_bridge;
 	const char *fail_mode = NULL;
@@ -468,7 +600,7 @@ _insert_bridge (json_t *params, NMConnection *bridge, json_t *new_ports)
 	/* Create a new one. */
 	json_array_append_new (params,
 		json_pack ("{s:s, s:s, s:o, s:s}", "op", "insert", "table", "Bridge",
-		           "row", row, "uuid-name", "rowBridge"));
+		           "row", row, "uuid-name", uuid_name));
 }
 
 /**
@@ -490,10 +622,12 @@ _inc_next_cfg (const char *db_uuid)
  * _add_interface:
  *
  * Adds an interface as specified by @interface connection, optionally creating
- * a parent @port and @bridge if needed.
+ * a parent @port and @bridge if needed. The rows get inserted with uuid-names
+ * suffixed by @idx, which needs to be unique within the transaction, and are
+ * added to @cache.
  */
 static void
-_add_interface (NMOvsdb *self, json_t *params,
+_add_interface (NMOvsdb *self, json_t *params, OvsdbCache *cache, guint idx,
                 NMConnection *bridge, NMConnection *port, NMConnection *interface)
 {
 	NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE (self);
@@ -504,12 +638,20 @@ _add_interface (NMOvsdb *self, json_t *params,
 	OpenvswitchBridge *ovs_bridge = NULL;
 	OpenvswitchPort *ovs_port = NULL;
 	OpenvswitchInterface *ovs_interface = NULL;
+	OpenvswitchBridge *found_bridge = NULL;
+	OpenvswitchPort *found_port = NULL;
+	NMSettingOvsInterface *s_ovs_iface;
 	int pi;
 	int ii;
 	json_t *bridges, *new_bridges;
 	json_t *ports, *new_ports;
 	json_t *interfaces, *new_interfaces;
 	gboolean has_interface = FALSE;
+	char row_bridge[64], row_port[64], row_interface[64];
+
+	nm_sprintf_buf (row_bridge, ROW_NAME_PREFIX "Bridge%u", idx);
+	nm_sprintf_buf (row_port, ROW_NAME_PREFIX "Port%u", idx);
+	nm_sprintf_buf (row_interface, ROW_NAME_PREFIX "Interface%u", idx);
 
 	bridges = json_array ();
 	ports = json_array ();
@@ -518,29 +660,33 @@ _add_interface (NMOvsdb *self, json_t *params,
 	new_ports = json_array ();
 	new_interfaces = json_array ();
 
-	g_hash_table_iter_init (&iter, priv->bridges);
+	g_hash_table_iter_init (&iter, cache->bridges);
 	while (g_hash_table_iter_next (&iter, (gpointer) &bridge_uuid, (gpointer) &ovs_bridge)) {
-		json_array_append_new (bridges, json_pack ("[s, s]", "uuid", bridge_uuid));
+		json_array_append_new (bridges, _uuid_ref (bridge_uuid));
 
 		if (   g_strcmp0 (ovs_bridge->name, nm_connection_get_interface_name (bridge)) != 0
 		    || g_strcmp0 (ovs_bridge->connection_uuid, nm_connection_get_uuid (bridge)) != 0)
 			continue;
 
+		found_bridge = ovs_bridge;
+
 		for (pi = 0; pi < ovs_bridge->ports->len; pi++) {
 			port_uuid = g_ptr_array_index (ovs_bridge->ports, pi);
-			ovs_port = g_hash_table_lookup (priv->ports, port_uuid);
+			ovs_port = g_hash_table_lookup (cache->ports, port_uuid);
 
-			json_array_append_new (ports, json_pack ("[s, s]", "uuid", port_uuid));
+			json_array_append_new (ports, _uuid_ref (port_uuid));
 
 			if (   g_strcmp0 (ovs_port->name, nm_connection_get_interface_name (port)) != 0
 			    || g_strcmp0 (ovs_port->connection_uuid, nm_connection_get_uuid (port)) != 0)
 				continue;
 
+			found_port = ovs_port;
+
 			for (ii = 0; ii < ovs_port->interfaces->len; ii++) {
 				interface_uuid = g_ptr_array_index (ovs_port->interfaces, ii);
-				ovs_interface = g_hash_table_lookup (priv->interfaces, interface_uuid);
+				ovs_interface = g_hash_table_lookup (cache->interfaces, interface_uuid);
 
-				json_array_append_new (interfaces, json_pack ("[s, s]", "uuid", interface_uuid));
+				json_array_append_new (interfaces, _uuid_ref (interface_uuid));
 
 				if (   g_strcmp0 (ovs_interface->name, nm_connection_get_interface_name (interface)) == 0
 				    && g_strcmp0 (ovs_interface->connection_uuid, nm_connection_get_uuid (interface)) == 0)
@@ -562,28 +708,46 @@ _add_interface (NMOvsdb *self, json_t *params,
 		if (json_array_size (ports) == 0) {
 			/* Need to create a bridge. */
 			_expect_ovs_bridges (params, priv->db_uuid, bridges);
-			json_array_append_new (new_bridges, json_pack ("[s, s]", "named-uuid", "rowBridge"));
+			json_array_append_new (new_bridges, _uuid_ref (row_bridge));
 			_set_ovs_bridges (params, priv->db_uuid, new_bridges);
-			_insert_bridge (params, bridge, new_ports);
+			_insert_bridge (params, bridge, new_ports, row_bridge);
+
+			found_bridge = _cache_add_bridge (cache, row_bridge,
+			                                  nm_connection_get_interface_name (bridge),
+			                                  nm_connection_get_uuid (bridge),
+			                                  NULL);
 		} else {
 			/* Bridge already exists. */
-			g_return_if_fail (ovs_bridge);
-			_expect_bridge_ports (params, ovs_bridge->name, ports);
+			g_return_if_fail (found_bridge);
+			_expect_bridge_ports (params, found_bridge->name, ports);
 			_set_bridge_ports (params, nm_connection_get_interface_name (bridge), new_ports);
 		}
 
-		json_array_append_new (new_ports, json_pack ("[s, s]", "named-uuid", "rowPort"));
-		_insert_port (params, port, new_interfaces);
+		json_array_append_new (new_ports, _uuid_ref (row_port));
+		_insert_port (params, port, new_interfaces, row_port);
+
+		found_port = _cache_add_port (cache, row_port,
+		                              nm_connection_get_interface_name (port),
+		                              nm_connection_get_uuid (port),
+		                              NULL);
+		g_ptr_array_add (found_bridge->ports, g_strdup (row_port));
 	} else {
 		/* Port already exists */
-		g_return_if_fail (ovs_port);
-		_expect_port_interfaces (params, ovs_port->name, interfaces);
+		g_return_if_fail (found_port);
+		_expect_port_interfaces (params, found_port->name, interfaces);
 		_set_port_interfaces (params, nm_connection_get_interface_name (port), new_interfaces);
 	}
 
 	if (!has_interface) {
-		_insert_interface (params, interface);
-		json_array_append_new (new_interfaces, json_pack ("[s, s]", "named-uuid", "rowInterface"));
+		_insert_interface (params, interface, row_interface);
+		json_array_append_new (new_interfaces, _uuid_ref (row_interface));
+
+		s_ovs_iface = nm_connection_get_setting_ovs_interface (interface);
+		_cache_add_interface (cache, row_interface,
+		                      nm_connection_get_interface_name (interface),
+		                      s_ovs_iface ? nm_setting_ovs_interface_get_interface_type (s_ovs_iface) : NULL,
+		                      nm_connection_get_uuid (interface));
+		g_ptr_array_add (found_port->interfaces, g_strdup (row_interface));
 	}
 
 	json_decref (interfaces);
@@ -599,10 +763,11 @@ _add_interface (NMOvsdb *self, json_t *params,
  * _delete_interface:
  *
  * Removes an interface of @ifname name, collecting empty ports and bridge
- * if last item is removed from them.
+ * if last item is removed from them. The removed rows are dropped
+ * from @cache.
  */
 static void
-_delete_interface (NMOvsdb *self, json_t *params, const char *ifname)
+_delete_interface (NMOvsdb *self, json_t *params, OvsdbCache *cache, const char *ifname)
 {
 	NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE (self);
 	GHashTableIter iter;
@@ -625,47 +790,53 @@ _delete_interface (NMOvsdb *self, json_t *params, const char *ifname)
 	new_bridges = json_array ();
 	bridges_changed = FALSE;
 
-	g_hash_table_iter_init (&iter, priv->bridges);
+	g_hash_table_iter_init (&iter, cache->bridges);
 	while (g_hash_table_iter_next (&iter, (gpointer) &bridge_uuid, (gpointer) &ovs_bridge)) {
-		json_array_append_new (bridges, json_pack ("[s,s]", "uuid", bridge_uuid));
+		json_array_append_new (bridges, _uuid_ref (bridge_uuid));
 
 		ports = json_array ();
 		new_ports = json_array ();
 		ports_changed = FALSE;
 
-		for (pi = 0; pi < ovs_bridge->ports->len; pi++) {
+		for (pi = 0; pi < ovs_bridge->ports->len; ) {
 			port_uuid = g_ptr_array_index (ovs_bridge->ports, pi);
-			ovs_port = g_hash_table_lookup (priv->ports, port_uuid);
+			ovs_port = g_hash_table_lookup (cache->ports, port_uuid);
 
-			json_array_append_new (ports, json_pack ("[s,s]", "uuid", port_uuid));
+			json_array_append_new (ports, _uuid_ref (port_uuid));
 
 			interfaces = json_array ();
 			new_interfaces = json_array ();
 			interfaces_changed = FALSE;
 
-			for (ii = 0; ii < ovs_port->interfaces->len; ii++) {
+			for (ii = 0; ii < ovs_port->interfaces->len; ) {
 				interface_uuid = g_ptr_array_index (ovs_port->interfaces, ii);
-				ovs_interface = g_hash_table_lookup (priv->interfaces, interface_uuid);
+				ovs_interface = g_hash_table_lookup (cache->interfaces, interface_uuid);
 
-				json_array_append_new (interfaces, json_pack ("[s,s]", "uuid", interface_uuid));
+				json_array_append_new (interfaces, _uuid_ref (interface_uuid));
 
 				if (strcmp (ovs_interface->name, ifname) == 0) {
 					/* skip the interface */
 					interfaces_changed = TRUE;
+					g_hash_table_remove (cache->interfaces, interface_uuid);
+					g_ptr_array_remove_index (ovs_port->interfaces, ii);
 					continue;
 				}
 
-				json_array_append_new (new_interfaces, json_pack ("[s,s]", "uuid", interface_uuid));
+				json_array_append_new (new_interfaces, _uuid_ref (interface_uuid));
+				ii++;
 			}
 
 			if (json_array_size (new_interfaces) == 0) {
 				ports_changed = TRUE;
+				g_hash_table_remove (cache->ports, port_uuid);
+				g_ptr_array_remove_index (ovs_bridge->ports, pi);
 			} else {
 				if (interfaces_changed) {
 					_expect_port_interfaces (params, ovs_port->name, interfaces);
 					_set_port_interfaces (params, ovs_port->name, new_interfaces);
 				}
-				json_array_append_new (new_ports, json_pack ("[s,s]", "uuid", port_uuid));
+				json_array_append_new (new_ports, _uuid_ref (port_uuid));
+				pi++;
 			}
 
 			json_decref (interfaces);
@@ -674,12 +845,13 @@ _delete_interface (NMOvsdb *self, json_t *params, const char *ifname)
 
 		if (json_array_size (new_ports) == 0) {
 			bridges_changed = TRUE;
+			g_hash_table_iter_remove (&iter);
 		} else {
 			if (ports_changed) {
 				_expect_bridge_ports (params, ovs_bridge->name, ports);
 				_set_bridge_ports (params, ovs_bridge->name, new_ports);
 			}
-			json_array_append_new (new_bridges, json_pack ("[s,s]", "uuid", bridge_uuid));
+			json_array_append_new (new_bridges, _uuid_ref (bridge_uuid));
 		}
 
 		json_decref (ports);
@@ -690,6 +862,9 @@ _delete_interface (NMOvsdb *self, json_t *params, const char *ifname)
 		_expect_ovs_bridges (params, priv->db_uuid, bridges);
 		_set_ovs_bridges (params, priv->db_uuid, new_bridges);
 	}
+
+	json_decref (bridges);
+	json_decref (new_bridges);
 }
 
 /**
@@ -701,15 +876,18 @@ _delete_interface (NMOvsdb *self, json_t *params, const char *ifname)
  * Only called when no command is waiting for a response, since the serialized
  * command might depend on result of a previous one (add and remove need to
  * include an up to date bridge list in their transactions to rule out races).
+ * Consecutive add and remove calls are sent as a single transaction.
  */
 static void
 ovsdb_next_command (NMOvsdb *self)
 {
 	NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE (self);
 	OvsdbMethodCall *call = NULL;
+	OvsdbCache cache;
 	char *cmd;
 	json_t *msg = NULL;
 	json_t *params;
+	guint i;
 
 	if (!priv->conn)
 		return;
@@ -736,22 +914,38 @@ ovsdb_next_command (NMOvsdb *self)
 		                 "Open_vSwitch", "columns");
 		break;
 	case OVSDB_ADD_INTERFACE:
-		params = json_array ();
-		json_array_append_new (params, json_string ("Open_vSwitch"));
-		json_array_append_new (params, _inc_next_cfg (priv->db_uuid));
-
-		_add_interface (self, params, call->bridge, call->port, call->interface);
-
-		msg = json_pack ("{s:i, s:s, s:o}",
-		                 "id", call->id,
-		                 "method", "transact", "params", params);
-		break;
 	case OVSDB_DEL_INTERFACE:
 		params = json_array ();
 		json_array_append_new (params, json_string ("Open_vSwitch"));
 		json_array_append_new (params, _inc_next_cfg (priv->db_uuid));
 
-		_delete_interface (self, params, call->ifname);
+		/* Merge the pending add and delete calls that follow into the
+		 * same transaction. They share the id of the first one. */
+		_cache_init (&cache, priv);
+		for (i = 0; i < priv->calls->len && i < BATCH_MAX; i++) {
+			OvsdbMethodCall *c = &g_array_index (priv->calls, OvsdbMethodCall, i);
+
+			if (   i > 0
+			    && (   c->id != COMMAND_PENDING
+			        || c->no_batch
+			        || !NM_IN_SET (c->command, OVSDB_ADD_INTERFACE, OVSDB_DEL_INTERFACE)))
+				break;
+
+			c->id = call->id;
+			if (c->command == OVSDB_ADD_INTERFACE)
+				_add_interface (self, params, &cache, i, c->bridge, c->port, c->interface);
+			else
+				_delete_interface (self, params, &cache, c->ifname);
+
+			if (call->no_batch) {
+				i++;
+				break;
+			}
+		}
+		_cache_clear (&cache);
+
+		if (i > 1)
+			_LOGT ("call %" G_GINT64_FORMAT ": batching %u calls in one transaction", call->id, i);
 
 		msg = json_pack ("{s:i, s:s, s:o}",
 		                 "id", call->id,
@@ -1057,6 +1251,32 @@ ovsdb_got_echo (NMOvsdb *self, json_int_t id, json_t *data)
 		ovsdb_write (self);
 }
 
+/**
+ * _transact_result_get_error:
+ *
+ * Checks the operation results of a transaction for errors.
+ *
+ * Returns: %TRUE and sets @error if any of the operations failed.
+ */
+static gboolean
+_transact_result_get_error (json_t *result, GError **error)
+{
+	const char *err;
+	const char *err_details;
+	size_t index;
+	json_t *value;
+
+	json_array_foreach (result, index, value) {
+		if (json_unpack (value, "{s:s, s:s}", "error", &err, "details", &err_details) == 0) {
+			g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED,
+			             "Error running the transaction: %s: %s", err, err_details);
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
 /**
  * ovsdb_got_msg::
  *
@@ -1078,6 +1298,7 @@ ovsdb_got_msg (NMOvsdb *self, json_t *msg)
 	OvsdbMethodCallback callback;
 	gpointer user_data;
 	GError *local = NULL;
+	guint n, i;
 
 	if (json_unpack_ex (msg, &json_error, 0, "{s?:o, s?:s, s?:o, s?:o, s?:o}",
 	                    "id", &json_id,
@@ -1130,6 +1351,29 @@ ovsdb_got_msg (NMOvsdb *self, json_t *msg)
 
 		_call_trace ("response", call, msg);
 
+		/* A batched transaction answers all the calls that were merged
+		 * into it. */
+		for (n = 1; n < priv->calls->len; n++) {
+			if (g_array_index (priv->calls, OvsdbMethodCall, n).id != id)
+				break;
+		}
+
+		if (   n > 1
+		    && (   !json_is_null (error)
+		        || _transact_result_get_error (result, NULL))) {
+			/* The whole transaction was rolled back. Retry the calls
+			 * one by one, so that the error is only reported to the
+			 * one that caused it. */
+			_LOGD ("call %" G_GINT64_FORMAT ": transaction of %u calls failed, retrying them separately", id, n);
+			for (i = 0; i < n; i++) {
+				call = &g_array_index (priv->calls, OvsdbMethodCall, i);
+				call->id = COMMAND_PENDING;
+				call->no_batch = TRUE;
+			}
+			ovsdb_next_command (self);
+			return;
+		}
+
 		if (!json_is_null (error)) {
 			/* The response contains an error. */
 			g_set_error (&local, G_IO_ERROR, G_IO_ERROR_FAILED,
@@ -1137,15 +1381,22 @@ ovsdb_got_msg (NMOvsdb *self, json_t *msg)
 			              json_string_value (error));
 		}
 
-		callback = call->callback;
-		user_data = call->user_data;
-		g_array_remove_index (priv->calls, 0);
-		callback (self, result, local, user_data);
-
-		/* Don't progress further commands in case the callback hit an error
-		 * and disconnected us. */
-		if (!priv->conn)
-			return;
+		while (   priv->calls->len
+		       && g_array_index (priv->calls, OvsdbMethodCall, 0).id == id) {
+			call = &g_array_index (priv->calls, OvsdbMethodCall, 0);
+			callback = call->callback;
+			user_data = call->user_data;
+			g_array_remove_index (priv->calls, 0);
+			callback (self, result, local ? g_error_copy (local) : NULL, user_data);
+
+			/* Don't progress further commands in case the callback hit an error
+			 * and disconnected us. */
+			if (!priv->conn) {
+				g_clear_error (&local);
+				return;
+			}
+		}
+		g_clear_error (&local);
 
 		/* Now we're free to serialize and send the next command, if any. */
 		ovsdb_next_command (self);
@@ -1163,22 +1414,87 @@ ovsdb_got_msg (NMOvsdb *self, json_t *msg)
 /* Lower level marshalling and demarshalling of the JSON-RPC traffic on the
  * ovsdb socket. */
 
-static size_t
-_json_callback (void *buffer, size_t buflen, void *user_data)
+static void
+_input_reset (NMOvsdbPrivate *priv)
 {
-	NMOvsdb *self = NM_OVSDB (user_data);
-	NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE (self);
+	g_string_truncate (priv->input, 0);
+	priv->input_scan = 0;
+	priv->input_start = 0;
+	priv->input_depth = 0;
+	priv->input_in_string = FALSE;
+	priv->input_escape = FALSE;
+}
+
+/**
+ * _input_next_message:
+ * @priv: the private data
+ * @out_start: (out): the offset of the message in @priv->input
+ * @out_end: (out): the offset right after the message
+ *
+ * Finds the bounds of the next complete JSON value in the input buffer
+ * by tracking the nesting of objects, arrays and strings. The scan resumes
+ * where the previous call stopped, so each byte is looked at only once, no
+ * matter in how many pieces the message arrives.
+ *
+ * Anything but whitespace between the messages is returned as a message
+ * on its own, for the JSON parser to reject it.
+ *
+ * Returns: %TRUE if a complete message was found.
+ */
+static gboolean
+_input_next_message (NMOvsdbPrivate *priv, gsize *out_start, gsize *out_end)
+{
+	const char *str = priv->input->str;
+	gsize i;
+
+	for (i = priv->input_scan; i < priv->input->len; i++) {
+		const char c = str[i];
+
+		if (priv->input_in_string) {
+			if (priv->input_escape)
+				priv->input_escape = FALSE;
+			else if (c == '\\')
+				priv->input_escape = TRUE;
+			else if (c == '"')
+				priv->input_in_string = FALSE;
+			continue;
+		}
+
+		if (priv->input_depth == 0) {
+			if (g_ascii_isspace (c))
+				continue;
+			priv->input_start = i;
+			if (!NM_IN_SET (c, '{', '[')) {
+				priv->input_scan = i + 1;
+				goto found;
+			}
+		}
 
-	if (priv->bufp == priv->input->len) {
-		/* No more bytes buffered for decoding. */
-		return 0;
+		switch (c) {
+		case '"':
+			priv->input_in_string = TRUE;
+			break;
+		case '{':
+		case '[':
+			priv->input_depth++;
+			break;
+		case '}':
+		case ']':
+			if (--priv->input_depth == 0) {
+				priv->input_scan = i + 1;
+				goto found;
+			}
+			break;
+		}
 	}
 
-	/* Pass one more byte to the JSON decoder. */
-	*(char *)buffer = priv->input->str[priv->bufp];
-	priv->bufp++;
+	priv->input_scan = i;
+	return FALSE;
 
-	return (size_t)1;
+found:
+	*out_start = priv->input_start;
+	*out_end = priv->input_scan;
+	return TRUE;
 }
 
 /**
@@ -1190,15 +1506,26 @@ _json_callback (void *buffer, size_t buflen, void *user_data)
 static void
 ovsdb_read_cb (GObject *source_object, GAsyncResult *res, gpointer user_data)
 {
-	NMOvsdb *self = NM_OVSDB (user_data);
-	NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE (self);
+	NMOvsdb *self;
+	NMOvsdbPrivate *priv;
 	GInputStream *stream = G_INPUT_STREAM (source_object);
 	GError *error = NULL;
 	gssize size;
 	json_t *msg;
 	json_error_t json_error = { 0, };
+	gsize start, end, consumed;
 
 	size = g_input_stream_read_finish (stream, res, &error);
+	if (   size == -1
+	    && g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+		/* we disconnected, possibly during dispose. */
+		g_clear_error (&error);
+		return;
+	}
+
+	self = NM_OVSDB (user_data);
+	priv = NM_OVSDB_GET_PRIVATE (self);
+
 	if (size == -1) {
 		_LOGW ("short read from ovsdb: %s", error->message);
 		g_clear_error (&error);
@@ -1207,21 +1534,31 @@ ovsdb_read_cb (GObject *source_object, GAsyncResult *res, gpointer user_data)
 	}
 
 	g_string_append_len (priv->input, priv->buf, size);
-	do {
-		priv->bufp = 0;
-		/* The callback always eats up only up to a single byte. This makes
-		 * it possible for us to identify complete JSON objects in spite of
-		 * us not knowing the length in advance. */
-		msg = json_load_callback (_json_callback, self, JSON_DISABLE_EOF_CHECK, &json_error);
-		if (msg) {
-			ovsdb_got_msg (self, msg);
-			g_string_erase (priv->input, 0, priv->bufp);
+
+	while (_input_next_message (priv, &start, &end)) {
+		msg = json_loadb (&priv->input->str[start], end - start, 0, &json_error);
+		if (!msg) {
+			_LOGW ("invalid JSON from ovsdb: %s", json_error.text);
+			ovsdb_disconnect (self);
+			return;
 		}
+		ovsdb_got_msg (self, msg);
 		json_decref (msg);
-	} while (msg);
 
-	if (!priv->conn)
-		return;
+		/* The message might have made us disconnect, which also
+		 * resets the input. */
+		if (!priv->conn)
+			return;
+	}
+
+	/* Drop the complete messages and the whitespace following them at once,
+	 * an incomplete message stays where it is until it's complete. */
+	consumed = priv->input_depth > 0 ? priv->input_start : priv->input_scan;
+	if (consumed > 0) {
+		g_string_erase (priv->input, 0, consumed);
+		priv->input_scan -= consumed;
+		priv->input_start -= MIN (priv->input_start, consumed);
+	}
 
 	if (size)
 		ovsdb_read (self);
@@ -1234,19 +1571,28 @@ ovsdb_read (NMOvsdb *self)
 
 	g_input_stream_read_async (g_io_stream_get_input_stream (G_IO_STREAM (priv->conn)),
 	                           priv->buf, sizeof(priv->buf),
-	                           G_PRIORITY_DEFAULT, NULL, ovsdb_read_cb, self);
+	                           G_PRIORITY_DEFAULT, priv->cancellable, ovsdb_read_cb, self);
 }
 
 static void
 ovsdb_write_cb (GObject *source_object, GAsyncResult *res, gpointer user_data)
 {
 	GOutputStream *stream = G_OUTPUT_STREAM (source_object);
-	NMOvsdb *self = NM_OVSDB (user_data);
-	NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE (self);
+	NMOvsdb *self;
+	NMOvsdbPrivate *priv;
 	GError *error = NULL;
 	gssize size;
 
 	size = g_output_stream_write_finish (stream, res, &error);
+	if (   size == -1
+	    && g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+		g_clear_error (&error);
+		return;
+	}
+
+	self = NM_OVSDB (user_data);
+	priv = NM_OVSDB_GET_PRIVATE (self);
+
 	if (size == -1) {
 		_LOGW ("short write to ovsdb: %s", error->message);
 		g_clear_error (&error);
@@ -1277,7 +1623,7 @@ ovsdb_write (NMOvsdb *self)
 
 	g_output_stream_write_async (stream,
 	                             priv->output->str, priv->output->len,
-	                             G_PRIORITY_DEFAULT, NULL, ovsdb_write_cb, self);
+	                             G_PRIORITY_DEFAULT, priv->cancellable, ovsdb_write_cb, self);
 }
 
 /*****************************************************************************/
@@ -1314,9 +1660,9 @@ ovsdb_disconnect (NMOvsdb *self)
 		callback (self, NULL, error, user_data);
 	}
 
-	priv->bufp = 0;
-	g_string_truncate (priv->input, 0);
+	_input_reset (priv);
 	g_string_truncate (priv->output, 0);
+	nm_clear_g_cancellable (&priv->cancellable);
 	g_clear_object (&priv->client);
 	g_clear_object (&priv->conn);
 	g_clear_pointer (&priv->db_uuid, g_free);
@@ -1344,24 +1690,31 @@ static void
 _client_connect_cb (GObject *source_object, GAsyncResult *res, gpointer user_data)
 {
 	GSocketClient *client = G_SOCKET_CLIENT (source_object);
-	NMOvsdb *self = NM_OVSDB (user_data);
+	NMOvsdb *self;
 	NMOvsdbPrivate *priv;
 	GError *error = NULL;
 	GSocketConnection *conn;
 
 	conn = g_socket_client_connect_finish (client, res, &error);
-	if (conn == NULL) {
-		if (!g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
-			_LOGI ("%s", error->message);
+	if (   !conn
+	    && g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+		g_clear_error (&error);
+		return;
+	}
+
+	self = NM_OVSDB (user_data);
 
+	if (!conn) {
+		_LOGI ("%s", error->message);
 		ovsdb_disconnect (self);
 		g_clear_error (&error);
 		return;
 	}
 
+	/* the cancellable stays around for reading and writing until
+	 * we disconnect. */
 	priv = NM_OVSDB_GET_PRIVATE (self);
 	priv->conn = conn;
-	g_clear_object (&priv->cancellable);
 
 	ovsdb_read (self);
 	ovsdb_next_command (self);
@@ -1384,7 +1737,7 @@ ovsdb_try_connect (NMOvsdb *self)
 		return;
 
 	/* XXX: This should probably be made configurable via NetworkManager.conf */
-	addr = g_unix_socket_address_new (RUNSTATEDIR "/openvswitch/db.sock");
+	addr = g_unix_socket_address_new (priv->socket_path ?: RUNSTATEDIR "/openvswitch/db.sock");
 
 	priv->client = g_socket_client_new ();
 	priv->cancellable = g_cancellable_new ();
@@ -1412,23 +1765,10 @@ static void
 _transact_cb (NMOvsdb *self, json_t *result, GError *error, gpointer user_data)
 {
 	OvsdbCall *call = user_data;
-	const char *err;
-	const char *err_details;
-	size_t index;
-	json_t *value;
 
-	if (error)
-		goto out;
+	if (!error)
+		_transact_result_get_error (result, &error);
 
-	json_array_foreach (result, index, value) {
-		if (json_unpack (value, "{s:s, s:s}", "error", &err, "details", &err_details) == 0) {
-			g_set_error (&error, G_IO_ERROR, G_IO_ERROR_FAILED,
-			             "Error running the transaction: %s: %s", err, err_details);
-			goto out;
-		}
-	}
-
-out:
 	call->callback (error, call->user_data);
 	g_slice_free (OvsdbCall, call);
 }
@@ -1528,8 +1868,31 @@ nm_ovsdb_init (NMOvsdb *self)
 	priv->bridges = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, _free_bridge);
 	priv->ports = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, _free_port);
 	priv->interfaces = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, _free_interface);
+}
 
-	ovsdb_try_connect (self);
+static void
+set_property (GObject *object, guint prop_id,
+              const GValue *value, GParamSpec *pspec)
+{
+	NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE ((NMOvsdb *) object);
+
+	switch (prop_id) {
+	case PROP_SOCKET_PATH:
+		/* construct-only */
+		priv->socket_path = g_value_dup_string (value);
+		break;
+	default:
+		G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+		break;
+	}
+}
+
+static void
+constructed (GObject *object)
+{
+	G_OBJECT_CLASS (nm_ovsdb_parent_class)->constructed (object);
+
+	ovsdb_try_connect (NM_OVSDB (object));
 }
 
 static void
@@ -1554,18 +1917,37 @@ dispose (GObject *object)
 	g_clear_pointer (&priv->ports, g_hash_table_destroy);
 	g_clear_pointer (&priv->interfaces, g_hash_table_destroy);
 
-	g_cancellable_cancel (priv->cancellable);
-	g_clear_object (&priv->cancellable);
-
 	G_OBJECT_CLASS (nm_ovsdb_parent_class)->dispose (object);
 }
 
+static void
+finalize (GObject *object)
+{
+	NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE ((NMOvsdb *) object);
+
+	g_free (priv->socket_path);
+
+	G_OBJECT_CLASS (nm_ovsdb_parent_class)->finalize (object);
+}
+
 static void
 nm_ovsdb_class_init (NMOvsdbClass *klass)
 {
 	GObjectClass *object_class = G_OBJECT_CLASS (klass);
 
+	object_class->set_property = set_property;
+	object_class->constructed = constructed;
 	object_class->dispose = dispose;
+	object_class->finalize = finalize;
+
+	obj_properties[PROP_SOCKET_PATH] =
+	    g_param_spec_string (NM_OVSDB_SOCKET_PATH, "", "",
+	                         NULL,
+	                         G_PARAM_WRITABLE |
+	                         G_PARAM_CONSTRUCT_ONLY |
+	                         G_PARAM_STATIC_STRINGS);
+
+	g_object_class_install_properties (object_class, _PROPERTY_ENUMS_LAST, obj_properties);
 
 	signals[DEVICE_ADDED] =
 		g_signal_new (NM_OVSDB_DEVICE_ADDED,
@@ -0,0 +1,486 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Copyright 2018 Red Hat, Inc.
+ */
+
+#include "nm-default.h"
+
+#include <gio/gunixsocketaddress.h>
+
+#include "nm-utils/nm-jansson.h"
+#include "nm-dbus-interface.h"
+#include "nm-core-internal.h"
+#include "devices/ovs/nm-ovsdb.h"
+
+#include "nm-test-utils-core.h"
+
+/*****************************************************************************/
+
+/* A stand-in for ovsdb-server on a unix socket. It answers the initial
+ * "monitor" call with a generated dump of @n_ports ports, each with an
+ * internal interface, on one bridge. In batch mode it starts with an empty
+ * database and acknowledges transactions until @n_expected interfaces
+ * were inserted. */
+
+typedef struct {
+	GSocketService *service;
+	char *dir;
+	char *path;
+	guint n_ports;
+
+	/* batch mode */
+	guint n_expected;
+	gboolean fail_batch;
+	int n_transacts;
+	int n_bridge_inserts;
+	int n_port_inserts;
+	int n_interface_inserts;
+} TestServer;
+
+static void
+_dump_uuid (GString *str, char kind, guint idx)
+{
+	g_string_append_printf (str, "\"%c%07x-0000-4000-8000-000000000000\"", kind, idx);
+}
+
+static GString *
+_dump_generate (guint n_ports, gint64 id)
+{
+	GString *str = g_string_sized_new (n_ports * 300);
+	guint i;
+
+	g_string_append_printf (str, "{\"id\":%" G_GINT64_FORMAT ",\"error\":null,\"result\":{", id);
+	g_string_append (str, "\"Open_vSwitch\":{\"0dd1ec78-4e1c-4d1b-9b4e-0f6fdaf7a3c8\":{\"new\":{}}},");
+
+	g_string_append (str, "\"Interface\":{");
+	for (i = 0; i < n_ports; i++) {
+		if (i)
+			g_string_append_c (str, ',');
+		_dump_uuid (str, 'a', i);
+		g_string_append_printf (str,
+		                        ":{\"new\":{\"name\":\"iface%u\",\"type\":\"internal\","
+		                        "\"external_ids\":[\"map\",[[\"note\",\"{[\\\"%u\\\\\\\"]}\"]]]}}",
+		                        i, i);
+	}
+
+	g_string_append (str, "},\"Port\":{");
+	for (i = 0; i < n_ports; i++) {
+		if (i)
+			g_string_append_c (str, ',');
+		_dump_uuid (str, 'b', i);
+		g_string_append_printf (str, ":{\"new\":{\"name\":\"port%u\",\"interfaces\":[\"uuid\",", i);
+		_dump_uuid (str, 'a', i);
+		g_string_append (str, "],\"external_ids\":[\"map\",[]]}}");
+	}
+
+	g_string_append (str, "},\"Bridge\":{");
+	_dump_uuid (str, 'c', 0);
+	g_string_append (str, ":{\"new\":{\"name\":\"br0\",\"ports\":[\"set\",[");
+	for (i = 0; i < n_ports; i++) {
+		if (i)
+			g_string_append_c (str, ',');
+		g_string_append (str, "[\"uuid\",");
+		_dump_uuid (str, 'b', i);
+		g_string_append_c (str, ']');
+	}
+	g_string_append (str, "]],\"external_ids\":[\"map\",[]]}}}}}");
+
+	/* an update right after the reply, with no separator. */
+	g_string_append (str,
+	                 "{\"id\":null,\"method\":\"update\",\"params\":[null,{\"Interface\":{");
+	_dump_uuid (str, 'a', n_ports);
+	g_string_append (str,
+	                 ":{\"new\":{\"name\":\"x{\\\"]\",\"type\":\"internal\","
+	                 "\"external_ids\":[\"map\",[]]}}}}]}\n");
+
+	return str;
+}
+
+static gboolean
+_server_run_cb (GThreadedSocketService *service,
+                GSocketConnection *connection,
+                GObject *source_object,
+                gpointer user_data)
+{
+	TestServer *server = user_data;
+	GInputStream *in = g_io_stream_get_input_stream (G_IO_STREAM (connection));
+	GOutputStream *out = g_io_stream_get_output_stream (G_IO_STREAM (connection));
+	nm_auto_free_gstring GString *request = g_string_new (NULL);
+	nm_auto_free_gstring GString *dump = NULL;
+	json_t *msg = NULL;
+	json_error_t json_error;
+	char buf[4096];
+	gssize n;
+	gsize pos, chunk;
+	guint i;
+
+	/* the monitor call. */
+	while (!msg) {
+		n = g_input_stream_read (in, buf, sizeof (buf), NULL, NULL);
+		if (n <= 0)
+			return TRUE;
+		g_string_append_len (request, buf, n);
+		msg = json_loadb (request->str, request->len, JSON_DISABLE_EOF_CHECK, &json_error);
+	}
+	g_assert_cmpstr (json_string_value (json_object_get (msg, "method")), ==, "monitor");
+	dump = _dump_generate (server->n_ports, json_integer_value (json_object_get (msg, "id")));
+	json_decref (msg);
+
+	/* write it in pieces of odd sizes, so that the messages are split
+	 * at arbitrary places. */
+	for (pos = 0, i = 0; pos < dump->len; pos += chunk, i++) {
+		chunk = MIN ((gsize) (1 + (i * 7919) % 9001), dump->len - pos);
+		g_assert (g_output_stream_write_all (out, &dump->str[pos], chunk, NULL, NULL, NULL));
+	}
+
+	/* we are done. The client stops reading at the end of the stream. */
+	g_io_stream_close (G_IO_STREAM (connection), NULL, NULL);
+	return TRUE;
+}
+
+static GString *
+_server_batch_reply (TestServer *server, json_t *msg, gboolean *fail, guint *n_done)
+{
+	const char *method = json_string_value (json_object_get (msg, "method"));
+	gint64 id = json_integer_value (json_object_get (msg, "id"));
+	json_t *params = json_object_get (msg, "params");
+	json_t *result;
+	json_t *op;
+	json_t *reply;
+	GString *str;
+	char *dump;
+	const char *table;
+	guint n_bridges = 0, n_ports = 0, n_interfaces = 0;
+	size_t i;
+
+	if (nm_streq0 (method, "monitor")) {
+		reply = json_pack ("{s:I, s:n, s:{s:{s:{s:{}}}}}",
+		                   "id", (json_int_t) id, "error",
+		                   "result", "Open_vSwitch", "0dd1ec78-4e1c-4d1b-9b4e-0f6fdaf7a3c8", "new");
+		goto out;
+	}
+
+	g_assert_cmpstr (method, ==, "transact");
+	g_assert_cmpstr (json_string_value (json_array_get (params, 0)), ==, "Open_vSwitch");
+
+	result = json_array ();
+	json_array_foreach (params, i, op) {
+		if (i == 0)
+			continue;
+		json_array_append_new (result, json_object ());
+		if (!nm_streq0 (json_string_value (json_object_get (op, "op")), "insert"))
+			continue;
+		table = json_string_value (json_object_get (op, "table"));
+		if (nm_streq0 (table, "Bridge"))
+			n_bridges++;
+		else if (nm_streq0 (table, "Port"))
+			n_ports++;
+		else if (nm_streq0 (table, "Interface"))
+			n_interfaces++;
+	}
+
+	g_atomic_int_inc (&server->n_transacts);
+
+	if (*fail && n_interfaces > 1) {
+		/* fail the first merged transaction. */
+		*fail = FALSE;
+		json_array_append_new (result, json_pack ("{s:s, s:s}",
+		                                          "error", "constraint violation",
+		                                          "details", "test"));
+	} else {
+		g_atomic_int_add (&server->n_bridge_inserts, n_bridges);
+		g_atomic_int_add (&server->n_port_inserts, n_ports);
+		g_atomic_int_add (&server->n_interface_inserts, n_interfaces);
+		*n_done += n_interfaces;
+	}
+
+	reply = json_pack ("{s:I, s:n, s:o}", "id", (json_int_t) id, "error", "result", result);
+
+out:
+	dump = json_dumps (reply, 0);
+	str = g_string_new (dump);
+	free (dump);
+	json_decref (reply);
+	return str;
+}
+
+static gboolean
+_server_batch_run_cb (GThreadedSocketService *service,
+                      GSocketConnection *connection,
+                      GObject *source_object,
+                      gpointer user_data)
+{
+	TestServer *server = user_data;
+	GInputStream *in = g_io_stream_get_input_stream (G_IO_STREAM (connection));
+	GOutputStream *out = g_io_stream_get_output_stream (G_IO_STREAM (connection));
+	nm_auto_free_gstring GString *request = g_string_new (NULL);
+	const guint n_expected = server->n_expected;
+	gboolean fail = server->fail_batch;
+	guint n_done = 0;
+	json_t *msg;
+	json_error_t json_error;
+	char buf[4096];
+	gssize n;
+
+	while (n_done < n_expected) {
+		n = g_input_stream_read (in, buf, sizeof (buf), NULL, NULL);
+		if (n <= 0)
+			return TRUE;
+		g_string_append_len (request, buf, n);
+
+		/* with JSON_DISABLE_EOF_CHECK, the position is the length of the
+		 * decoded message. */
+		while ((msg = json_loadb (request->str, request->len, JSON_DISABLE_EOF_CHECK, &json_error))) {
+			nm_auto_free_gstring GString *reply = NULL;
+
+			g_string_erase (request, 0, json_error.position);
+			reply = _server_batch_reply (server, msg, &fail, &n_done);
+			json_decref (msg);
+			g_assert (g_output_stream_write_all (out, reply->str, reply->len, NULL, NULL, NULL));
+		}
+	}
+
+	g_io_stream_close (G_IO_STREAM (connection), NULL, NULL);
+	return TRUE;
+}
+
+static void
+_server_start (TestServer *server, guint n_ports, GCallback run_cb)
+{
+	gs_unref_object GSocketAddress *addr = NULL;
+	GError *error = NULL;
+
+	server->n_ports = n_ports;
+	server->dir = g_dir_make_tmp ("nm-test-ovsdb-XXXXXX", &error);
+	g_assert_no_error (error);
+	server->path = g_build_filename (server->dir, "db.sock", NULL);
+
+	server->service = g_threaded_socket_service_new (1);
+	g_signal_connect (server->service, "run", run_cb, server);
+	addr = g_unix_socket_address_new (server->path);
+	g_socket_listener_add_address (G_SOCKET_LISTENER (server->service), addr,
+	                               G_SOCKET_TYPE_STREAM, G_SOCKET_PROTOCOL_DEFAULT,
+	                               NULL, NULL, &error);
+	g_assert_no_error (error);
+	g_socket_service_start (server->service);
+}
+
+static void
+_server_stop (TestServer *server)
+{
+	g_socket_service_stop (server->service);
+	g_socket_listener_close (G_SOCKET_LISTENER (server->service));
+	g_clear_object (&server->service);
+	unlink (server->path);
+	rmdir (server->dir);
+	g_clear_pointer (&server->path, g_free);
+	g_clear_pointer (&server->dir, g_free);
+}
+
+/*****************************************************************************/
+
+typedef struct {
+	GMainLoop *loop;
+	guint n_interfaces;
+	guint n_ports;
+	guint n_bridges;
+	guint n_expected;
+	gboolean got_odd_name;
+} TestData;
+
+static void
+_device_added_cb (NMOvsdb *ovsdb, const char *name, guint device_type, TestData *data)
+{
+	switch (device_type) {
+	case NM_DEVICE_TYPE_OVS_INTERFACE:
+		if (nm_streq (name, "x{\"]"))
+			data->got_odd_name = TRUE;
+		data->n_interfaces++;
+		break;
+	case NM_DEVICE_TYPE_OVS_PORT:
+		data->n_ports++;
+		break;
+	case NM_DEVICE_TYPE_OVS_BRIDGE:
+		data->n_bridges++;
+		break;
+	default:
+		g_assert_not_reached ();
+	}
+
+	if (data->n_interfaces + data->n_ports + data->n_bridges == data->n_expected)
+		g_main_loop_quit (data->loop);
+}
+
+static void
+test_monitor_dump (gconstpointer user_data)
+{
+	guint n_ports = GPOINTER_TO_UINT (user_data);
+	TestServer server = { };
+	TestData data = { };
+	gs_unref_object NMOvsdb *ovsdb = NULL;
+	gint64 start_time;
+
+	if (n_ports > 1000 && nmtst_test_quick ()) {
+		g_print ("Skipping test: don't run long running test %s (NMTST_DEBUG=slow)\n", g_get_prgname () ?: "test-ovsdb");
+		g_test_skip ("Skip long running test");
+		return;
+	}
+
+	_server_start (&server, n_ports, G_CALLBACK (_server_run_cb));
+
+	data.loop = g_main_loop_new (NULL, FALSE);
+	data.n_expected = 2 * n_ports + 1 + 1;
+
+	start_time = nm_utils_get_monotonic_timestamp_ns ();
+
+	ovsdb = g_object_new (NM_TYPE_OVSDB,
+	                      NM_OVSDB_SOCKET_PATH, server.path,
+	                      NULL);
+	g_signal_connect (ovsdb, NM_OVSDB_DEVICE_ADDED, G_CALLBACK (_device_added_cb), &data);
+
+	if (nmtst_main_loop_run (data.loop, 60000))
+		g_assert_not_reached ();
+
+	g_test_message ("processed a monitor dump of %u ports in %.3f seconds",
+	                n_ports,
+	                (double) (nm_utils_get_monotonic_timestamp_ns () - start_time) / NM_UTILS_NS_PER_SECOND);
+
+	g_assert_cmpint (data.n_interfaces, ==, n_ports + 1);
+	g_assert_cmpint (data.n_ports, ==, n_ports);
+	g_assert_cmpint (data.n_bridges, ==, 1);
+	g_assert (data.got_odd_name);
+
+	g_clear_object (&ovsdb);
+	_server_stop (&server);
+	g_main_loop_unref (data.loop);
+}
+
+/*****************************************************************************/
+
+typedef struct {
+	GMainLoop *loop;
+	guint n_pending;
+	guint n_failed;
+} TestBatchData;
+
+static void
+_add_interface_cb (GError *error, gpointer user_data)
+{
+	TestBatchData *data = user_data;
+
+	if (error) {
+		g_test_message ("add interface failed: %s", error->message);
+		data->n_failed++;
+		g_error_free (error);
+	}
+
+	g_assert_cmpint (data->n_pending, >, 0);
+	if (--data->n_pending == 0)
+		g_main_loop_quit (data->loop);
+}
+
+static NMConnection *
+_create_connection (const char *type, const char *ifname)
+{
+	NMConnection *connection;
+	NMSettingConnection *s_con;
+
+	connection = nmtst_create_minimal_connection (ifname, NULL, type, &s_con);
+	g_object_set (s_con,
+	              NM_SETTING_CONNECTION_INTERFACE_NAME, ifname,
+	              NULL);
+	return connection;
+}
+
+static void
+test_batch (gconstpointer user_data)
+{
+	const guint n_interfaces = GPOINTER_TO_UINT (user_data) & 0xFFFF;
+	const gboolean fail_batch = !!(GPOINTER_TO_UINT (user_data) & 0x10000);
+	TestServer server = { };
+	TestBatchData data = { };
+	gs_unref_object NMOvsdb *ovsdb = NULL;
+	gs_unref_object NMConnection *bridge = NULL;
+	gs_unref_ptrarray GPtrArray *connections = NULL;
+	guint i;
+
+	server.n_expected = n_interfaces;
+	server.fail_batch = fail_batch;
+	_server_start (&server, 0, G_CALLBACK (_server_batch_run_cb));
+
+	data.loop = g_main_loop_new (NULL, FALSE);
+	data.n_pending = n_interfaces;
+
+	ovsdb = g_object_new (NM_TYPE_OVSDB,
+	                      NM_OVSDB_SOCKET_PATH, server.path,
+	                      NULL);
+
+	/* all the calls are queued behind the initial monitor call. Once it
+	 * completes, they are sent together. */
+	bridge = _create_connection (NM_SETTING_OVS_BRIDGE_SETTING_NAME, "br0");
+	connections = g_ptr_array_new_with_free_func (g_object_unref);
+	for (i = 0; i < n_interfaces; i++) {
+		char ifname[32];
+		NMConnection *port;
+		NMConnection *interface;
+
+		nm_sprintf_buf (ifname, "port%u", i);
+		port = _create_connection (NM_SETTING_OVS_PORT_SETTING_NAME, ifname);
+		g_ptr_array_add (connections, port);
+
+		nm_sprintf_buf (ifname, "iface%u", i);
+		interface = _create_connection (NM_SETTING_OVS_INTERFACE_SETTING_NAME, ifname);
+		g_ptr_array_add (connections, interface);
+
+		nm_ovsdb_add_interface (ovsdb, bridge, port, interface, _add_interface_cb, &data);
+	}
+
+	if (nmtst_main_loop_run (data.loop, 10000))
+		g_assert_not_reached ();
+
+	g_assert_cmpint (data.n_failed, ==, 0);
+	g_assert_cmpint (g_atomic_int_get (&server.n_interface_inserts), ==, n_interfaces);
+	g_assert_cmpint (g_atomic_int_get (&server.n_port_inserts), ==, n_interfaces);
+	if (fail_batch) {
+		/* the merged transaction fails and each call is retried alone. */
+		g_assert_cmpint (g_atomic_int_get (&server.n_transacts), ==, 1 + n_interfaces);
+	} else {
+		g_assert_cmpint (g_atomic_int_get (&server.n_transacts), ==, 1);
+		g_assert_cmpint (g_atomic_int_get (&server.n_bridge_inserts), ==, 1);
+	}
+
+	g_clear_object (&ovsdb);
+	_server_stop (&server);
+	g_main_loop_unref (data.loop);
+}
+
+/*****************************************************************************/
+
+NMTST_DEFINE ();
+
+int
+main (int argc, char **argv)
+{
+	nmtst_init_assert_logging (&argc, &argv, "INFO", "DEFAULT");
+
+	g_test_add_data_func ("/ovsdb/monitor-dump/10", GUINT_TO_POINTER (10), test_monitor_dump);
+	g_test_add_data_func ("/ovsdb/monitor-dump/20000", GUINT_TO_POINTER (20000), test_monitor_dump);
+	g_test_add_data_func ("/ovsdb/batch/200", GUINT_TO_POINTER (200), test_batch);
+	g_test_add_data_func ("/ovsdb/batch-fallback/20", GUINT_TO_POINTER (0x10000 | 20), test_batch);
+
+	return g_test_run ();
+}
@@ -433,6 +433,141 @@ test_recv (TestRecvFixture *fixture, gconstpointer user_data)
 	g_clear_pointer (&loop, g_main_loop_unref);
 }
 
+#define TEST_RECV_MANY_N_PORTS 48
+
+static gsize
+_test_recv_many_frame (guint8 *buf, guint port)
+{
+	static const guint8 head[] = {
+		/* Ethernet header */
+		0x01, 0x80, 0xc2, 0x00, 0x00, 0x0e,     /* Destination MAC */
+		0x01, 0x02, 0x03, 0x04, 0x05, 0x06,     /* Source MAC */
+		0x88, 0xcc,                             /* Ethertype */
+		/* LLDP mandatory TLVs */
+		0x02, 0x07, 0x04, 0x00, 0x01, 0x02,     /* Chassis: MAC, 00:01:02:03:04:05 */
+		0x03, 0x04, 0x05,
+	};
+	static const guint8 tail[] = {
+		0x06, 0x02, 0x00, 0x78,                 /* TTL: 120 seconds */
+		0x0a, 0x03, 0x53, 0x59, 0x53,           /* System Name: "SYS" */
+		0x00, 0x00                              /* End Of LLDPDU */
+	};
+	char port_id[16];
+	gsize len = 0, port_id_len;
+
+	port_id_len = strlen (nm_sprintf_buf (port_id, "1/%u", port));
+
+	memcpy (&buf[len], head, sizeof (head));
+	len += sizeof (head);
+
+	/* Port: interface name */
+	buf[len++] = 0x04;
+	buf[len++] = 1 + port_id_len;
+	buf[len++] = 0x05;
+	memcpy (&buf[len], port_id, port_id_len);
+	len += port_id_len;
+
+	memcpy (&buf[len], tail, sizeof (tail));
+	len += sizeof (tail);
+	return len;
+}
+
+static void
+_test_recv_many_send (TestRecvFixture *fixture)
+{
+	guint8 buf[100];
+	gsize len;
+	guint port;
+
+	for (port = 1; port <= TEST_RECV_MANY_N_PORTS; port++) {
+		len = _test_recv_many_frame (buf, port);
+		g_assert (write (fixture->fd, buf, len) == len);
+	}
+}
+
+static void
+test_recv_many (TestRecvFixture *fixture, gconstpointer user_data)
+{
+	guint n_rounds = GPOINTER_TO_UINT (user_data);
+	gs_unref_object NMLldpListener *listener = NULL;
+	GMainLoop *loop;
+	TestRecvCallbackInfo info = { };
+	GVariant *neighbors;
+	GVariantIter iter;
+	GVariant *neighbor;
+	gs_free char *port_id_prev = NULL;
+	gulong notify_id;
+	GError *error = NULL;
+	guint sd_id;
+	guint i;
+	gint64 start_time;
+
+	if (fixture->ifindex == 0) {
+		g_test_skip ("Tun device not available");
+		return;
+	}
+
+	if (n_rounds > 10 && nmtst_test_quick ()) {
+		g_print ("Skipping test: don't run long running test %s (NMTST_DEBUG=slow)\n", g_get_prgname () ?: "test-lldp");
+		g_test_skip ("Skip long running test");
+		return;
+	}
+
+	listener = nm_lldp_listener_new ();
+	g_assert (listener != NULL);
+	g_assert (nm_lldp_listener_start (listener, fixture->ifindex, &error));
+	g_assert_no_error (error);
+
+	notify_id = g_signal_connect (listener, "notify::" NM_LLDP_LISTENER_NEIGHBORS,
+	                              (GCallback) lldp_neighbors_changed, &info);
+	loop = g_main_loop_new (NULL, FALSE);
+	sd_id = nm_sd_event_attach_default ();
+
+	/* the first change is announced right away, the others are
+	 * rate limited and follow after 2 seconds. */
+	_test_recv_many_send (fixture);
+	if (nmtst_main_loop_run (loop, 2500))
+		g_assert_not_reached ();
+	g_assert_cmpint (info.num_called, ==, 2);
+
+	neighbors = nm_lldp_listener_get_neighbors (listener);
+	nmtst_assert_variant_is_of_type (neighbors, G_VARIANT_TYPE ("aa{sv}"));
+	g_assert_cmpint (g_variant_n_children (neighbors), ==, TEST_RECV_MANY_N_PORTS);
+
+	/* the neighbors are sorted by their ID. */
+	g_variant_iter_init (&iter, neighbors);
+	while (g_variant_iter_next (&iter, "@a{sv}", &neighbor)) {
+		char *port_id = NULL;
+
+		g_assert (g_variant_lookup (neighbor, NM_LLDP_ATTR_PORT_ID, "s", &port_id));
+		g_assert (g_strcmp0 (port_id_prev, port_id) < 0);
+		g_free (port_id_prev);
+		port_id_prev = port_id;
+		g_variant_unref (neighbor);
+	}
+
+	/* resending the same data must neither signal a change nor
+	 * rebuild the neighbors. */
+	start_time = nm_utils_get_monotonic_timestamp_ns ();
+	for (i = 0; i < n_rounds; i++) {
+		_test_recv_many_send (fixture);
+		if (nmtst_main_loop_run (loop, 50))
+			g_assert_not_reached ();
+	}
+	if (nmtst_main_loop_run (loop, 2500))
+		g_assert_not_reached ();
+	_LOGI (">>> processed %u rounds of %u frames in %.3f seconds (including idle waits)",
+	       n_rounds, (guint) TEST_RECV_MANY_N_PORTS,
+	       (double) (nm_utils_get_monotonic_timestamp_ns () - start_time) / NM_UTILS_NS_PER_SECOND);
+
+	g_assert_cmpint (info.num_called, ==, 2);
+	g_assert (neighbors == nm_lldp_listener_get_neighbors (listener));
+
+	nm_clear_g_signal_handler (listener, &notify_id);
+	nm_clear_g_source (&sd_id);
+	g_clear_pointer (&loop, g_main_loop_unref);
+}
+
 static void
 _test_recv_fixture_teardown (TestRecvFixture *fixture, gconstpointer user_data)
 {
@@ -459,4 +594,7 @@ _nmtstp_setup_tests (void)
 	_TEST_ADD_RECV ("/lldp/recv/0_twice", &_test_recv_data0_twice);
 	_TEST_ADD_RECV ("/lldp/recv/1",       &_test_recv_data1);
 	_TEST_ADD_RECV ("/lldp/recv/2_ttl1",  &_test_recv_data2_ttl1);
+
+	g_test_add ("/lldp/recv/many/1", TestRecvFixture, GUINT_TO_POINTER (1), _test_recv_fixture_setup, test_recv_many, _test_recv_fixture_teardown);
+	g_test_add ("/lldp/recv/many/100", TestRecvFixture, GUINT_TO_POINTER (100), _test_recv_fixture_setup, test_recv_many, _test_recv_fixture_teardown);
 }
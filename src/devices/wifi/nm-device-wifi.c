@@ -88,6 +88,8 @@ typedef struct {
 	gint8             invalid_strength_counter;
 
 	GHashTable *      aps;
+	GPtrArray *       aps_sorted;   /* the APs of @aps, sorted by their id */
+	const char **     aps_paths;    /* cached export paths of @aps_sorted */
 	NMWifiAP *        current_ap;
 	guint32           rate;
 	bool              enabled:1; /* rfkilled or not */
@@ -480,6 +482,25 @@ periodic_update_cb (gpointer user_data)
 	return TRUE;
 }
 
+static int
+ap_id_cmp_with_data (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+	guint64 a_id = nm_wifi_ap_get_id ((NMWifiAP *) a);
+	guint64 b_id = nm_wifi_ap_get_id ((NMWifiAP *) b);
+
+	return a_id < b_id ? -1 : (a_id == b_id ? 0 : 1);
+}
+
+static gssize
+_aps_sorted_find (NMDeviceWifiPrivate *priv, NMWifiAP *ap)
+{
+	return _nm_utils_ptrarray_find_binary_search ((gconstpointer *) priv->aps_sorted->pdata,
+	                                              priv->aps_sorted->len,
+	                                              ap,
+	                                              ap_id_cmp_with_data,
+	                                              NULL);
+}
+
 static void
 ap_add_remove (NMDeviceWifi *self,
                guint signum,
@@ -487,6 +508,7 @@ ap_add_remove (NMDeviceWifi *self,
                gboolean recheck_available_connections)
 {
 	NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE (self);
+	gssize idx;
 
 	nm_assert (NM_IN_SET (signum, ACCESS_POINT_ADDED, ACCESS_POINT_REMOVED));
 
@@ -494,6 +516,13 @@ ap_add_remove (NMDeviceWifi *self,
 		g_hash_table_insert (priv->aps,
 		                     (gpointer) nm_exported_object_export ((NMExportedObject *) ap),
 		                     g_object_ref (ap));
+
+		/* new APs get increasing ids, so this usually appends. */
+		idx = _aps_sorted_find (priv, ap);
+		nm_assert (idx < 0);
+		g_ptr_array_insert (priv->aps_sorted, ~idx, ap);
+		g_clear_pointer (&priv->aps_paths, g_free);
+
 		_ap_dump (self, LOGL_DEBUG, ap, "added", 0);
 	} else
 		_ap_dump (self, LOGL_DEBUG, ap, "removed", 0);
@@ -501,6 +530,11 @@ ap_add_remove (NMDeviceWifi *self,
 	g_signal_emit (self, signals[signum], 0, ap);
 
 	if (signum == ACCESS_POINT_REMOVED) {
+		idx = _aps_sorted_find (priv, ap);
+		nm_assert (idx >= 0);
+		g_ptr_array_remove_index (priv->aps_sorted, idx);
+		g_clear_pointer (&priv->aps_paths, g_free);
+
 		g_hash_table_remove (priv->aps, nm_exported_object_get_path ((NMExportedObject *) ap));
 		nm_exported_object_unexport ((NMExportedObject *) ap);
 		g_object_unref (ap);
@@ -1048,78 +1082,49 @@ can_auto_connect (NMDevice *device,
 	return FALSE;
 }
 
-static int
-ap_id_compare (gconstpointer p_a, gconstpointer p_b, gpointer user_data)
-{
-	guint64 a_id = nm_wifi_ap_get_id (*((NMWifiAP **) p_a));
-	guint64 b_id = nm_wifi_ap_get_id (*((NMWifiAP **) p_b));
-
-	return a_id < b_id ? -1 : (a_id == b_id ? 0 : 1);
-}
-
-static NMWifiAP **
-ap_list_get_sorted (NMDeviceWifi *self, gboolean include_without_ssid)
+/**
+ * ap_list_get_paths:
+ * @self: the #NMDeviceWifi
+ *
+ * Returns: (transfer none): the %NULL terminated export paths of all APs,
+ *   sorted by their id. The list stays valid until an AP is added
+ *   or removed.
+ */
+static const char *const*
+ap_list_get_paths (NMDeviceWifi *self)
 {
-	NMDeviceWifiPrivate *priv;
-	NMWifiAP **list;
-	GHashTableIter iter;
-	NMWifiAP *ap;
-	gsize i, n;
-
-	priv = NM_DEVICE_WIFI_GET_PRIVATE (self);
+	NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE (self);
+	guint i;
 
-	n = g_hash_table_size (priv->aps);
-	list = g_new (NMWifiAP *, n + 1);
-
-	i = 0;
-	if (n > 0) {
-		g_hash_table_iter_init (&iter, priv->aps);
-		while (g_hash_table_iter_next (&iter, NULL, (gpointer) &ap)) {
-			nm_assert (i < n);
-			if (   include_without_ssid
-			    || nm_wifi_ap_get_ssid (ap))
-				list[i++] = ap;
+	if (!priv->aps_paths) {
+		priv->aps_paths = g_new (const char *, priv->aps_sorted->len + 1);
+		for (i = 0; i < priv->aps_sorted->len; i++) {
+			priv->aps_paths[i] = nm_exported_object_get_path (priv->aps_sorted->pdata[i]);
+			nm_assert (priv->aps_paths[i]);
 		}
-		nm_assert (i <= n);
-		nm_assert (!include_without_ssid || i == n);
-
-		g_qsort_with_data (list,
-		                   i,
-		                   sizeof (gpointer),
-		                   ap_id_compare,
-		                   NULL);
-	}
-	list[i] = NULL;
-	return list;
-}
-
-static const char **
-ap_list_get_sorted_paths (NMDeviceWifi *self, gboolean include_without_ssid)
-{
-	gpointer *list;
-	gsize i, j;
-
-	list = (gpointer *) ap_list_get_sorted (self, include_without_ssid);
-	for (i = 0, j = 0; list[i]; i++) {
-		NMWifiAP *ap = list[i];
-		const char *path;
-
-		/* update @list inplace to hold instead the export-path. */
-		path = nm_exported_object_get_path (NM_EXPORTED_OBJECT (ap));
-		nm_assert (path);
-		list[j++] = (gpointer) path;
+		priv->aps_paths[i] = NULL;
 	}
-	return (const char **) list;
+	return priv->aps_paths;
 }
 
 static void
 impl_device_wifi_get_access_points (NMDeviceWifi *self,
                                     GDBusMethodInvocation *context)
 {
+	NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE (self);
 	gs_free const char **list = NULL;
 	GVariant *v;
+	guint i, n;
+
+	list = g_new (const char *, priv->aps_sorted->len + 1);
+	for (i = 0, n = 0; i < priv->aps_sorted->len; i++) {
+		NMWifiAP *ap = priv->aps_sorted->pdata[i];
+
+		if (nm_wifi_ap_get_ssid (ap))
+			list[n++] = nm_exported_object_get_path (NM_EXPORTED_OBJECT (ap));
+	}
+	list[n] = NULL;
 
-	list = ap_list_get_sorted_paths (self, FALSE);
 	v = g_variant_new_objv (list, -1);
 	g_dbus_method_invocation_return_value (context, g_variant_new_tuple (&v, 1));
 }
@@ -1128,11 +1133,9 @@ static void
 impl_device_wifi_get_all_access_points (NMDeviceWifi *self,
                                         GDBusMethodInvocation *context)
 {
-	gs_free const char **list = NULL;
 	GVariant *v;
 
-	list = ap_list_get_sorted_paths (self, TRUE);
-	v = g_variant_new_objv (list, -1);
+	v = g_variant_new_objv (ap_list_get_paths (self), -1);
 	g_dbus_method_invocation_return_value (context, g_variant_new_tuple (&v, 1));
 }
 
@@ -1608,17 +1611,15 @@ ap_list_dump (gpointer user_data)
 	priv->ap_dump_id = 0;
 
 	if (_LOGD_ENABLED (LOGD_WIFI_SCAN)) {
-		gs_free NMWifiAP **list = NULL;
-		gsize i;
+		guint i;
 		gint32 now_s = nm_utils_get_monotonic_timestamp_s ();
 
 		_LOGD (LOGD_WIFI_SCAN, "APs: [now:%u last:%u next:%u]",
 		       now_s,
 		       priv->last_scan,
 		       priv->scheduled_scan_time);
-		list = ap_list_get_sorted (self, TRUE);
-		for (i = 0; list[i]; i++)
-			_ap_dump (self, LOGL_DEBUG, list[i], "dump", now_s);
+		for (i = 0; i < priv->aps_sorted->len; i++)
+			_ap_dump (self, LOGL_DEBUG, priv->aps_sorted->pdata[i], "dump", now_s);
 	}
 	return G_SOURCE_REMOVE;
 }
@@ -3277,8 +3278,6 @@ get_property (GObject *object, guint prop_id,
 {
 	NMDeviceWifi *self = NM_DEVICE_WIFI (object);
 	NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE (self);
-	gsize i;
-	char **list;
 
 	switch (prop_id) {
 	case PROP_MODE:
@@ -3291,10 +3290,7 @@ get_property (GObject *object, guint prop_id,
 		g_value_set_uint (value, priv->capabilities);
 		break;
 	case PROP_ACCESS_POINTS:
-		list = (char **) ap_list_get_sorted_paths (self, TRUE);
-		for (i = 0; list[i]; i++)
-			list[i] = g_strdup (list[i]);
-		g_value_take_boxed (value, list);
+		g_value_set_boxed (value, ap_list_get_paths (self));
 		break;
 	case PROP_ACTIVE_ACCESS_POINT:
 		nm_utils_g_value_set_object_path (value, priv->current_ap);
@@ -3335,6 +3331,7 @@ nm_device_wifi_init (NMDeviceWifi *self)
 
 	priv->mode = NM_802_11_MODE_INFRA;
 	priv->aps = g_hash_table_new (nm_str_hash, g_str_equal);
+	priv->aps_sorted = g_ptr_array_new ();
 }
 
 static void
@@ -3393,8 +3390,11 @@ finalize (GObject *object)
 	NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE (self);
 
 	nm_assert (g_hash_table_size (priv->aps) == 0);
+	nm_assert (priv->aps_sorted->len == 0);
 
 	g_hash_table_unref (priv->aps);
+	g_ptr_array_unref (priv->aps_sorted);
+	g_free (priv->aps_paths);
 
 	G_OBJECT_CLASS (nm_device_wifi_parent_class)->finalize (object);
 }
@@ -33,4 +33,31 @@
 
 /*****************************************************************************/
 
+/* Besides the D-Bus "Notify" call, the helper can deliver an event as a
+ * single datagram to a unix socket of NetworkManager. The datagram consists
+ * of a NMDhcpHelperEventHeader, followed by n_options times a
+ * NMDhcpHelperEventOption and the name and value of the option (without
+ * trailing NUL). All integers are in host byte order and the structs are not
+ * necessarily aligned in the datagram.
+ *
+ * If sending the datagram fails (for example, because an older NetworkManager
+ * doesn't listen on the socket), the helper falls back to D-Bus. */
+
+#define NM_DHCP_HELPER_EVENT_SOCKET_PATH        NMRUNDIR "/private-dhcp-event"
+#define NM_DHCP_HELPER_EVENT_MAGIC              ((guint32) 0x4e4d4801u)
+#define NM_DHCP_HELPER_EVENT_MAX_SIZE           (64 * 1024)
+
+typedef struct {
+	guint32 magic;
+	guint32 n_options;
+} NMDhcpHelperEventHeader;
+
+typedef struct {
+	guint16 name_len;
+	guint16 _reserved;
+	guint32 value_len;
+} NMDhcpHelperEventOption;
+
+/*****************************************************************************/
+
 #endif /* __NM_DHCP_HELPER_API_H__ */
@@ -24,6 +24,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <signal.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 
 #include "nm-utils/nm-vpn-plugin-macros.h"
 
@@ -64,6 +67,29 @@
 
 static const char * ignore[] = {"PATH", "SHLVL", "_", "PWD", "dhc_dbus", NULL};
 
+static gboolean
+env_item_parse (const char *item, gsize *out_name_len, const char **out_value)
+{
+	const char *val, **p;
+	gsize name_len;
+
+	/* Split on the = */
+	val = strchr (item, '=');
+	if (!val || val == item)
+		return FALSE;
+	name_len = val - item;
+
+	/* Ignore non-DCHP-related environment variables */
+	for (p = ignore; *p; p++) {
+		if (strncmp (item, *p, strlen (*p)) == 0)
+			return FALSE;
+	}
+
+	*out_name_len = name_len;
+	*out_value = &val[1];
+	return TRUE;
+}
+
 static GVariant *
 build_signal_parameters (void)
 {
@@ -74,20 +100,14 @@ build_signal_parameters (void)
 
 	/* List environment and format for dbus dict */
 	for (item = environ; *item; item++) {
-		char *name, *val, **p;
-
-		/* Split on the = */
-		name = g_strdup (*item);
-		val = strchr (name, '=');
-		if (!val || val == name)
-			goto next;
-		*val++ = '\0';
-
-		/* Ignore non-DCHP-related environment variables */
-		for (p = (char **) ignore; *p; p++) {
-			if (strncmp (name, *p, strlen (*p)) == 0)
-				goto next;
-		}
+		gs_free char *name = NULL;
+		const char *val;
+		gsize name_len;
+
+		if (!env_item_parse (*item, &name_len, &val))
+			continue;
+
+		name = g_strndup (*item, name_len);
 
 		/* Value passed as a byte array rather than a string, because there are
 		 * no character encoding guarantees with DHCP, and D-Bus requires
@@ -100,14 +120,92 @@ build_signal_parameters (void)
 		                       name,
 		                       g_variant_new_fixed_array (G_VARIANT_TYPE_BYTE,
 		                                                  val, strlen (val), 1));
-
-	next:
-		g_free (name);
 	}
 
 	return g_variant_ref_sink (g_variant_new ("(a{sv})", &builder));
 }
 
+static GByteArray *
+build_event_datagram (void)
+{
+	NMDhcpHelperEventHeader header = {
+		.magic = NM_DHCP_HELPER_EVENT_MAGIC,
+	};
+	GByteArray *buf;
+	char **item;
+
+	buf = g_byte_array_sized_new (4096);
+	g_byte_array_append (buf, (const guint8 *) &header, sizeof (header));
+
+	for (item = environ; *item; item++) {
+		NMDhcpHelperEventOption option = { };
+		const char *val;
+		gsize name_len, value_len;
+
+		if (!env_item_parse (*item, &name_len, &val))
+			continue;
+
+		value_len = strlen (val);
+		if (   name_len > G_MAXUINT16
+		    || buf->len + sizeof (option) + name_len + value_len > NM_DHCP_HELPER_EVENT_MAX_SIZE) {
+			g_byte_array_unref (buf);
+			return NULL;
+		}
+
+		option.name_len = name_len;
+		option.value_len = value_len;
+		g_byte_array_append (buf, (const guint8 *) &option, sizeof (option));
+		g_byte_array_append (buf, (const guint8 *) *item, name_len);
+		g_byte_array_append (buf, (const guint8 *) val, value_len);
+		header.n_options++;
+	}
+
+	memcpy (buf->data, &header, sizeof (header));
+	return buf;
+}
+
+static gboolean
+notify_via_event_socket (void)
+{
+	struct sockaddr_un addr = {
+		.sun_family = AF_UNIX,
+		.sun_path = NM_DHCP_HELPER_EVENT_SOCKET_PATH,
+	};
+	GByteArray *buf;
+	gssize n;
+	int fd;
+	int errsv;
+
+	buf = build_event_datagram ();
+	if (!buf) {
+		_LOGi ("event too large for the event socket");
+		return FALSE;
+	}
+
+	fd = socket (AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+	if (fd < 0) {
+		errsv = errno;
+		_LOGi ("could not create event socket: %s", g_strerror (errsv));
+		g_byte_array_unref (buf);
+		return FALSE;
+	}
+
+	do {
+		n = sendto (fd, buf->data, buf->len, 0, (struct sockaddr *) &addr, sizeof (addr));
+	} while (n < 0 && errno == EINTR);
+	errsv = errno;
+
+	nm_close (fd);
+	g_byte_array_unref (buf);
+
+	if (n < 0) {
+		_LOGi ("could not send event to %s: %s (fall back to D-Bus)",
+		       NM_DHCP_HELPER_EVENT_SOCKET_PATH, g_strerror (errsv));
+		return FALSE;
+	}
+	return TRUE;
+}
+
 static void
 kill_pid (void)
 {
@@ -134,6 +232,10 @@ main (int argc, char *argv[])
 	guint try_count = 0;
 	gint64 time_end;
 
+	/* try the cheap way first. */
+	if (notify_via_event_socket ())
+		return EXIT_SUCCESS;
+
 	nm_g_type_init ();
 
 	/* FIXME: g_dbus_connection_new_for_address_sync() tries to connect to the socket in
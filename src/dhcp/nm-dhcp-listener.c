@@ -28,10 +28,14 @@
 #include <stdlib.h>
 #include <errno.h>
 #include <unistd.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <glib-unix.h>
 
 #include "nm-dhcp-helper-api.h"
 #include "nm-dhcp-client.h"
 #include "nm-dhcp-manager.h"
+#include "nm-dhcp-utils.h"
 #include "nm-core-internal.h"
 #include "nm-bus-manager.h"
 #include "NetworkManagerUtils.h"
@@ -64,6 +68,10 @@ typedef struct {
 	gulong              new_conn_id;
 	gulong              dis_conn_id;
 	GHashTable *        connections;
+
+	int                 event_fd;
+	guint               event_source_id;
+	guint8 *            event_buf;
 } NMDhcpListenerPrivate;
 
 struct _NMDhcpListener {
@@ -180,6 +188,107 @@ _method_call_handle (NMDhcpListener *self,
 	}
 }
 
+/*****************************************************************************/
+
+static gboolean
+_event_socket_cb (int fd, GIOCondition condition, gpointer user_data)
+{
+	NMDhcpListener *self = user_data;
+	NMDhcpListenerPrivate *priv = NM_DHCP_LISTENER_GET_PRIVATE (self);
+	union {
+		struct cmsghdr cmsghdr;
+		guint8 buf[CMSG_SPACE (sizeof (struct ucred))];
+	} control;
+	struct iovec iov = {
+		.iov_base = priv->event_buf,
+		.iov_len = NM_DHCP_HELPER_EVENT_MAX_SIZE,
+	};
+	struct msghdr msg = {
+		.msg_iov = &iov,
+		.msg_iovlen = 1,
+		.msg_control = &control,
+		.msg_controllen = sizeof (control),
+	};
+	struct cmsghdr *cmsg;
+	gs_unref_variant GVariant *parameters = NULL;
+	const struct ucred *ucred = NULL;
+	gssize n;
+	int errsv;
+
+	n = recvmsg (fd, &msg, MSG_DONTWAIT | MSG_TRUNC);
+	if (n < 0) {
+		errsv = errno;
+		if (!NM_IN_SET (errsv, EAGAIN, EINTR))
+			_LOGW ("dhcp-event: failure to receive event: %s", g_strerror (errsv));
+		return G_SOURCE_CONTINUE;
+	}
+
+	for (cmsg = CMSG_FIRSTHDR (&msg); cmsg; cmsg = CMSG_NXTHDR (&msg, cmsg)) {
+		if (   cmsg->cmsg_level == SOL_SOCKET
+		    && cmsg->cmsg_type == SCM_CREDENTIALS
+		    && cmsg->cmsg_len >= CMSG_LEN (sizeof (struct ucred)))
+			ucred = (const struct ucred *) CMSG_DATA (cmsg);
+	}
+
+	/* the socket is only writable by root, but double check. */
+	if (!ucred || ucred->uid != 0) {
+		_LOGW ("dhcp-event: ignore event from unprivileged sender");
+		return G_SOURCE_CONTINUE;
+	}
+
+	if (   NM_FLAGS_HAS (msg.msg_flags, MSG_TRUNC)
+	    || !(parameters = nm_dhcp_utils_event_datagram_parse (priv->event_buf, n))) {
+		_LOGW ("dhcp-event: ignore invalid event from pid %d", (int) ucred->pid);
+		return G_SOURCE_CONTINUE;
+	}
+
+	_method_call_handle (self, parameters);
+	return G_SOURCE_CONTINUE;
+}
+
+static void
+_event_socket_setup (NMDhcpListener *self)
+{
+	NMDhcpListenerPrivate *priv = NM_DHCP_LISTENER_GET_PRIVATE (self);
+	struct sockaddr_un addr = {
+		.sun_family = AF_UNIX,
+		.sun_path = NM_DHCP_HELPER_EVENT_SOCKET_PATH,
+	};
+	const int on = 1;
+	int fd;
+	int errsv;
+
+	fd = socket (AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+	if (fd < 0) {
+		errsv = errno;
+		_LOGD ("dhcp-event: cannot create event socket: %s", g_strerror (errsv));
+		return;
+	}
+
+	if (setsockopt (fd, SOL_SOCKET, SO_PASSCRED, &on, sizeof (on)) < 0) {
+		errsv = errno;
+		_LOGD ("dhcp-event: cannot enable credentials on event socket: %s", g_strerror (errsv));
+		nm_close (fd);
+		return;
+	}
+
+	unlink (NM_DHCP_HELPER_EVENT_SOCKET_PATH);
+	if (bind (fd, (struct sockaddr *) &addr, sizeof (addr)) < 0) {
+		errsv = errno;
+		_LOGD ("dhcp-event: cannot bind event socket %s: %s (only use D-Bus)",
+		       NM_DHCP_HELPER_EVENT_SOCKET_PATH, g_strerror (errsv));
+		nm_close (fd);
+		return;
+	}
+	chmod (NM_DHCP_HELPER_EVENT_SOCKET_PATH, 0600);
+
+	priv->event_fd = fd;
+	priv->event_buf = g_malloc (NM_DHCP_HELPER_EVENT_MAX_SIZE);
+	priv->event_source_id = g_unix_fd_add (fd, G_IO_IN, _event_socket_cb, self);
+}
+
+/*****************************************************************************/
+
 static void
 _method_call (GDBusConnection *connection,
               const char *sender,
@@ -314,6 +423,9 @@ nm_dhcp_listener_init (NMDhcpListener *self)
 	                                      NM_BUS_MANAGER_PRIVATE_CONNECTION_DISCONNECTED "::" PRIV_SOCK_TAG,
 	                                      G_CALLBACK (dis_connection_cb),
 	                                      self);
+
+	priv->event_fd = -1;
+	_event_socket_setup (self);
 }
 
 static void
@@ -327,6 +439,14 @@ dispose (GObject *object)
 
 	g_clear_pointer (&priv->connections, g_hash_table_destroy);
 
+	nm_clear_g_source (&priv->event_source_id);
+	if (priv->event_fd >= 0) {
+		nm_close (priv->event_fd);
+		priv->event_fd = -1;
+		unlink (NM_DHCP_HELPER_EVENT_SOCKET_PATH);
+	}
+	g_clear_pointer (&priv->event_buf, g_free);
+
 	G_OBJECT_CLASS (nm_dhcp_listener_parent_class)->dispose (object);
 }
 
@@ -637,6 +637,13 @@ ip4_start (NMDhcpClient *client, const char *dhcp_anycast_addr, const char *last
 		goto error;
 	}
 
+	/* all clients use the default event loop and share one packet socket
+	 * until they are bound. If that socket cannot be used, the client
+	 * falls back to a packet socket of its own. */
+	r = sd_dhcp_client_set_shared_raw_socket (priv->client4, TRUE);
+	if (r < 0)
+		_LOGD ("failed to enable the shared packet socket (%d)", r);
+
 	hwaddr = nm_dhcp_client_get_hw_addr (client);
 	if (hwaddr) {
 		arp_type= get_arp_type (hwaddr);
@@ -27,6 +27,7 @@
 #include "nm-utils/nm-dedup-multi.h"
 
 #include "nm-dhcp-utils.h"
+#include "nm-dhcp-helper-api.h"
 #include "nm-utils.h"
 #include "NetworkManagerUtils.h"
 #include "platform/nm-platform.h"
@@ -764,3 +765,75 @@ nm_dhcp_utils_client_id_string_to_bytes (const char *client_id)
 	return bytes;
 }
 
+/**
+ * nm_dhcp_utils_event_datagram_parse:
+ * @buf: the datagram sent by nm-dhcp-helper
+ * @len: the length of @buf
+ *
+ * Decodes an event datagram, as described in nm-dhcp-helper-api.h. The
+ * datagram is rejected if it is larger than %NM_DHCP_HELPER_EVENT_MAX_SIZE,
+ * has a wrong magic, is truncated or has trailing data, or contains an
+ * option twice.
+ *
+ * Returns: (transfer full): the options as "(a{sv})" with byte array values,
+ * like the parameters of the helper's D-Bus "Notify" call, or %NULL if the
+ * datagram is invalid.
+ */
+GVariant *
+nm_dhcp_utils_event_datagram_parse (const guint8 *buf, gsize len)
+{
+	gs_unref_hashtable GHashTable *names = NULL;
+	NMDhcpHelperEventHeader header;
+	GVariantBuilder builder;
+	const guint8 *end;
+	guint32 i;
+
+	if (   len < sizeof (header)
+	    || len > NM_DHCP_HELPER_EVENT_MAX_SIZE)
+		return NULL;
+	memcpy (&header, buf, sizeof (header));
+	if (header.magic != NM_DHCP_HELPER_EVENT_MAGIC)
+		return NULL;
+	end = &buf[len];
+	buf += sizeof (header);
+
+	names = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, NULL);
+	g_variant_builder_init (&builder, G_VARIANT_TYPE_VARDICT);
+
+	for (i = 0; i < header.n_options; i++) {
+		NMDhcpHelperEventOption option;
+		char *name;
+
+		if ((gsize) (end - buf) < sizeof (option))
+			goto fail;
+		memcpy (&option, buf, sizeof (option));
+		buf += sizeof (option);
+
+		if (   option.name_len == 0
+		    || (gsize) (end - buf) < option.name_len
+		    || (gsize) (end - buf) - option.name_len < option.value_len)
+			goto fail;
+
+		name = g_strndup ((const char *) buf, option.name_len);
+		buf += option.name_len;
+
+		if (!nm_g_hash_table_add (names, name))
+			goto fail;
+
+		/* same encoding as used by the helper for the D-Bus call. */
+		g_variant_builder_add (&builder, "{sv}",
+		                       name,
+		                       g_variant_new_fixed_array (G_VARIANT_TYPE_BYTE,
+		                                                  buf, option.value_len, 1));
+		buf += option.value_len;
+	}
+
+	if (buf != end)
+		goto fail;
+
+	return g_variant_ref_sink (g_variant_new ("(a{sv})", &builder));
+
+fail:
+	g_variant_builder_clear (&builder);
+	return NULL;
+}
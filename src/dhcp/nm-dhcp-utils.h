@@ -43,5 +43,7 @@ char *       nm_dhcp_utils_duid_to_string          (const GByteArray *duid);
 
 GBytes *     nm_dhcp_utils_client_id_string_to_bytes (const char *client_id);
 
+GVariant *   nm_dhcp_utils_event_datagram_parse    (const guint8 *buf, gsize len);
+
 #endif /* __NETWORKMANAGER_DHCP_UTILS_H__ */
 
@@ -28,6 +28,7 @@
 #include "nm-utils.h"
 
 #include "dhcp/nm-dhcp-utils.h"
+#include "dhcp/nm-dhcp-helper-api.h"
 #include "platform/nm-platform.h"
 
 #include "nm-test-utils-core.h"
@@ -727,6 +728,184 @@ test_client_id_from_string (void)
 	COMPARE_ID (endcolon, TRUE, endcolon, strlen (endcolon));
 }
 
+/*****************************************************************************/
+
+static void
+_datagram_add_header (GByteArray *buf, guint32 magic, guint32 n_options)
+{
+	NMDhcpHelperEventHeader header = {
+		.magic = magic,
+		.n_options = n_options,
+	};
+
+	g_byte_array_append (buf, (const guint8 *) &header, sizeof (header));
+}
+
+static void
+_datagram_add_option (GByteArray *buf, const char *name, const void *value, gsize value_len)
+{
+	NMDhcpHelperEventOption option = {
+		.name_len = strlen (name),
+		.value_len = value_len,
+	};
+
+	g_byte_array_append (buf, (const guint8 *) &option, sizeof (option));
+	g_byte_array_append (buf, (const guint8 *) name, option.name_len);
+	if (value_len)
+		g_byte_array_append (buf, value, value_len);
+}
+
+static GVariant *
+_datagram_parse (GByteArray *buf)
+{
+	return nm_dhcp_utils_event_datagram_parse (buf->data, buf->len);
+}
+
+static void
+_assert_option (GVariant *parameters, const char *name, const void *value, gsize value_len)
+{
+	gs_unref_variant GVariant *options = NULL;
+	gs_unref_variant GVariant *v = NULL;
+	gconstpointer data;
+	gsize len;
+
+	g_assert (parameters);
+	g_assert (g_variant_is_of_type (parameters, G_VARIANT_TYPE ("(a{sv})")));
+	options = g_variant_get_child_value (parameters, 0);
+	v = g_variant_lookup_value (options, name, G_VARIANT_TYPE_BYTESTRING);
+	g_assert (v);
+	data = g_variant_get_fixed_array (v, &len, 1);
+	g_assert_cmpint (len, ==, value_len);
+	g_assert (len == 0 || memcmp (data, value, len) == 0);
+}
+
+static void
+test_event_datagram (void)
+{
+	GByteArray *buf;
+	gs_unref_variant GVariant *parameters = NULL;
+	gs_unref_variant GVariant *options = NULL;
+
+	buf = g_byte_array_new ();
+	_datagram_add_header (buf, NM_DHCP_HELPER_EVENT_MAGIC, 3);
+	_datagram_add_option (buf, "reason", "BOUND", 5);
+	_datagram_add_option (buf, "new_ip_address", "192.168.1.5", 11);
+	_datagram_add_option (buf, "empty", NULL, 0);
+
+	parameters = _datagram_parse (buf);
+	_assert_option (parameters, "reason", "BOUND", 5);
+	_assert_option (parameters, "new_ip_address", "192.168.1.5", 11);
+	_assert_option (parameters, "empty", NULL, 0);
+	options = g_variant_get_child_value (parameters, 0);
+	g_assert_cmpint (g_variant_n_children (options), ==, 3);
+
+	/* trailing data */
+	g_byte_array_append (buf, (const guint8 *) "x", 1);
+	g_assert (!_datagram_parse (buf));
+
+	g_byte_array_unref (buf);
+}
+
+static void
+test_event_datagram_invalid (void)
+{
+	GByteArray *buf;
+	NMDhcpHelperEventOption option = {
+		.name_len = 6,
+		.value_len = 100,
+	};
+	guint len;
+
+	/* truncated header */
+	buf = g_byte_array_new ();
+	_datagram_add_header (buf, NM_DHCP_HELPER_EVENT_MAGIC, 0);
+	for (len = 0; len < sizeof (NMDhcpHelperEventHeader); len++)
+		g_assert (!nm_dhcp_utils_event_datagram_parse (buf->data, len));
+	g_byte_array_unref (buf);
+
+	/* wrong magic */
+	buf = g_byte_array_new ();
+	_datagram_add_header (buf, NM_DHCP_HELPER_EVENT_MAGIC + 1, 1);
+	_datagram_add_option (buf, "reason", "BOUND", 5);
+	g_assert (!_datagram_parse (buf));
+	g_byte_array_unref (buf);
+
+	/* more options announced than contained */
+	buf = g_byte_array_new ();
+	_datagram_add_header (buf, NM_DHCP_HELPER_EVENT_MAGIC, 2);
+	_datagram_add_option (buf, "reason", "BOUND", 5);
+	g_assert (!_datagram_parse (buf));
+	g_byte_array_unref (buf);
+
+	/* truncated option header */
+	buf = g_byte_array_new ();
+	_datagram_add_header (buf, NM_DHCP_HELPER_EVENT_MAGIC, 1);
+	g_byte_array_append (buf, (const guint8 *) &option, sizeof (option) - 1);
+	g_assert (!_datagram_parse (buf));
+	g_byte_array_unref (buf);
+
+	/* the value length overruns the buffer */
+	buf = g_byte_array_new ();
+	_datagram_add_header (buf, NM_DHCP_HELPER_EVENT_MAGIC, 1);
+	g_byte_array_append (buf, (const guint8 *) &option, sizeof (option));
+	g_byte_array_append (buf, (const guint8 *) "reasonBOUND", 11);
+	g_assert (!_datagram_parse (buf));
+	option.value_len = G_MAXUINT32;
+	g_byte_array_set_size (buf, sizeof (NMDhcpHelperEventHeader));
+	g_byte_array_append (buf, (const guint8 *) &option, sizeof (option));
+	g_byte_array_append (buf, (const guint8 *) "reasonBOUND", 11);
+	g_assert (!_datagram_parse (buf));
+	g_byte_array_unref (buf);
+
+	/* empty name */
+	buf = g_byte_array_new ();
+	_datagram_add_header (buf, NM_DHCP_HELPER_EVENT_MAGIC, 1);
+	_datagram_add_option (buf, "", "BOUND", 5);
+	g_assert (!_datagram_parse (buf));
+	g_byte_array_unref (buf);
+
+	/* duplicate option */
+	buf = g_byte_array_new ();
+	_datagram_add_header (buf, NM_DHCP_HELPER_EVENT_MAGIC, 2);
+	_datagram_add_option (buf, "reason", "BOUND", 5);
+	_datagram_add_option (buf, "reason", "EXPIRE", 6);
+	g_assert (!_datagram_parse (buf));
+	g_byte_array_unref (buf);
+}
+
+static void
+test_event_datagram_max_size (void)
+{
+	const gsize value_len = NM_DHCP_HELPER_EVENT_MAX_SIZE
+	                        - sizeof (NMDhcpHelperEventHeader)
+	                        - sizeof (NMDhcpHelperEventOption)
+	                        - NM_STRLEN ("value");
+	gs_free guint8 *value = NULL;
+	gs_unref_variant GVariant *parameters = NULL;
+	GByteArray *buf;
+
+	value = g_malloc (value_len + 1);
+	memset (value, 'a', value_len + 1);
+
+	buf = g_byte_array_new ();
+	_datagram_add_header (buf, NM_DHCP_HELPER_EVENT_MAGIC, 1);
+	_datagram_add_option (buf, "value", value, value_len);
+	g_assert_cmpint (buf->len, ==, NM_DHCP_HELPER_EVENT_MAX_SIZE);
+	parameters = _datagram_parse (buf);
+	_assert_option (parameters, "value", value, value_len);
+	g_byte_array_unref (buf);
+
+	/* one byte more is rejected. */
+	buf = g_byte_array_new ();
+	_datagram_add_header (buf, NM_DHCP_HELPER_EVENT_MAGIC, 1);
+	_datagram_add_option (buf, "value", value, value_len + 1);
+	g_assert_cmpint (buf->len, ==, NM_DHCP_HELPER_EVENT_MAX_SIZE + 1);
+	g_assert (!_datagram_parse (buf));
+	g_byte_array_unref (buf);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE ();
 
 int main (int argc, char **argv)
@@ -754,6 +933,9 @@ int main (int argc, char **argv)
 	g_test_add_func ("/dhcp/ip4-prefix-classless", test_ip4_prefix_classless);
 	g_test_add_func ("/dhcp/client-id-from-string", test_client_id_from_string);
 	g_test_add_func ("/dhcp/vendor-option-metered", test_vendor_option_metered);
+	g_test_add_func ("/dhcp/event-datagram", test_event_datagram);
+	g_test_add_func ("/dhcp/event-datagram-invalid", test_event_datagram_invalid);
+	g_test_add_func ("/dhcp/event-datagram-max-size", test_event_datagram_max_size);
 
 	return g_test_run ();
 }
@@ -365,6 +365,23 @@ main (int argc, char *argv[])
 		                              NM_CONFIG_KEYFILE_KEY_LOGGING_BACKEND,
 		                              NM_CONFIG_GET_VALUE_STRIP | NM_CONFIG_GET_VALUE_NO_EMPTY);
 		nm_logging_syslog_openlog (v, nm_config_get_is_debug (config));
+
+		if (nm_config_data_get_value_boolean (NM_CONFIG_GET_DATA_ORIG,
+		                                      NM_CONFIG_KEYFILE_GROUP_LOGGING,
+		                                      NM_CONFIG_KEYFILE_KEY_LOGGING_ASYNC,
+		                                      FALSE))
+			nm_logging_async_start ();
+
+		nm_logging_set_rate_limit (nm_config_data_get_value_int64 (NM_CONFIG_GET_DATA_ORIG,
+		                                                           NM_CONFIG_KEYFILE_GROUP_LOGGING,
+		                                                           NM_CONFIG_KEYFILE_KEY_LOGGING_RATE_LIMIT_BURST,
+		                                                           10, 0, G_MAXUINT32,
+		                                                           NM_CONFIG_DEFAULT_LOGGING_RATE_LIMIT_BURST_INT),
+		                           nm_config_data_get_value_int64 (NM_CONFIG_GET_DATA_ORIG,
+		                                                           NM_CONFIG_KEYFILE_GROUP_LOGGING,
+		                                                           NM_CONFIG_KEYFILE_KEY_LOGGING_RATE_LIMIT_INTERVAL,
+		                                                           10, 0, G_MAXUINT32,
+		                                                           NM_CONFIG_DEFAULT_LOGGING_RATE_LIMIT_INTERVAL_INT));
 	}
 
 	nm_log_info (LOGD_CORE, "NetworkManager (version " NM_DIST_VERSION ") is starting... (%s)",
@@ -465,5 +482,7 @@ done:
 
 	nm_clear_g_source (&sd_id);
 
+	nm_logging_async_stop ();
+
 	exit (success ? 0 : 1);
 }
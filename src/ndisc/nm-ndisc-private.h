@@ -29,7 +29,10 @@ struct _NMNDiscDataInternal {
 	NMNDiscData public;
 	GArray *gateways;
 	GArray *addresses;
-	GArray *routes;
+	GArray *routes;             /* sorted copy of @routes_idx */
+	GHashTable *routes_idx;
+	guint64 routes_seq;
+	bool routes_dirty:1;
 	GArray *dns_servers;
 	GArray *dns_domains;
 };
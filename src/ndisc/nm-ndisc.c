@@ -55,6 +55,8 @@ struct _NMNDiscPrivate {
 	};
 	guint ra_timeout_id;  /* first RA timeout */
 	guint timeout_id;   /* prefix/dns/etc lifetime timeout */
+	gint32 next_event;  /* no lifetime expires or needs a refresh before */
+	bool refresh_due:1; /* a refresh was due at the last check */
 	char *last_error;
 	NMUtilsIPv6IfaceId iid;
 
@@ -210,10 +212,137 @@ _ASSERT_data_gateways (const NMNDiscDataInternal *data)
 
 /*****************************************************************************/
 
+static gint32
+get_expiry_time (guint32 timestamp, guint32 lifetime)
+{
+	gint64 t;
+
+	/* timestamp is supposed to come from nm_utils_get_monotonic_timestamp_s().
+	 * It is expected to be within a certain range. */
+	nm_assert (timestamp > 0);
+	nm_assert (timestamp <= G_MAXINT32);
+
+	if (lifetime == NM_NDISC_INFINITY)
+		return G_MAXINT32;
+
+	t = (gint64) timestamp + (gint64) lifetime;
+	return CLAMP (t, 0, G_MAXINT32 - 1);
+}
+
+#define get_expiry(item) \
+	({ \
+		typeof (item) _item = (item); \
+		nm_assert (_item); \
+		get_expiry_time ((_item->timestamp), (_item->lifetime)); \
+	})
+
+#define get_expiry_half(item) \
+	({ \
+		typeof (item) _item = (item); \
+		nm_assert (_item); \
+		get_expiry_time ((_item->timestamp),\
+		                 (_item->lifetime) == NM_NDISC_INFINITY \
+		                   ? NM_NDISC_INFINITY \
+		                   : (_item->lifetime) / 2); \
+	})
+
+/*****************************************************************************/
+
+/* The routes are indexed by network and prefix length. The public array is
+ * rebuilt from the index only when it is handed out after a change. */
+typedef struct {
+	NMNDiscRoute route;     /* the key. Must be the first field. */
+	guint64 seq;            /* newer routes sort first */
+} RouteEntry;
+
+static guint
+_route_entry_hash (gconstpointer ptr)
+{
+	const NMNDiscRoute *route = ptr;
+	NMHashState h;
+
+	nm_hash_init (&h, 2092733069u);
+	nm_hash_update_val (&h, route->network);
+	nm_hash_update_val (&h, route->plen);
+	return nm_hash_complete (&h);
+}
+
+static gboolean
+_route_entry_equal (gconstpointer a, gconstpointer b)
+{
+	const NMNDiscRoute *route_a = a;
+	const NMNDiscRoute *route_b = b;
+
+	return    route_a->plen == route_b->plen
+	       && IN6_ARE_ADDR_EQUAL (&route_a->network, &route_b->network);
+}
+
+static void
+_route_entry_free (gpointer data)
+{
+	g_slice_free (RouteEntry, data);
+}
+
+static int
+_route_entry_cmp (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+	const RouteEntry *entry_a = *((const RouteEntry *const*) a);
+	const RouteEntry *entry_b = *((const RouteEntry *const*) b);
+
+	/* more preferable routes first. */
+	NM_CMP_DIRECT (_preference_to_priority (entry_b->route.preference),
+	               _preference_to_priority (entry_a->route.preference));
+	NM_CMP_DIRECT (entry_b->seq, entry_a->seq);
+	return 0;
+}
+
+static void
+_routes_sync (NMNDiscDataInternal *data)
+{
+	gs_free RouteEntry **entries = NULL;
+	GHashTableIter iter;
+	RouteEntry *entry;
+	guint i, n;
+
+	if (!data->routes_dirty)
+		return;
+	data->routes_dirty = FALSE;
+
+	n = g_hash_table_size (data->routes_idx);
+	g_array_set_size (data->routes, n);
+	if (!n)
+		return;
+
+	entries = g_new (RouteEntry *, n);
+	i = 0;
+	g_hash_table_iter_init (&iter, data->routes_idx);
+	while (g_hash_table_iter_next (&iter, (gpointer *) &entry, NULL))
+		entries[i++] = entry;
+	nm_assert (i == n);
+
+	g_qsort_with_data (entries, n, sizeof (RouteEntry *), _route_entry_cmp, NULL);
+	for (i = 0; i < n; i++)
+		g_array_index (data->routes, NMNDiscRoute, i) = entries[i]->route;
+}
+
+/*****************************************************************************/
+
+static void
+_next_event_lower (NMNDisc *ndisc, gint32 event)
+{
+	NMNDiscPrivate *priv = NM_NDISC_GET_PRIVATE (ndisc);
+
+	if (priv->next_event > event)
+		priv->next_event = event;
+}
+
+/*****************************************************************************/
+
 static const NMNDiscData *
 _data_complete (NMNDiscDataInternal *data)
 {
 	_ASSERT_data_gateways (data);
+	_routes_sync (data);
 
 #define _SET(data, field) \
 	G_STMT_START { \
@@ -234,9 +363,12 @@ _data_complete (NMNDiscDataInternal *data)
 static void
 _emit_config_change (NMNDisc *self, NMNDiscConfigMap changed)
 {
+	const NMNDiscData *rdata;
+
+	rdata = _data_complete (&NM_NDISC_GET_PRIVATE (self)->rdata);
 	_config_changed_log (self, changed);
 	g_signal_emit (self, signals[CONFIG_CHANGED], 0,
-	               _data_complete (&NM_NDISC_GET_PRIVATE (self)->rdata),
+	               rdata,
 	               (guint) changed);
 }
 
@@ -265,6 +397,7 @@ nm_ndisc_add_gateway (NMNDisc *ndisc, const NMNDiscGateway *new)
 			}
 
 			*item = *new;
+			_next_event_lower (ndisc, get_expiry (new));
 			_ASSERT_data_gateways (rdata);
 			return FALSE;
 		}
@@ -283,6 +416,7 @@ nm_ndisc_add_gateway (NMNDisc *ndisc, const NMNDiscGateway *new)
 		                      ? rdata->gateways->len
 		                      : insert_idx,
 		                    *new);
+		_next_event_lower (ndisc, get_expiry (new));
 	}
 	_ASSERT_data_gateways (rdata);
 	return !!new->lifetime;
@@ -363,6 +497,7 @@ nm_ndisc_add_address (NMNDisc *ndisc, const NMNDiscAddress *new)
 			changed = item->timestamp + item->lifetime  != new->timestamp + new->lifetime ||
 			          item->timestamp + item->preferred != new->timestamp + new->preferred;
 			*item = *new;
+			_next_event_lower (ndisc, get_expiry (new));
 			return changed;
 		}
 	}
@@ -375,8 +510,10 @@ nm_ndisc_add_address (NMNDisc *ndisc, const NMNDiscAddress *new)
 	    && rdata->addresses->len >= priv->max_addresses)
 		return FALSE;
 
-	if (new->lifetime)
+	if (new->lifetime) {
 		g_array_append_val (rdata->addresses, *new);
+		_next_event_lower (ndisc, get_expiry (new));
+	}
 	return !!new->lifetime;
 }
 
@@ -394,8 +531,7 @@ nm_ndisc_add_route (NMNDisc *ndisc, const NMNDiscRoute *new)
 {
 	NMNDiscPrivate *priv;
 	NMNDiscDataInternal *rdata;
-	guint i;
-	guint insert_idx = G_MAXUINT;
+	RouteEntry *entry;
 
 	if (new->plen == 0 || new->plen > 128) {
 		/* Only expect non-default routes.  The router has no idea what the
@@ -411,40 +547,35 @@ nm_ndisc_add_route (NMNDisc *ndisc, const NMNDiscRoute *new)
 	priv = NM_NDISC_GET_PRIVATE (ndisc);
 	rdata = &priv->rdata;
 
-	for (i = 0; i < rdata->routes->len; ) {
-		NMNDiscRoute *item = &g_array_index (rdata->routes, NMNDiscRoute, i);
-
-		if (IN6_ARE_ADDR_EQUAL (&item->network, &new->network) && item->plen == new->plen) {
-			if (new->lifetime == 0) {
-				g_array_remove_index (rdata->routes, i);
-				return TRUE;
-			}
-
-			if (item->preference != new->preference) {
-				g_array_remove_index (rdata->routes, i);
-				continue;
-			}
+	entry = g_hash_table_lookup (rdata->routes_idx, new);
+	if (entry) {
+		if (new->lifetime == 0) {
+			g_hash_table_remove (rdata->routes_idx, entry);
+			rdata->routes_dirty = TRUE;
+			return TRUE;
+		}
 
-			memcpy (item, new, sizeof (*new));
+		if (entry->route.preference == new->preference) {
+			entry->route = *new;
+			rdata->routes_dirty = TRUE;
+			_next_event_lower (ndisc, get_expiry (new));
 			return FALSE;
 		}
 
-		/* Put before less preferable routes. */
-		if (   _preference_to_priority (item->preference) < _preference_to_priority (new->preference)
-		    && insert_idx == G_MAXUINT)
-			insert_idx = i;
-
-		i++;
+		/* re-add it as a new route with the new preference. */
+		g_hash_table_remove (rdata->routes_idx, entry);
 	}
 
-	if (new->lifetime) {
-		g_array_insert_val (rdata->routes,
-		                    insert_idx == G_MAXUINT
-		                      ? 0u
-		                      : insert_idx,
-		                    *new);
-	}
-	return !!new->lifetime;
+	if (!new->lifetime)
+		return FALSE;
+
+	entry = g_slice_new (RouteEntry);
+	entry->route = *new;
+	entry->seq = ++rdata->routes_seq;
+	g_hash_table_add (rdata->routes_idx, entry);
+	rdata->routes_dirty = TRUE;
+	_next_event_lower (ndisc, get_expiry (new));
+	return TRUE;
 }
 
 gboolean
@@ -467,14 +598,17 @@ nm_ndisc_add_dns_server (NMNDisc *ndisc, const NMNDiscDNSServer *new)
 			}
 			if (item->timestamp != new->timestamp || item->lifetime != new->lifetime) {
 				*item = *new;
+				_next_event_lower (ndisc, get_expiry_half (new));
 				return TRUE;
 			}
 			return FALSE;
 		}
 	}
 
-	if (new->lifetime)
+	if (new->lifetime) {
 		g_array_append_val (rdata->dns_servers, *new);
+		_next_event_lower (ndisc, get_expiry_half (new));
+	}
 	return !!new->lifetime;
 }
 
@@ -506,6 +640,7 @@ nm_ndisc_add_dns_domain (NMNDisc *ndisc, const NMNDiscDNSDomain *new)
 			if (changed) {
 				item->timestamp = new->timestamp;
 				item->lifetime = new->lifetime;
+				_next_event_lower (ndisc, get_expiry_half (new));
 			}
 			return changed;
 		}
@@ -517,6 +652,7 @@ nm_ndisc_add_dns_domain (NMNDisc *ndisc, const NMNDiscDNSDomain *new)
 		                       NMNDiscDNSDomain,
 		                       rdata->dns_domains->len - 1);
 		item->domain = g_strdup (new->domain);
+		_next_event_lower (ndisc, get_expiry_half (new));
 	}
 	return !!new->lifetime;
 }
@@ -853,40 +989,6 @@ dhcp_level_to_string (NMNDiscDHCPLevel dhcp_level)
 	}
 }
 
-static gint32
-get_expiry_time (guint32 timestamp, guint32 lifetime)
-{
-	gint64 t;
-
-	/* timestamp is supposed to come from nm_utils_get_monotonic_timestamp_s().
-	 * It is expected to be within a certain range. */
-	nm_assert (timestamp > 0);
-	nm_assert (timestamp <= G_MAXINT32);
-
-	if (lifetime == NM_NDISC_INFINITY)
-		return G_MAXINT32;
-
-	t = (gint64) timestamp + (gint64) lifetime;
-	return CLAMP (t, 0, G_MAXINT32 - 1);
-}
-
-#define get_expiry(item) \
-	({ \
-		typeof (item) _item = (item); \
-		nm_assert (_item); \
-		get_expiry_time ((_item->timestamp), (_item->lifetime)); \
-	})
-
-#define get_expiry_half(item) \
-	({ \
-		typeof (item) _item = (item); \
-		nm_assert (_item); \
-		get_expiry_time ((_item->timestamp),\
-		                 (_item->lifetime) == NM_NDISC_INFINITY \
-		                   ? NM_NDISC_INFINITY \
-		                   : (_item->lifetime) / 2); \
-	})
-
 static void
 _config_changed_log (NMNDisc *ndisc, NMNDiscConfigMap changed)
 {
@@ -1000,25 +1102,25 @@ static void
 clean_routes (NMNDisc *ndisc, gint32 now, NMNDiscConfigMap *changed, gint32 *nextevent)
 {
 	NMNDiscDataInternal *rdata;
-	guint i;
+	GHashTableIter iter;
+	RouteEntry *entry;
 
 	rdata = &NM_NDISC_GET_PRIVATE (ndisc)->rdata;
 
-	for (i = 0; i < rdata->routes->len; ) {
-		NMNDiscRoute *item = &g_array_index (rdata->routes, NMNDiscRoute, i);
-
-		if (item->lifetime != NM_NDISC_INFINITY) {
-			gint32 expiry = get_expiry (item);
+	g_hash_table_iter_init (&iter, rdata->routes_idx);
+	while (g_hash_table_iter_next (&iter, (gpointer *) &entry, NULL)) {
+		if (entry->route.lifetime != NM_NDISC_INFINITY) {
+			gint32 expiry = get_expiry (&entry->route);
 
 			if (now >= expiry) {
-				g_array_remove_index (rdata->routes, i);
+				g_hash_table_iter_remove (&iter);
+				rdata->routes_dirty = TRUE;
 				*changed |= NM_NDISC_CONFIG_ROUTES;
 				continue;
 			}
 			if (*nextevent > expiry)
 				*nextevent = expiry;
 		}
-		i++;
 	}
 }
 
@@ -1044,9 +1146,10 @@ clean_dns_servers (NMNDisc *ndisc, gint32 now, NMNDiscConfigMap *changed, gint32
 			}
 
 			refresh = get_expiry_half (item);
-			if (now >= refresh)
+			if (now >= refresh) {
 				solicit_routers (ndisc);
-			else if (*nextevent > refresh)
+				NM_NDISC_GET_PRIVATE (ndisc)->refresh_due = TRUE;
+			} else if (*nextevent > refresh)
 				*nextevent = refresh;
 		}
 		i++;
@@ -1075,9 +1178,10 @@ clean_dns_domains (NMNDisc *ndisc, gint32 now, NMNDiscConfigMap *changed, gint32
 			}
 
 			refresh = get_expiry_half (item);
-			if (now >= refresh)
+			if (now >= refresh) {
 				solicit_routers (ndisc);
-			else if (*nextevent > refresh)
+				NM_NDISC_GET_PRIVATE (ndisc)->refresh_due = TRUE;
+			} else if (*nextevent > refresh)
 				*nextevent = refresh;
 		}
 		i++;
@@ -1090,16 +1194,27 @@ static void
 check_timestamps (NMNDisc *ndisc, gint32 now, NMNDiscConfigMap changed)
 {
 	NMNDiscPrivate *priv = NM_NDISC_GET_PRIVATE (ndisc);
-	/* Use a magic date in the distant future (~68 years) */
-	gint32 nextevent = G_MAXINT32;
+	gint32 nextevent;
 
 	nm_clear_g_source (&priv->timeout_id);
 
-	clean_gateways (ndisc, now, &changed, &nextevent);
-	clean_addresses (ndisc, now, &changed, &nextevent);
-	clean_routes (ndisc, now, &changed, &nextevent);
-	clean_dns_servers (ndisc, now, &changed, &nextevent);
-	clean_dns_domains (ndisc, now, &changed, &nextevent);
+	/* @next_event is never later than the earliest expiry or refresh, so
+	 * unless it passed, there is nothing to clean up. */
+	if (   now >= priv->next_event
+	    || priv->refresh_due) {
+		/* Use a magic date in the distant future (~68 years) */
+		nextevent = G_MAXINT32;
+		priv->refresh_due = FALSE;
+
+		clean_gateways (ndisc, now, &changed, &nextevent);
+		clean_addresses (ndisc, now, &changed, &nextevent);
+		clean_routes (ndisc, now, &changed, &nextevent);
+		clean_dns_servers (ndisc, now, &changed, &nextevent);
+		clean_dns_domains (ndisc, now, &changed, &nextevent);
+
+		priv->next_event = nextevent;
+	} else
+		nextevent = priv->next_event;
 
 	if (changed)
 		_emit_config_change (ndisc, changed);
@@ -1232,6 +1347,7 @@ nm_ndisc_init (NMNDisc *ndisc)
 	rdata->gateways = g_array_new (FALSE, FALSE, sizeof (NMNDiscGateway));
 	rdata->addresses = g_array_new (FALSE, FALSE, sizeof (NMNDiscAddress));
 	rdata->routes = g_array_new (FALSE, FALSE, sizeof (NMNDiscRoute));
+	rdata->routes_idx = g_hash_table_new_full (_route_entry_hash, _route_entry_equal, _route_entry_free, NULL);
 	rdata->dns_servers = g_array_new (FALSE, FALSE, sizeof (NMNDiscDNSServer));
 	rdata->dns_domains = g_array_new (FALSE, FALSE, sizeof (NMNDiscDNSDomain));
 	g_array_set_clear_func (rdata->dns_domains, dns_domain_free);
@@ -1272,6 +1388,7 @@ finalize (GObject *object)
 	g_array_unref (rdata->gateways);
 	g_array_unref (rdata->addresses);
 	g_array_unref (rdata->routes);
+	g_hash_table_unref (rdata->routes_idx);
 	g_array_unref (rdata->dns_servers);
 	g_array_unref (rdata->dns_domains);
 
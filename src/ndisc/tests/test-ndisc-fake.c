@@ -520,6 +520,93 @@ test_dns_solicit_loop (void)
 	g_main_loop_unref (data.loop);
 }
 
+#define MANY_ROUTES_N 600
+
+static void
+test_many_routes_cb (NMNDisc *ndisc, const NMNDiscData *rdata, guint changed_int, TestData *data)
+{
+	NMNDiscConfigMap changed = changed_int;
+	guint n_high = 0;
+	guint i;
+
+	g_assert (changed & NM_NDISC_CONFIG_ROUTES);
+
+	if (data->counter == 0) {
+		g_assert_cmpint (rdata->routes_n, ==, MANY_ROUTES_N);
+		for (i = 0; i < rdata->routes_n; i++) {
+			g_assert_cmpint (rdata->routes[i].plen, ==, 48);
+			g_assert_cmpint (rdata->routes[i].lifetime, ==, 10);
+			g_assert_cmpint (rdata->routes[i].preference, ==, NM_ICMPV6_ROUTER_PREF_MEDIUM);
+		}
+	} else if (data->counter == 1) {
+		/* every third route got withdrawn, every third moved up. */
+		g_assert_cmpint (rdata->routes_n, ==, MANY_ROUTES_N - MANY_ROUTES_N / 3);
+		for (i = 0; i < rdata->routes_n; i++) {
+			const NMNDiscRoute *route = &rdata->routes[i];
+			guint idx = (route->network.s6_addr[4] << 8) | route->network.s6_addr[5];
+
+			g_assert_cmpint (idx % 3, !=, 1);
+			g_assert_cmpint (route->lifetime, ==, 20);
+			if (idx % 3 == 0) {
+				/* more preferable routes come first. */
+				g_assert_cmpint (i, ==, n_high);
+				g_assert_cmpint (route->preference, ==, NM_ICMPV6_ROUTER_PREF_HIGH);
+				n_high++;
+			} else
+				g_assert_cmpint (route->preference, ==, NM_ICMPV6_ROUTER_PREF_MEDIUM);
+		}
+		g_assert_cmpint (n_high, ==, MANY_ROUTES_N / 3);
+
+		g_assert (nm_fake_ndisc_done (NM_FAKE_NDISC (ndisc)));
+		g_main_loop_quit (data->loop);
+	}
+
+	data->counter++;
+}
+
+static void
+test_many_routes (void)
+{
+	NMFakeNDisc *ndisc = ndisc_new ();
+	guint32 now = nm_utils_get_monotonic_timestamp_s ();
+	TestData data = { g_main_loop_new (NULL, FALSE), 0, 0, now };
+	char network[INET6_ADDRSTRLEN];
+	guint id;
+	guint i;
+
+	/* Test a router announcing many more-specific routes (RFC 4191) */
+
+	id = nm_fake_ndisc_add_ra (ndisc, 1, NM_NDISC_DHCP_LEVEL_NONE, 4, 1500);
+	g_assert (id);
+	nm_fake_ndisc_add_gateway (ndisc, id, "fe80::1", now, 10, NM_ICMPV6_ROUTER_PREF_MEDIUM);
+	for (i = 0; i < MANY_ROUTES_N; i++) {
+		nm_sprintf_buf (network, "2001:db8:%x::", i);
+		nm_fake_ndisc_add_prefix (ndisc, id, network, 48, "fe80::1", now, 10, 10, NM_ICMPV6_ROUTER_PREF_MEDIUM);
+	}
+
+	id = nm_fake_ndisc_add_ra (ndisc, 1, NM_NDISC_DHCP_LEVEL_NONE, 4, 1500);
+	g_assert (id);
+	nm_fake_ndisc_add_gateway (ndisc, id, "fe80::1", now, 20, NM_ICMPV6_ROUTER_PREF_MEDIUM);
+	for (i = 0; i < MANY_ROUTES_N; i++) {
+		nm_sprintf_buf (network, "2001:db8:%x::", i);
+		nm_fake_ndisc_add_prefix (ndisc, id, network, 48, "fe80::1", now,
+		                          i % 3 == 1 ? 0 : 20, 0,
+		                          i % 3 == 0 ? NM_ICMPV6_ROUTER_PREF_HIGH : NM_ICMPV6_ROUTER_PREF_MEDIUM);
+	}
+
+	g_signal_connect (ndisc,
+	                  NM_NDISC_CONFIG_RECEIVED,
+	                  G_CALLBACK (test_many_routes_cb),
+	                  &data);
+
+	nm_ndisc_start (NM_NDISC (ndisc));
+	g_main_loop_run (data.loop);
+	g_assert_cmpint (data.counter, ==, 2);
+
+	g_object_unref (ndisc);
+	g_main_loop_unref (data.loop);
+}
+
 NMTST_DEFINE ();
 
 int
@@ -539,6 +626,7 @@ main (int argc, char **argv)
 	g_test_add_func ("/ndisc/preference-order", test_preference_order);
 	g_test_add_func ("/ndisc/preference-changed", test_preference_changed);
 	g_test_add_func ("/ndisc/dns-solicit-loop", test_dns_solicit_loop);
+	g_test_add_func ("/ndisc/many-routes", test_many_routes);
 
 	return g_test_run ();
 }
@@ -41,6 +41,7 @@ typedef struct {
 		 * "match-device" was unspecified. */
 		gboolean has;
 		GSList *spec;
+		NMMatchSpecDevice *spec_compiled;
 	} match_device;
 } MatchSectionInfo;
 
@@ -99,10 +100,16 @@ typedef struct {
 		char **arr;
 		GSList *specs;
 		GSList *specs_config;
+		NMMatchSpecDevice *specs_compiled;
+		NMMatchSpecDevice *specs_config_compiled;
 	} no_auto_default;
 
+	/* the device specs are parsed once and kept as NMMatchSpecDevice
+	 * for matching. The lists are kept to compare configurations. */
 	GSList *ignore_carrier;
+	NMMatchSpecDevice *ignore_carrier_compiled;
 	GSList *assume_ipv6ll_only;
+	NMMatchSpecDevice *assume_ipv6ll_only_compiled;
 
 	char *dns_mode;
 	char *rc_manager;
@@ -292,8 +299,8 @@ nm_config_data_get_no_auto_default_for_device (const NMConfigData *self, NMDevic
 	g_return_val_if_fail (NM_IS_DEVICE (device), FALSE);
 
 	priv = NM_CONFIG_DATA_GET_PRIVATE (self);
-	return    nm_device_spec_match_list (device, priv->no_auto_default.specs)
-	       || nm_device_spec_match_list (device, priv->no_auto_default.specs_config);
+	return    nm_device_spec_match_compiled (device, priv->no_auto_default.specs_compiled)
+	       || nm_device_spec_match_compiled (device, priv->no_auto_default.specs_config_compiled);
 }
 
 const char *
@@ -326,7 +333,7 @@ nm_config_data_get_ignore_carrier (const NMConfigData *self, NMDevice *device)
 	if (has_match)
 		m = nm_config_parse_boolean (value, -1);
 	else
-		m = nm_device_spec_match_list_full (device, NM_CONFIG_DATA_GET_PRIVATE (self)->ignore_carrier, -1);
+		m = nm_device_spec_match_compiled_full (device, NM_CONFIG_DATA_GET_PRIVATE (self)->ignore_carrier_compiled, -1);
 
 	if (NM_IN_SET (m, TRUE, FALSE))
 		return m;
@@ -341,7 +348,7 @@ nm_config_data_get_assume_ipv6ll_only (const NMConfigData *self, NMDevice *devic
 	g_return_val_if_fail (NM_IS_CONFIG_DATA (self), FALSE);
 	g_return_val_if_fail (NM_IS_DEVICE (device), FALSE);
 
-	return nm_device_spec_match_list (device, NM_CONFIG_DATA_GET_PRIVATE (self)->assume_ipv6ll_only);
+	return nm_device_spec_match_compiled (device, NM_CONFIG_DATA_GET_PRIVATE (self)->assume_ipv6ll_only_compiled);
 }
 
 GKeyFile *
@@ -592,6 +599,8 @@ static const struct {
 	{ NM_CONFIG_KEYFILE_GROUP_MAIN,    NM_CONFIG_KEYFILE_KEY_MAIN_DHCP,        NM_CONFIG_DEFAULT_MAIN_DHCP },
 	{ NM_CONFIG_KEYFILE_GROUP_LOGGING, "backend",                              NM_CONFIG_DEFAULT_LOGGING_BACKEND },
 	{ NM_CONFIG_KEYFILE_GROUP_LOGGING, "audit",                                NM_CONFIG_DEFAULT_LOGGING_AUDIT },
+	{ NM_CONFIG_KEYFILE_GROUP_LOGGING, NM_CONFIG_KEYFILE_KEY_LOGGING_RATE_LIMIT_BURST,    NM_CONFIG_DEFAULT_LOGGING_RATE_LIMIT_BURST },
+	{ NM_CONFIG_KEYFILE_GROUP_LOGGING, NM_CONFIG_KEYFILE_KEY_LOGGING_RATE_LIMIT_INTERVAL, NM_CONFIG_DEFAULT_LOGGING_RATE_LIMIT_INTERVAL },
 };
 
 void
@@ -1208,7 +1217,7 @@ _match_section_infos_lookup (const MatchSectionInfo *match_section_infos,
 
 		match = TRUE;
 		if (match_section_infos->match_device.has)
-			match = device && nm_device_spec_match_list (device, match_section_infos->match_device.spec);
+			match = device && nm_device_spec_match_compiled (device, match_section_infos->match_device.spec_compiled);
 
 		if (match) {
 			*out_value = value;
@@ -1291,6 +1300,7 @@ _get_connection_info_init (MatchSectionInfo *connection_info, GKeyFile *keyfile,
 	                                                               group,
 	                                                               "match-device",
 	                                                               &connection_info->match_device.has);
+	connection_info->match_device.spec_compiled = nm_match_spec_device_compile (connection_info->match_device.spec);
 	connection_info->stop_match = nm_config_keyfile_get_boolean (keyfile, group, "stop-match", FALSE);
 }
 
@@ -1304,6 +1314,7 @@ _match_section_infos_free (MatchSectionInfo *match_section_infos)
 	for (i = 0; match_section_infos[i].group_name; i++) {
 		g_free (match_section_infos[i].group_name);
 		g_slist_free_full (match_section_infos[i].match_device.spec, g_free);
+		nm_match_spec_device_free (match_section_infos[i].match_device.spec_compiled);
 	}
 	g_free (match_section_infos);
 }
@@ -1507,6 +1518,7 @@ set_property (GObject *object,
 			}
 			priv->no_auto_default.arr[j++] = NULL;
 			priv->no_auto_default.specs = g_slist_reverse (priv->no_auto_default.specs);
+			priv->no_auto_default.specs_compiled = nm_match_spec_device_compile (priv->no_auto_default.specs);
 		}
 		break;
 	default:
@@ -1550,9 +1562,12 @@ constructed (GObject *object)
 	priv->rc_manager = nm_strstrip (g_key_file_get_string (priv->keyfile, NM_CONFIG_KEYFILE_GROUP_MAIN, "rc-manager", NULL));
 
 	priv->ignore_carrier = nm_config_get_match_spec (priv->keyfile, NM_CONFIG_KEYFILE_GROUP_MAIN, "ignore-carrier", NULL);
+	priv->ignore_carrier_compiled = nm_match_spec_device_compile (priv->ignore_carrier);
 	priv->assume_ipv6ll_only = nm_config_get_match_spec (priv->keyfile, NM_CONFIG_KEYFILE_GROUP_MAIN, "assume-ipv6ll-only", NULL);
+	priv->assume_ipv6ll_only_compiled = nm_match_spec_device_compile (priv->assume_ipv6ll_only);
 
 	priv->no_auto_default.specs_config = nm_config_get_match_spec (priv->keyfile, NM_CONFIG_KEYFILE_GROUP_MAIN, "no-auto-default", NULL);
+	priv->no_auto_default.specs_config_compiled = nm_match_spec_device_compile (priv->no_auto_default.specs_config);
 
 	priv->global_dns = load_global_dns (priv->keyfile_user, FALSE);
 	if (!priv->global_dns)
@@ -1619,13 +1634,17 @@ finalize (GObject *gobject)
 
 	g_slist_free_full (priv->no_auto_default.specs, g_free);
 	g_slist_free_full (priv->no_auto_default.specs_config, g_free);
+	nm_match_spec_device_free (priv->no_auto_default.specs_compiled);
+	nm_match_spec_device_free (priv->no_auto_default.specs_config_compiled);
 	g_strfreev (priv->no_auto_default.arr);
 
 	g_free (priv->dns_mode);
 	g_free (priv->rc_manager);
 
 	g_slist_free_full (priv->ignore_carrier, g_free);
+	nm_match_spec_device_free (priv->ignore_carrier_compiled);
 	g_slist_free_full (priv->assume_ipv6ll_only, g_free);
+	nm_match_spec_device_free (priv->assume_ipv6ll_only_compiled);
 
 	nm_global_dns_config_free (priv->global_dns);
 
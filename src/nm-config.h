@@ -65,6 +65,9 @@
 #define NM_CONFIG_KEYFILE_KEY_MAIN_HOSTNAME_MODE            "hostname-mode"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_SLAVES_ORDER             "slaves-order"
 #define NM_CONFIG_KEYFILE_KEY_LOGGING_BACKEND               "backend"
+#define NM_CONFIG_KEYFILE_KEY_LOGGING_ASYNC                 "async"
+#define NM_CONFIG_KEYFILE_KEY_LOGGING_RATE_LIMIT_BURST      "rate-limit-burst"
+#define NM_CONFIG_KEYFILE_KEY_LOGGING_RATE_LIMIT_INTERVAL   "rate-limit-interval"
 #define NM_CONFIG_KEYFILE_KEY_CONFIG_ENABLE                 "enable"
 #define NM_CONFIG_KEYFILE_KEY_ATOMIC_SECTION_WAS            ".was"
 #define NM_CONFIG_KEYFILE_KEY_KEYFILE_PATH                  "path"
@@ -193,6 +196,11 @@ extern char *_nm_config_match_env;
 #define NM_CONFIG_DEFAULT_MAIN_AUTH_POLKIT_BOOL     (nm_streq (""NM_CONFIG_DEFAULT_MAIN_AUTH_POLKIT, "true"))
 #define NM_CONFIG_DEFAULT_LOGGING_AUDIT_BOOL        (nm_streq (""NM_CONFIG_DEFAULT_LOGGING_AUDIT, "true"))
 
+#define NM_CONFIG_DEFAULT_LOGGING_RATE_LIMIT_BURST_INT      0
+#define NM_CONFIG_DEFAULT_LOGGING_RATE_LIMIT_BURST          G_STRINGIFY (NM_CONFIG_DEFAULT_LOGGING_RATE_LIMIT_BURST_INT)
+#define NM_CONFIG_DEFAULT_LOGGING_RATE_LIMIT_INTERVAL_INT   0
+#define NM_CONFIG_DEFAULT_LOGGING_RATE_LIMIT_INTERVAL       G_STRINGIFY (NM_CONFIG_DEFAULT_LOGGING_RATE_LIMIT_INTERVAL_INT)
+
 typedef enum {
 	NM_CONFIG_DEVICE_STATE_MANAGED_TYPE_UNKNOWN   = -1,
 	NM_CONFIG_DEVICE_STATE_MANAGED_TYPE_UNMANAGED = 0,
@@ -77,11 +77,13 @@ static guint signals[LAST_SIGNAL] = { 0 };
         const NMLogLevel __level = (level); \
         \
         if (nm_logging_enabled (__level, _NMLOG2_DOMAIN)) { \
+            const char *__ifname = cb_data->ifspec ? &cb_data->ifspec[3] : NULL; \
+            \
             _nm_log (__level, _NMLOG2_DOMAIN, 0, \
-                        &cb_data->ifspec[3], NULL, \
+                        __ifname, NULL, \
                         "connectivity: (%s) " \
                         _NM_UTILS_MACRO_FIRST (__VA_ARGS__), \
-                        &cb_data->ifspec[3] \
+                        __ifname ?: "*" \
                         _NM_UTILS_MACRO_REST (__VA_ARGS__)); \
         } \
     } G_STMT_END
@@ -199,7 +201,7 @@ multi_timer_cb (CURLM *multi, long timeout_ms, void *userdata)
 
 	nm_clear_g_source (&priv->curl_timer);
 	if (timeout_ms != -1)
-		priv->curl_timer = g_timeout_add (timeout_ms * 1000, curl_timeout_cb, self);
+		priv->curl_timer = g_timeout_add (timeout_ms, curl_timeout_cb, self);
 
 	return 0;
 }
@@ -220,7 +222,7 @@ curl_socketevent_cb (GIOChannel *ch, GIOCondition condition, gpointer data)
 	if (condition & G_IO_OUT)
 		action |= CURL_CSELECT_OUT;
 
-	ret = curl_multi_socket_action (priv->curl_mhandle, fd, 0, &pending_conn);
+	ret = curl_multi_socket_action (priv->curl_mhandle, fd, action, &pending_conn);
 
 	curl_check_connectivity (priv->curl_mhandle, ret);
 
@@ -329,6 +331,18 @@ timeout_cb (gpointer user_data)
 	return G_SOURCE_REMOVE;
 }
 
+/**
+ * nm_connectivity_check_async:
+ * @self: the #NMConnectivity
+ * @iface: (allow-none): the interface to bind the check to
+ * @callback: the callback invoked with the result
+ * @user_data: user data for @callback
+ *
+ * Starts a connectivity check. The request is sent out via @iface, so that
+ * checks for different devices run concurrently on the same multi handle and
+ * each yields the state of its own uplink. If @iface is %NULL, the request
+ * is not bound to an interface and follows the routing table.
+ */
 void
 nm_connectivity_check_async (NMConnectivity      *self,
                              const char          *iface,
@@ -353,7 +367,8 @@ nm_connectivity_check_async (NMConnectivity      *self,
 
 		cb_data->curl_ehandle = ehandle;
 		cb_data->request_headers = curl_slist_append (NULL, "Connection: close");
-		cb_data->ifspec = g_strdup_printf ("if!%s", iface);
+		if (iface)
+			cb_data->ifspec = g_strdup_printf ("if!%s", iface);
 		cb_data->simple = simple;
 		if (priv->response)
 			cb_data->response = g_strdup (priv->response);
@@ -367,7 +382,8 @@ nm_connectivity_check_async (NMConnectivity      *self,
 		curl_easy_setopt (ehandle, CURLOPT_HEADERDATA, cb_data);
 		curl_easy_setopt (ehandle, CURLOPT_PRIVATE, cb_data);
 		curl_easy_setopt (ehandle, CURLOPT_HTTPHEADER, cb_data->request_headers);
-		curl_easy_setopt (ehandle, CURLOPT_INTERFACE, cb_data->ifspec);
+		if (cb_data->ifspec)
+			curl_easy_setopt (ehandle, CURLOPT_INTERFACE, cb_data->ifspec);
 		curl_multi_add_handle (priv->curl_mhandle, ehandle);
 
 		cb_data->timeout_id = g_timeout_add_seconds (30, timeout_cb, cb_data);
@@ -375,7 +391,7 @@ nm_connectivity_check_async (NMConnectivity      *self,
 		_LOG2D ("sending request to '%s'", priv->uri);
 		return;
 	} else {
-		_LOGD ("(%s) faking request. Connectivity check disabled", iface);
+		_LOGD ("(%s) faking request. Connectivity check disabled", iface ?: "*");
 	}
 
 	g_simple_async_result_set_op_res_gssize (simple, NM_CONNECTIVITY_UNKNOWN);
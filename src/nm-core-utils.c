@@ -1527,6 +1527,342 @@ nm_match_spec_device (const GSList *specs,
 	return match;
 }
 
+/*****************************************************************************/
+
+/* A list of device specs, parsed once. The result of evaluating it is
+ * identical to nm_match_spec_device() on the original list, but exact
+ * interface names, device types, drivers and MAC addresses are looked
+ * up in hash tables and patterns are compiled. */
+
+typedef struct {
+	char *driver;
+	GPatternSpec *version;
+} MatchSpecDriver;
+
+typedef struct {
+	guint32 a;
+	guint32 b;
+	guint32 c;
+} MatchSpecSubchannels;
+
+typedef struct {
+	bool any;
+	GHashTable *interface_names;
+	GPtrArray *interface_name_patterns;
+	GHashTable *device_types;
+	GHashTable *hwaddrs;
+	GHashTable *drivers;
+	GPtrArray *driver_versions;
+	GArray *s390_subchannels;
+} MatchSpecSet;
+
+struct _NMMatchSpecDevice {
+	MatchSpecSet match;
+	MatchSpecSet except;
+};
+
+static char *
+_match_spec_hwaddr_key (const guint8 *bin, gsize len)
+{
+	/* nm_utils_hwaddr_matches() only compares the last 8 bytes of
+	 * an infiniband address. */
+	if (len == INFINIBAND_ALEN) {
+		gs_free char *s = nm_utils_hwaddr_ntoa (&bin[INFINIBAND_ALEN - 8], 8);
+
+		return g_strdup_printf ("ib/%s", s);
+	}
+	return nm_utils_hwaddr_ntoa (bin, len);
+}
+
+static gboolean
+_match_spec_set_add_hwaddr (MatchSpecSet *set, const char *spec_str)
+{
+	guint8 bin[NM_UTILS_HWADDR_LEN_MAX];
+	gsize len;
+
+	if (!_nm_utils_hwaddr_aton (spec_str, bin, sizeof (bin), &len))
+		return FALSE;
+	if (!set->hwaddrs)
+		set->hwaddrs = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, NULL);
+	g_hash_table_add (set->hwaddrs, _match_spec_hwaddr_key (bin, len));
+	return TRUE;
+}
+
+static void
+_match_spec_set_add_str (GHashTable **p_table, const char *str)
+{
+	if (!*p_table)
+		*p_table = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, NULL);
+	g_hash_table_add (*p_table, g_strdup (str));
+}
+
+static void
+_match_spec_set_add (MatchSpecSet *set,
+                     const char *spec_str,
+                     gboolean allow_fuzzy)
+{
+	if (spec_str[0] == '*' && spec_str[1] == '\0') {
+		set->any = TRUE;
+		return;
+	}
+
+	if (_MATCH_CHECK (spec_str, DEVICE_TYPE_TAG)) {
+		_match_spec_set_add_str (&set->device_types, spec_str);
+		return;
+	}
+
+	if (_MATCH_CHECK (spec_str, MAC_TAG)) {
+		_match_spec_set_add_hwaddr (set, spec_str);
+		return;
+	}
+
+	if (_MATCH_CHECK (spec_str, INTERFACE_NAME_TAG)) {
+		gboolean use_pattern = FALSE;
+
+		if (spec_str[0] == '=')
+			spec_str += 1;
+		else {
+			if (spec_str[0] == '~')
+				spec_str += 1;
+			use_pattern = TRUE;
+		}
+
+		/* a glob without wildcards matches the same as the exact name. */
+		if (use_pattern && strpbrk (spec_str, "*?")) {
+			if (!set->interface_name_patterns)
+				set->interface_name_patterns = g_ptr_array_new_with_free_func ((GDestroyNotify) g_pattern_spec_free);
+			g_ptr_array_add (set->interface_name_patterns, g_pattern_spec_new (spec_str));
+		} else
+			_match_spec_set_add_str (&set->interface_names, spec_str);
+		return;
+	}
+
+	if (_MATCH_CHECK (spec_str, DRIVER_TAG)) {
+		const char *t;
+		MatchSpecDriver *d;
+
+		/* see match_device_eval() for the supported formats. */
+		t = strrchr (spec_str, '/');
+		if (!t) {
+			_match_spec_set_add_str (&set->drivers, spec_str);
+			return;
+		}
+
+		d = g_slice_new (MatchSpecDriver);
+		d->driver = g_strndup (spec_str, t - spec_str);
+		d->version = g_pattern_spec_new (&t[1]);
+		if (!set->driver_versions)
+			set->driver_versions = g_ptr_array_new ();
+		g_ptr_array_add (set->driver_versions, d);
+		return;
+	}
+
+	if (_MATCH_CHECK (spec_str, SUBCHAN_TAG)) {
+		MatchSpecSubchannels sc;
+
+		if (match_device_s390_subchannels_parse (spec_str, &sc.a, &sc.b, &sc.c)) {
+			if (!set->s390_subchannels)
+				set->s390_subchannels = g_array_new (FALSE, FALSE, sizeof (MatchSpecSubchannels));
+			g_array_append_val (set->s390_subchannels, sc);
+		}
+		return;
+	}
+
+	if (allow_fuzzy) {
+		_match_spec_set_add_hwaddr (set, spec_str);
+		_match_spec_set_add_str (&set->interface_names, spec_str);
+	}
+}
+
+static void
+_match_spec_set_clear (MatchSpecSet *set)
+{
+	guint i;
+
+	g_clear_pointer (&set->interface_names, g_hash_table_unref);
+	g_clear_pointer (&set->interface_name_patterns, g_ptr_array_unref);
+	g_clear_pointer (&set->device_types, g_hash_table_unref);
+	g_clear_pointer (&set->hwaddrs, g_hash_table_unref);
+	g_clear_pointer (&set->drivers, g_hash_table_unref);
+	if (set->driver_versions) {
+		for (i = 0; i < set->driver_versions->len; i++) {
+			MatchSpecDriver *d = set->driver_versions->pdata[i];
+
+			g_free (d->driver);
+			g_pattern_spec_free (d->version);
+			g_slice_free (MatchSpecDriver, d);
+		}
+		g_ptr_array_unref (set->driver_versions);
+		set->driver_versions = NULL;
+	}
+	if (set->s390_subchannels) {
+		g_array_unref (set->s390_subchannels);
+		set->s390_subchannels = NULL;
+	}
+}
+
+typedef struct {
+	const char *interface_name;
+	const char *device_type;
+	const char *driver;
+	const char *driver_version;
+	const char *hwaddr_key;
+	bool has_s390_subchannels;
+	MatchSpecSubchannels s390_subchannels;
+} MatchSpecDeviceData;
+
+static gboolean
+_match_spec_set_eval (const MatchSpecSet *set,
+                      const MatchSpecDeviceData *data)
+{
+	guint i;
+
+	if (set->any)
+		return TRUE;
+
+	if (data->interface_name) {
+		if (   set->interface_names
+		    && g_hash_table_contains (set->interface_names, data->interface_name))
+			return TRUE;
+		if (set->interface_name_patterns) {
+			for (i = 0; i < set->interface_name_patterns->len; i++) {
+				if (g_pattern_match_string (set->interface_name_patterns->pdata[i], data->interface_name))
+					return TRUE;
+			}
+		}
+	}
+
+	if (   data->device_type
+	    && set->device_types
+	    && g_hash_table_contains (set->device_types, data->device_type))
+		return TRUE;
+
+	if (   data->hwaddr_key
+	    && set->hwaddrs
+	    && g_hash_table_contains (set->hwaddrs, data->hwaddr_key))
+		return TRUE;
+
+	if (data->driver) {
+		if (   set->drivers
+		    && g_hash_table_contains (set->drivers, data->driver))
+			return TRUE;
+		if (set->driver_versions) {
+			for (i = 0; i < set->driver_versions->len; i++) {
+				const MatchSpecDriver *d = set->driver_versions->pdata[i];
+
+				if (   strncmp (d->driver, data->driver, strlen (d->driver)) == 0
+				    && g_pattern_match_string (d->version, data->driver_version ?: ""))
+					return TRUE;
+			}
+		}
+	}
+
+	if (   data->has_s390_subchannels
+	    && set->s390_subchannels) {
+		for (i = 0; i < set->s390_subchannels->len; i++) {
+			const MatchSpecSubchannels *sc = &g_array_index (set->s390_subchannels, MatchSpecSubchannels, i);
+
+			if (   sc->a == data->s390_subchannels.a
+			    && sc->b == data->s390_subchannels.b
+			    && sc->c == data->s390_subchannels.c)
+				return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+/**
+ * nm_match_spec_device_compile:
+ * @specs: (element-type utf8): a list of device specs
+ *
+ * Returns: (transfer full): the parsed @specs, to be evaluated with
+ *   nm_match_spec_device_compiled(). Returns %NULL if @specs contains
+ *   no specs, which never matches.
+ */
+NMMatchSpecDevice *
+nm_match_spec_device_compile (const GSList *specs)
+{
+	NMMatchSpecDevice *self = NULL;
+	const GSList *iter;
+
+	for (iter = specs; iter; iter = iter->next) {
+		const char *spec_str = iter->data;
+		gboolean except;
+
+		if (!spec_str || !*spec_str)
+			continue;
+
+		if (!self)
+			self = g_slice_new0 (NMMatchSpecDevice);
+
+		spec_str = match_except (spec_str, &except);
+		if (except)
+			_match_spec_set_add (&self->except, spec_str, FALSE);
+		else
+			_match_spec_set_add (&self->match, spec_str, TRUE);
+	}
+
+	return self;
+}
+
+void
+nm_match_spec_device_free (NMMatchSpecDevice *self)
+{
+	if (!self)
+		return;
+	_match_spec_set_clear (&self->match);
+	_match_spec_set_clear (&self->except);
+	g_slice_free (NMMatchSpecDevice, self);
+}
+
+NMMatchSpecMatchType
+nm_match_spec_device_compiled (const NMMatchSpecDevice *self,
+                               const char *interface_name,
+                               const char *device_type,
+                               const char *driver,
+                               const char *driver_version,
+                               const char *hwaddr,
+                               const char *s390_subchannels)
+{
+	gs_free char *hwaddr_key = NULL;
+	MatchSpecDeviceData data = {
+	    .interface_name = interface_name,
+	    .device_type = nm_str_not_empty (device_type),
+	    .driver = nm_str_not_empty (driver),
+	    .driver_version = nm_str_not_empty (driver_version),
+	};
+
+	nm_assert (!hwaddr || nm_utils_hwaddr_valid (hwaddr, -1));
+
+	if (!self)
+		return NM_MATCH_SPEC_NO_MATCH;
+
+	if (hwaddr && (self->match.hwaddrs || self->except.hwaddrs)) {
+		guint8 bin[NM_UTILS_HWADDR_LEN_MAX];
+		gsize len;
+
+		if (_nm_utils_hwaddr_aton (hwaddr, bin, sizeof (bin), &len))
+			data.hwaddr_key = hwaddr_key = _match_spec_hwaddr_key (bin, len);
+	}
+
+	if (   s390_subchannels
+	    && (self->match.s390_subchannels || self->except.s390_subchannels)) {
+		data.has_s390_subchannels = match_device_s390_subchannels_parse (s390_subchannels,
+		                                                                 &data.s390_subchannels.a,
+		                                                                 &data.s390_subchannels.b,
+		                                                                 &data.s390_subchannels.c);
+	}
+
+	if (_match_spec_set_eval (&self->except, &data))
+		return NM_MATCH_SPEC_NEG_MATCH;
+	if (_match_spec_set_eval (&self->match, &data))
+		return NM_MATCH_SPEC_MATCH;
+	return NM_MATCH_SPEC_NO_MATCH;
+}
+
+/*****************************************************************************/
+
 static gboolean
 match_config_eval (const char *str, const char *tag, guint cur_nm_version)
 {
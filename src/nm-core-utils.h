@@ -213,6 +213,17 @@ NMMatchSpecMatchType nm_match_spec_device (const GSList *specs,
                                            const char *device_type,
                                            const char *hwaddr,
                                            const char *s390_subchannels);
+
+NMMatchSpecDevice *nm_match_spec_device_compile (const GSList *specs);
+void nm_match_spec_device_free (NMMatchSpecDevice *self);
+NMMatchSpecMatchType nm_match_spec_device_compiled (const NMMatchSpecDevice *self,
+                                                    const char *interface_name,
+                                                    const char *device_type,
+                                                    const char *driver,
+                                                    const char *driver_version,
+                                                    const char *hwaddr,
+                                                    const char *s390_subchannels);
+
 NMMatchSpecMatchType nm_match_spec_config (const GSList *specs,
                                            guint nm_version,
                                            const char *env);
@@ -25,6 +25,8 @@
 #include <stdarg.h>
 #include <string.h>
 
+#include "nm-utils/c-list.h"
+#include "nm-utils/nm-hash-utils.h"
 #include "nm-bus-manager.h"
 
 #include "devices/nm-device.h"
@@ -39,6 +41,13 @@
 
 static gboolean quitting = FALSE;
 
+/* PropertiesChanged signals of all objects are emitted together from one
+ * idle handler. Objects with pending notifications are queued in
+ * @notify_pending_lst_head in the order of their first notification. */
+static CList notify_pending_lst_head = C_LIST_INIT (notify_pending_lst_head);
+static guint notify_idle_id;
+static NMExportedObjectNotifyStats notify_stats;
+
 /*****************************************************************************/
 
 NM_GOBJECT_PROPERTIES_DEFINE (NMExportedObject,
@@ -49,16 +58,24 @@ typedef struct {
 	GDBusInterfaceSkeleton *interface;
 	guint property_changed_signal_id;
 	GHashTable *pending_notifies;
+
+	/* hashes of the values last emitted in PropertiesChanged, to skip
+	 * notifications for properties that didn't change. Only the hashes
+	 * are kept, to not pin the values for the lifetime of the object.
+	 * The table is dropped together with the skeletons on unexport. */
+	GHashTable *emitted_hashes;
 } InterfaceData;
 
 typedef struct _NMExportedObjectPrivate {
 	NMBusManager *bus_mgr;
 	char *path;
 
+	NMExportedObject *self;
+
 	InterfaceData *interfaces;
 	guint num_interfaces;
 
-	guint notify_idle_id;
+	CList notify_pending_lst;
 
 #ifdef _ASSERT_NO_EARLY_EXPORT
 	bool _constructed:1;
@@ -505,6 +522,10 @@ nm_exported_object_create_skeletons (NMExportedObject *self,
 		                                                  g_direct_equal,
 		                                                  NULL,
 		                                                  (GDestroyNotify) g_variant_unref);
+		ifdata->emitted_hashes = g_hash_table_new_full (g_direct_hash,
+		                                                g_direct_equal,
+		                                                NULL,
+		                                                g_free);
 	}
 	nm_assert (i == 0);
 
@@ -559,6 +580,7 @@ nm_exported_object_destroy_skeletons (NMExportedObject *self)
 		g_dbus_object_skeleton_remove_interface ((GDBusObjectSkeleton *) self, ifdata->interface);
 		nm_exported_object_skeleton_release (ifdata->interface);
 		g_hash_table_destroy (ifdata->pending_notifies);
+		g_hash_table_destroy (ifdata->emitted_hashes);
 	}
 
 	g_slice_free1 (sizeof (InterfaceData) * n, priv->interfaces);
@@ -722,7 +744,7 @@ nm_exported_object_unexport (NMExportedObject *self)
 
 	g_clear_pointer (&priv->path, g_free);
 
-	nm_clear_g_source (&priv->notify_idle_id);
+	c_list_unlink_init (&priv->notify_pending_lst);
 
 	_notify (self, PROP_PATH);
 }
@@ -790,8 +812,23 @@ nm_exported_object_class_set_quitting (void)
 typedef struct {
 	const char *property_name;
 	GVariant *variant;
+	guint64 hash;
 } PendingNotifiesItem;
 
+static guint64
+_variant_hash (GVariant *variant)
+{
+	NMHashState h;
+
+	/* a 64 bit siphash of the type and the serialized data. A different
+	 * type always gives a different input, and for the same type, the
+	 * data of equal values in normal form are identical. */
+	nm_hash_init (&h, 1605458683u);
+	nm_hash_update_str (&h, g_variant_get_type_string (variant));
+	nm_hash_update_mem (&h, g_variant_get_data (variant), g_variant_get_size (variant));
+	return nm_hash_complete_u64 (&h);
+}
+
 static int
 _sort_pending_notifies (gconstpointer a, gconstpointer b, gpointer       user_data)
 {
@@ -799,21 +836,19 @@ _sort_pending_notifies (gconstpointer a, gconstpointer b, gpointer       user_da
 	               ((const PendingNotifiesItem *) b)->property_name);
 }
 
-static gboolean
-idle_emit_properties_changed (gpointer self)
+static void
+_emit_properties_changed (NMExportedObject *self)
 {
-	NMExportedObjectPrivate *priv = NM_EXPORTED_OBJECT_GET_PRIVATE (NM_EXPORTED_OBJECT (self));
+	NMExportedObjectPrivate *priv = NM_EXPORTED_OBJECT_GET_PRIVATE (self);
 	guint k;
 
-	priv->notify_idle_id = 0;
-
 	for (k = 0; k < priv->num_interfaces; k++) {
 		InterfaceData *ifdata = &priv->interfaces[k];
 		gs_unref_variant GVariant *variant = NULL;
 		PendingNotifiesItem *values;
 		GVariantBuilder notifies;
 		GHashTableIter hash_iter;
-		guint i, n;
+		guint i, n, n_changed;
 
 		n = g_hash_table_size (ifdata->pending_notifies);
 		if (n == 0)
@@ -827,19 +862,45 @@ idle_emit_properties_changed (gpointer self)
 		 * "n" is small (determined by the number of GObject properties). */
 		values = g_alloca (sizeof (values[0]) * n);
 
-		i = 0;
+		/* Drop the properties whose value is the same as in the
+		 * last emitted signal. */
+		n_changed = 0;
 		g_hash_table_iter_init (&hash_iter, ifdata->pending_notifies);
-		while (g_hash_table_iter_next (&hash_iter, (gpointer) &values[i].property_name, (gpointer) &values[i].variant))
-			i++;
-		nm_assert (i == n);
+		while (g_hash_table_iter_next (&hash_iter, (gpointer) &values[n_changed].property_name, (gpointer) &values[n_changed].variant)) {
+			const guint64 *emitted;
+
+			values[n_changed].hash = _variant_hash (values[n_changed].variant);
+			emitted = g_hash_table_lookup (ifdata->emitted_hashes, values[n_changed].property_name);
+			if (   emitted
+			    && *emitted == values[n_changed].hash) {
+				notify_stats.n_properties_unchanged++;
+				continue;
+			}
+			n_changed++;
+		}
+		nm_assert (n_changed <= n);
+
+		if (n_changed == 0) {
+			g_hash_table_remove_all (ifdata->pending_notifies);
+			continue;
+		}
 
-		g_qsort_with_data (values, n, sizeof (values[0]), _sort_pending_notifies, NULL);
+		g_qsort_with_data (values, n_changed, sizeof (values[0]), _sort_pending_notifies, NULL);
 
 		g_variant_builder_init (&notifies, G_VARIANT_TYPE_VARDICT);
-		for (i = 0; i < n; i++)
+		for (i = 0; i < n_changed; i++) {
+			guint64 *emitted;
+
 			g_variant_builder_add (&notifies, "{sv}", values[i].property_name, values[i].variant);
-		variant = g_variant_ref_sink (g_variant_builder_end (&notifies));
 
+			emitted = g_hash_table_lookup (ifdata->emitted_hashes, values[i].property_name);
+			if (!emitted) {
+				emitted = g_new (guint64, 1);
+				g_hash_table_insert (ifdata->emitted_hashes, (gpointer) values[i].property_name, emitted);
+			}
+			*emitted = values[i].hash;
+		}
+		variant = g_variant_ref_sink (g_variant_builder_end (&notifies));
 
 		if (_LOG2D_ENABLED ()) {
 			gs_free char *notification = g_variant_print (variant, TRUE);
@@ -849,14 +910,65 @@ idle_emit_properties_changed (gpointer self)
 			        notification);
 		}
 
+		notify_stats.n_signals++;
+		notify_stats.n_properties += n_changed;
+
 		g_signal_emit (ifdata->interface, ifdata->property_changed_signal_id, 0, variant);
 
 		g_hash_table_remove_all (ifdata->pending_notifies);
 	}
+}
+
+static gboolean
+idle_emit_properties_changed (gpointer user_data)
+{
+	CList pending_lst_head = C_LIST_INIT (pending_lst_head);
+	NMExportedObjectPrivate *priv;
+	guint n_objects = 0;
+
+	notify_idle_id = 0;
+	notify_stats.n_flushes++;
+
+	/* Objects that get a notification while emitting are queued again
+	 * and handled by the next flush. */
+	c_list_splice (&pending_lst_head, &notify_pending_lst_head);
+
+	while (!c_list_is_empty (&pending_lst_head)) {
+		gs_unref_object NMExportedObject *self = NULL;
+
+		priv = c_list_first_entry (&pending_lst_head, NMExportedObjectPrivate, notify_pending_lst);
+		c_list_unlink_init (&priv->notify_pending_lst);
+
+		self = g_object_ref (priv->self);
+		_emit_properties_changed (self);
+		n_objects++;
+	}
+
+	_LOG2T ("flush #%llu: %u objects (total %llu signals, %llu properties, %llu unchanged skipped)",
+	        (unsigned long long) notify_stats.n_flushes,
+	        n_objects,
+	        (unsigned long long) notify_stats.n_signals,
+	        (unsigned long long) notify_stats.n_properties,
+	        (unsigned long long) notify_stats.n_properties_unchanged);
 
 	return G_SOURCE_REMOVE;
 }
 
+/**
+ * nm_exported_object_get_notify_stats:
+ * @out_stats: (out): the counters
+ *
+ * Returns counters about the emission of the PropertiesChanged
+ * signals of all exported objects since startup.
+ */
+void
+nm_exported_object_get_notify_stats (NMExportedObjectNotifyStats *out_stats)
+{
+	g_return_if_fail (out_stats);
+
+	*out_stats = notify_stats;
+}
+
 static void
 nm_exported_object_notify (GObject *object, GParamSpec *pspec)
 {
@@ -962,8 +1074,12 @@ vtype_found:
 	} else
 		g_variant_unref (value_variant);
 
-	if (!priv->notify_idle_id)
-		priv->notify_idle_id = g_idle_add (idle_emit_properties_changed, self);
+	notify_stats.n_notifies++;
+
+	if (!c_list_is_linked (&priv->notify_pending_lst))
+		c_list_link_tail (&notify_pending_lst_head, &priv->notify_pending_lst);
+	if (!notify_idle_id)
+		notify_idle_id = g_idle_add (idle_emit_properties_changed, NULL);
 }
 
 /*****************************************************************************/
@@ -992,6 +1108,8 @@ nm_exported_object_init (NMExportedObject *self)
 
 	priv = G_TYPE_INSTANCE_GET_PRIVATE (self, NM_TYPE_EXPORTED_OBJECT, NMExportedObjectPrivate);
 	self->_priv = priv;
+	priv->self = self;
+	c_list_init (&priv->notify_pending_lst);
 }
 
 static void
@@ -1028,11 +1146,22 @@ dispose (GObject *object)
 	} else if (nm_clear_g_free (&priv->path))
 		_notify (self, PROP_PATH);
 
-	nm_clear_g_source (&priv->notify_idle_id);
+	c_list_unlink_init (&priv->notify_pending_lst);
 
 	G_OBJECT_CLASS (nm_exported_object_parent_class)->dispose (object);
 }
 
+static void
+finalize (GObject *object)
+{
+	NMExportedObjectPrivate *priv = NM_EXPORTED_OBJECT_GET_PRIVATE ((NMExportedObject *) object);
+
+	/* a notification might have been queued after dispose(). */
+	c_list_unlink_init (&priv->notify_pending_lst);
+
+	G_OBJECT_CLASS (nm_exported_object_parent_class)->finalize (object);
+}
+
 static void
 nm_exported_object_class_init (NMExportedObjectClass *klass)
 {
@@ -1043,6 +1172,7 @@ nm_exported_object_class_init (NMExportedObjectClass *klass)
 	object_class->constructed = constructed;
 	object_class->notify = nm_exported_object_notify;
 	object_class->dispose = dispose;
+	object_class->finalize = finalize;
 	object_class->get_property = get_property;
 
 	obj_properties[PROP_PATH] =
@@ -79,6 +79,21 @@ gboolean    nm_exported_object_is_exported (NMExportedObject *self);
 void        nm_exported_object_unexport    (NMExportedObject *self);
 GDBusInterfaceSkeleton *nm_exported_object_get_interface_by_type (NMExportedObject *self, GType interface_type);
 
+typedef struct {
+	/* number of idle flushes of pending notifications. */
+	guint64 n_flushes;
+	/* number of GObject notifications for exported D-Bus properties. */
+	guint64 n_notifies;
+	/* number of emitted PropertiesChanged signals. */
+	guint64 n_signals;
+	/* number of properties in the emitted signals. */
+	guint64 n_properties;
+	/* number of properties not emitted, because their value didn't change. */
+	guint64 n_properties_unchanged;
+} NMExportedObjectNotifyStats;
+
+void nm_exported_object_get_notify_stats (NMExportedObjectNotifyStats *out_stats);
+
 void        _nm_exported_object_clear_and_unexport (NMExportedObject **location);
 #define nm_exported_object_clear_and_unexport(location) _nm_exported_object_clear_and_unexport ((NMExportedObject **) (location))
 
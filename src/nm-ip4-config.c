@@ -29,6 +29,7 @@
 #include <linux/rtnetlink.h>
 
 #include "nm-utils/nm-dedup-multi.h"
+#include "nm-utils/nm-hash-utils.h"
 
 #include "nm-utils.h"
 #include "platform/nmp-object.h"
@@ -306,6 +307,11 @@ typedef struct {
 	GVariant *routes_variant;
 	NMDedupMultiIndex *multi_idx;
 	const NMPObject *best_default_route;
+
+	/* cached hash of the fields compared by nm_ip4_config_equal(),
+	 * or zero if it needs to be recomputed. */
+	guint64 equal_hash;
+
 	union {
 		NMIPConfigDedupMultiIdxType idx_ip4_addresses_;
 		NMDedupMultiIdxType idx_ip4_addresses;
@@ -502,11 +508,20 @@ nmtst_ip4_config_get_gateway (NMIP4Config *config)
 
 /*****************************************************************************/
 
+static void
+_notify_hashed (NMIP4Config *self, _PropertyEnums prop)
+{
+	/* notify about a change to a property that is part of the equal-hash. */
+	NM_IP4_CONFIG_GET_PRIVATE (self)->equal_hash = 0;
+	_notify (self, prop);
+}
+
 static void
 _notify_addresses (NMIP4Config *self)
 {
 	NMIP4ConfigPrivate *priv = NM_IP4_CONFIG_GET_PRIVATE (self);
 
+	priv->equal_hash = 0;
 	nm_clear_g_variant (&priv->address_data_variant);
 	nm_clear_g_variant (&priv->addresses_variant);
 	_notify (self, PROP_ADDRESS_DATA);
@@ -519,6 +534,7 @@ _notify_routes (NMIP4Config *self)
 	NMIP4ConfigPrivate *priv = NM_IP4_CONFIG_GET_PRIVATE (self);
 
 	nm_assert (priv->best_default_route == _nm_ip4_config_best_default_route_find (self));
+	priv->equal_hash = 0;
 	nm_clear_g_variant (&priv->route_data_variant);
 	nm_clear_g_variant (&priv->routes_variant);
 	_notify (self, PROP_ROUTE_DATA);
@@ -646,7 +662,7 @@ nm_ip4_config_capture (NMDedupMultiIndex *multi_idx, NMPlatform *platform, int i
 			                                 rc_contents,
 			                                 priv->nameservers,
 			                                 priv->dns_options))
-				_notify (self, PROP_NAMESERVERS);
+				_notify_hashed (self, PROP_NAMESERVERS);
 		}
 	}
 
@@ -788,10 +804,11 @@ nm_ip4_config_commit (const NMIP4Config *self,
 	routes = nm_dedup_multi_objs_to_ptr_array_head (nm_ip4_config_lookup_routes (self),
 	                                                NULL, NULL);
 
-	routes_prune = nm_platform_ip_route_get_prune_list (platform,
-	                                                    AF_INET,
-	                                                    ifindex,
-	                                                    route_table_sync);
+	routes_prune = nm_platform_ip_route_get_prune_list_delta (platform,
+	                                                          AF_INET,
+	                                                          ifindex,
+	                                                          routes,
+	                                                          route_table_sync);
 
 	nm_platform_ip4_address_sync (platform, ifindex, addresses);
 
@@ -2215,7 +2232,7 @@ nm_ip4_config_reset_nameservers (NMIP4Config *self)
 
 	if (priv->nameservers->len != 0) {
 		g_array_set_size (priv->nameservers, 0);
-		_notify (self, PROP_NAMESERVERS);
+		_notify_hashed (self, PROP_NAMESERVERS);
 	}
 }
 
@@ -2232,7 +2249,7 @@ nm_ip4_config_add_nameserver (NMIP4Config *self, guint32 new)
 			return;
 
 	g_array_append_val (priv->nameservers, new);
-	_notify (self, PROP_NAMESERVERS);
+	_notify_hashed (self, PROP_NAMESERVERS);
 }
 
 void
@@ -2243,7 +2260,7 @@ nm_ip4_config_del_nameserver (NMIP4Config *self, guint i)
 	g_return_if_fail (i < priv->nameservers->len);
 
 	g_array_remove_index (priv->nameservers, i);
-	_notify (self, PROP_NAMESERVERS);
+	_notify_hashed (self, PROP_NAMESERVERS);
 }
 
 guint
@@ -2279,7 +2296,7 @@ nm_ip4_config_reset_domains (NMIP4Config *self)
 
 	if (priv->domains->len != 0) {
 		g_ptr_array_set_size (priv->domains, 0);
-		_notify (self, PROP_DOMAINS);
+		_notify_hashed (self, PROP_DOMAINS);
 	}
 }
 
@@ -2297,7 +2314,7 @@ nm_ip4_config_add_domain (NMIP4Config *self, const char *domain)
 			return;
 
 	g_ptr_array_add (priv->domains, g_strdup (domain));
-	_notify (self, PROP_DOMAINS);
+	_notify_hashed (self, PROP_DOMAINS);
 }
 
 void
@@ -2308,7 +2325,7 @@ nm_ip4_config_del_domain (NMIP4Config *self, guint i)
 	g_return_if_fail (i < priv->domains->len);
 
 	g_ptr_array_remove_index (priv->domains, i);
-	_notify (self, PROP_DOMAINS);
+	_notify_hashed (self, PROP_DOMAINS);
 }
 
 guint
@@ -2336,7 +2353,7 @@ nm_ip4_config_reset_searches (NMIP4Config *self)
 
 	if (priv->searches->len != 0) {
 		g_ptr_array_set_size (priv->searches, 0);
-		_notify (self, PROP_SEARCHES);
+		_notify_hashed (self, PROP_SEARCHES);
 	}
 }
 
@@ -2369,7 +2386,7 @@ nm_ip4_config_add_search (NMIP4Config *self, const char *new)
 	}
 
 	g_ptr_array_add (priv->searches, search);
-	_notify (self, PROP_SEARCHES);
+	_notify_hashed (self, PROP_SEARCHES);
 }
 
 void
@@ -2380,7 +2397,7 @@ nm_ip4_config_del_search (NMIP4Config *self, guint i)
 	g_return_if_fail (i < priv->searches->len);
 
 	g_ptr_array_remove_index (priv->searches, i);
-	_notify (self, PROP_SEARCHES);
+	_notify_hashed (self, PROP_SEARCHES);
 }
 
 guint
@@ -2408,7 +2425,7 @@ nm_ip4_config_reset_dns_options (NMIP4Config *self)
 
 	if (priv->dns_options->len != 0) {
 		g_ptr_array_set_size (priv->dns_options, 0);
-		_notify (self, PROP_DNS_OPTIONS);
+		_notify_hashed (self, PROP_DNS_OPTIONS);
 	}
 }
 
@@ -2426,7 +2443,7 @@ nm_ip4_config_add_dns_option (NMIP4Config *self, const char *new)
 			return;
 
 	g_ptr_array_add (priv->dns_options, g_strdup (new));
-	_notify (self, PROP_DNS_OPTIONS);
+	_notify_hashed (self, PROP_DNS_OPTIONS);
 }
 
 void
@@ -2437,7 +2454,7 @@ nm_ip4_config_del_dns_option(NMIP4Config *self, guint i)
 	g_return_if_fail (i < priv->dns_options->len);
 
 	g_ptr_array_remove_index (priv->dns_options, i);
-	_notify (self, PROP_DNS_OPTIONS);
+	_notify_hashed (self, PROP_DNS_OPTIONS);
 }
 
 guint
@@ -2485,6 +2502,7 @@ nm_ip4_config_reset_nis_servers (NMIP4Config *self)
 	NMIP4ConfigPrivate *priv = NM_IP4_CONFIG_GET_PRIVATE (self);
 
 	g_array_set_size (priv->nis, 0);
+	priv->equal_hash = 0;
 }
 
 void
@@ -2498,6 +2516,7 @@ nm_ip4_config_add_nis_server (NMIP4Config *self, guint32 nis)
 			return;
 
 	g_array_append_val (priv->nis, nis);
+	priv->equal_hash = 0;
 }
 
 void
@@ -2508,6 +2527,7 @@ nm_ip4_config_del_nis_server (NMIP4Config *self, guint i)
 	g_return_if_fail (i < priv->nis->len);
 
 	g_array_remove_index (priv->nis, i);
+	priv->equal_hash = 0;
 }
 
 guint
@@ -2533,6 +2553,7 @@ nm_ip4_config_set_nis_domain (NMIP4Config *self, const char *domain)
 
 	g_free (priv->nis_domain);
 	priv->nis_domain = g_strdup (domain);
+	priv->equal_hash = 0;
 }
 
 const char *
@@ -2552,7 +2573,7 @@ nm_ip4_config_reset_wins (NMIP4Config *self)
 
 	if (priv->wins->len != 0) {
 		g_array_set_size (priv->wins, 0);
-		_notify (self, PROP_WINS_SERVERS);
+		_notify_hashed (self, PROP_WINS_SERVERS);
 	}
 }
 
@@ -2569,7 +2590,7 @@ nm_ip4_config_add_wins (NMIP4Config *self, guint32 wins)
 			return;
 
 	g_array_append_val (priv->wins, wins);
-	_notify (self, PROP_WINS_SERVERS);
+	_notify_hashed (self, PROP_WINS_SERVERS);
 }
 
 void
@@ -2580,7 +2601,7 @@ nm_ip4_config_del_wins (NMIP4Config *self, guint i)
 	g_return_if_fail (i < priv->wins->len);
 
 	g_array_remove_index (priv->wins, i);
-	_notify (self, PROP_WINS_SERVERS);
+	_notify_hashed (self, PROP_WINS_SERVERS);
 }
 
 guint
@@ -2790,6 +2811,156 @@ nm_ip4_config_hash (const NMIP4Config *self, GChecksum *sum, gboolean dns_only)
 	}
 }
 
+static guint64
+_equal_hash (const NMIP4Config *self)
+{
+	NMIP4ConfigPrivate *priv = (NMIP4ConfigPrivate *) NM_IP4_CONFIG_GET_PRIVATE (self);
+	NMDedupMultiIter ipconf_iter;
+	const NMPlatformIP4Address *address;
+	const NMPlatformIP4Route *route;
+	NMHashState h;
+	guint i;
+
+	if (priv->equal_hash)
+		return priv->equal_hash;
+
+	nm_hash_init (&h, 1466322119u);
+
+	nm_ip_config_iter_ip4_address_for_each (&ipconf_iter, self, &address) {
+		nm_hash_update_vals (&h,
+		                     address->address,
+		                     address->plen,
+		                     address->peer_address & _nm_utils_ip4_prefix_to_netmask (address->plen));
+	}
+	nm_hash_update_val (&h, (char) 0);
+
+	nm_ip_config_iter_ip4_route_for_each (&ipconf_iter, self, &route) {
+		nm_hash_update_vals (&h,
+		                     route->network,
+		                     route->plen,
+		                     route->gateway,
+		                     route->metric);
+	}
+	nm_hash_update_val (&h, (char) 0);
+
+	nm_hash_update_val (&h, priv->nis->len);
+	for (i = 0; i < priv->nis->len; i++)
+		nm_hash_update_val (&h, g_array_index (priv->nis, guint32, i));
+	nm_hash_update_str (&h, priv->nis_domain ?: "");
+
+	nm_hash_update_val (&h, priv->nameservers->len);
+	for (i = 0; i < priv->nameservers->len; i++)
+		nm_hash_update_val (&h, g_array_index (priv->nameservers, guint32, i));
+
+	nm_hash_update_val (&h, priv->wins->len);
+	for (i = 0; i < priv->wins->len; i++)
+		nm_hash_update_val (&h, g_array_index (priv->wins, guint32, i));
+
+	nm_hash_update_val (&h, priv->domains->len);
+	for (i = 0; i < priv->domains->len; i++)
+		nm_hash_update_str (&h, priv->domains->pdata[i]);
+
+	nm_hash_update_val (&h, priv->searches->len);
+	for (i = 0; i < priv->searches->len; i++)
+		nm_hash_update_str (&h, priv->searches->pdata[i]);
+
+	nm_hash_update_val (&h, priv->dns_options->len);
+	for (i = 0; i < priv->dns_options->len; i++)
+		nm_hash_update_str (&h, priv->dns_options->pdata[i]);
+
+	priv->equal_hash = nm_hash_complete_u64 (&h) ?: 1;
+	return priv->equal_hash;
+}
+
+static gboolean
+_equal_strv (const GPtrArray *a, const GPtrArray *b)
+{
+	guint i;
+
+	if (a->len != b->len)
+		return FALSE;
+	for (i = 0; i < a->len; i++) {
+		if (!nm_streq (a->pdata[i], b->pdata[i]))
+			return FALSE;
+	}
+	return TRUE;
+}
+
+static gboolean
+_equal_u32v (const GArray *a, const GArray *b)
+{
+	return    a->len == b->len
+	       && (   a->len == 0
+	           || memcmp (a->data, b->data, a->len * sizeof (guint32)) == 0);
+}
+
+static gboolean
+_equal_structural (const NMIP4Config *a, const NMIP4Config *b)
+{
+	const NMIP4ConfigPrivate *a_priv = NM_IP4_CONFIG_GET_PRIVATE (a);
+	const NMIP4ConfigPrivate *b_priv = NM_IP4_CONFIG_GET_PRIVATE (b);
+	NMDedupMultiIter a_iter, b_iter;
+	const NMPlatformIP4Address *a_address, *b_address;
+	const NMPlatformIP4Route *a_route, *b_route;
+	gboolean a_has, b_has;
+
+	nm_ip_config_iter_ip4_address_init (&a_iter, a);
+	nm_ip_config_iter_ip4_address_init (&b_iter, b);
+	while (TRUE) {
+		a_has = nm_ip_config_iter_ip4_address_next (&a_iter, &a_address);
+		b_has = nm_ip_config_iter_ip4_address_next (&b_iter, &b_address);
+		if (a_has != b_has)
+			return FALSE;
+		if (!a_has)
+			break;
+		if (   a_address->address != b_address->address
+		    || a_address->plen != b_address->plen
+		    || (a_address->peer_address & _nm_utils_ip4_prefix_to_netmask (a_address->plen))
+		       != (b_address->peer_address & _nm_utils_ip4_prefix_to_netmask (b_address->plen)))
+			return FALSE;
+	}
+
+	nm_ip_config_iter_ip4_route_init (&a_iter, a);
+	nm_ip_config_iter_ip4_route_init (&b_iter, b);
+	while (TRUE) {
+		a_has = nm_ip_config_iter_ip4_route_next (&a_iter, &a_route);
+		b_has = nm_ip_config_iter_ip4_route_next (&b_iter, &b_route);
+		if (a_has != b_has)
+			return FALSE;
+		if (!a_has)
+			break;
+		if (   a_route->network != b_route->network
+		    || a_route->plen != b_route->plen
+		    || a_route->gateway != b_route->gateway
+		    || a_route->metric != b_route->metric)
+			return FALSE;
+	}
+
+	return    _equal_u32v (a_priv->nis, b_priv->nis)
+	       && nm_streq (a_priv->nis_domain ?: "", b_priv->nis_domain ?: "")
+	       && _equal_u32v (a_priv->nameservers, b_priv->nameservers)
+	       && _equal_u32v (a_priv->wins, b_priv->wins)
+	       && _equal_strv (a_priv->domains, b_priv->domains)
+	       && _equal_strv (a_priv->searches, b_priv->searches)
+	       && _equal_strv (a_priv->dns_options, b_priv->dns_options);
+}
+
+static gboolean
+_equal_is_empty (const NMIP4Config *self)
+{
+	const NMIP4ConfigPrivate *priv = NM_IP4_CONFIG_GET_PRIVATE (self);
+
+	return    nm_ip4_config_get_num_addresses (self) == 0
+	       && nm_ip4_config_get_num_routes (self) == 0
+	       && priv->nis->len == 0
+	       && (priv->nis_domain ?: "")[0] == '\0'
+	       && priv->nameservers->len == 0
+	       && priv->wins->len == 0
+	       && priv->domains->len == 0
+	       && priv->searches->len == 0
+	       && priv->dns_options->len == 0;
+}
+
 /**
  * nm_ip4_config_equal:
  * @a: first config to compare
@@ -2800,34 +2971,27 @@ nm_ip4_config_hash (const NMIP4Config *self, GChecksum *sum, gboolean dns_only)
  * domains, DNS servers, etc) but some attributes (address lifetimes, and address
  * and route sources) are ignored.
  *
+ * Each config caches a hash of these attributes, which is reset whenever
+ * one of them changes. Configs with different hashes are unequal without
+ * looking further; only on a matching hash the attributes are compared.
+ *
  * Returns: %TRUE if the configurations are basically equal to each other,
  * %FALSE if not
  */
 gboolean
 nm_ip4_config_equal (const NMIP4Config *a, const NMIP4Config *b)
 {
-	GChecksum *a_checksum = g_checksum_new (G_CHECKSUM_SHA1);
-	GChecksum *b_checksum = g_checksum_new (G_CHECKSUM_SHA1);
-	gsize a_len = g_checksum_type_get_length (G_CHECKSUM_SHA1);
-	gsize b_len = g_checksum_type_get_length (G_CHECKSUM_SHA1);
-	guchar a_data[a_len], b_data[b_len];
-	gboolean equal;
-
-	if (a)
-		nm_ip4_config_hash (a, a_checksum, FALSE);
-	if (b)
-		nm_ip4_config_hash (b, b_checksum, FALSE);
+	if (a == b)
+		return TRUE;
 
-	g_checksum_get_digest (a_checksum, a_data, &a_len);
-	g_checksum_get_digest (b_checksum, b_data, &b_len);
+	/* a missing config is equal to an empty one. */
+	if (!a || !b)
+		return _equal_is_empty (a ?: b);
 
-	g_assert (a_len == b_len);
-	equal = !memcmp (a_data, b_data, a_len);
-
-	g_checksum_free (a_checksum);
-	g_checksum_free (b_checksum);
+	if (_equal_hash (a) != _equal_hash (b))
+		return FALSE;
 
-	return equal;
+	return _equal_structural (a, b);
 }
 
 /*****************************************************************************/
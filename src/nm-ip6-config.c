@@ -29,6 +29,7 @@
 #include <linux/rtnetlink.h>
 
 #include "nm-utils/nm-dedup-multi.h"
+#include "nm-utils/nm-hash-utils.h"
 
 #include "nm-utils.h"
 #include "platform/nmp-object.h"
@@ -71,6 +72,11 @@ typedef struct {
 	GVariant *routes_variant;
 	NMDedupMultiIndex *multi_idx;
 	const NMPObject *best_default_route;
+
+	/* cached hash of the fields compared by nm_ip6_config_equal(),
+	 * or zero if it needs to be recomputed. */
+	guint64 equal_hash;
+
 	union {
 		NMIPConfigDedupMultiIdxType idx_ip6_addresses_;
 		NMDedupMultiIdxType idx_ip6_addresses;
@@ -202,11 +208,20 @@ _nm_ip6_config_best_default_route_find (const NMIP6Config *self)
 
 /*****************************************************************************/
 
+static void
+_notify_hashed (NMIP6Config *self, _PropertyEnums prop)
+{
+	/* notify about a change to a property that is part of the equal-hash. */
+	NM_IP6_CONFIG_GET_PRIVATE (self)->equal_hash = 0;
+	_notify (self, prop);
+}
+
 static void
 _notify_addresses (NMIP6Config *self)
 {
 	NMIP6ConfigPrivate *priv = NM_IP6_CONFIG_GET_PRIVATE (self);
 
+	priv->equal_hash = 0;
 	nm_clear_g_variant (&priv->address_data_variant);
 	nm_clear_g_variant (&priv->addresses_variant);
 	_notify (self, PROP_ADDRESS_DATA);
@@ -219,6 +234,7 @@ _notify_routes (NMIP6Config *self)
 	NMIP6ConfigPrivate *priv = NM_IP6_CONFIG_GET_PRIVATE (self);
 
 	nm_assert (priv->best_default_route == _nm_ip6_config_best_default_route_find (self));
+	priv->equal_hash = 0;
 	nm_clear_g_variant (&priv->route_data_variant);
 	nm_clear_g_variant (&priv->routes_variant);
 	_notify (self, PROP_ROUTE_DATA);
@@ -429,7 +445,7 @@ nm_ip6_config_capture (NMDedupMultiIndex *multi_idx, NMPlatform *platform, int i
 			                                 rc_contents,
 			                                 priv->nameservers,
 			                                 priv->dns_options))
-				_notify (self, PROP_NAMESERVERS);
+				_notify_hashed (self, PROP_NAMESERVERS);
 		}
 	}
 
@@ -553,10 +569,11 @@ nm_ip6_config_commit (const NMIP6Config *self,
 	routes = nm_dedup_multi_objs_to_ptr_array_head (nm_ip6_config_lookup_routes (self),
 	                                                NULL, NULL);
 
-	routes_prune = nm_platform_ip_route_get_prune_list (platform,
-	                                                    AF_INET6,
-	                                                    ifindex,
-	                                                    route_table_sync);
+	routes_prune = nm_platform_ip_route_get_prune_list_delta (platform,
+	                                                          AF_INET6,
+	                                                          ifindex,
+	                                                          routes,
+	                                                          route_table_sync);
 
 	nm_platform_ip6_address_sync (platform, ifindex, addresses, TRUE);
 
@@ -1992,7 +2009,7 @@ nm_ip6_config_reset_nameservers (NMIP6Config *self)
 
 	if (priv->nameservers->len != 0) {
 		g_array_set_size (priv->nameservers, 0);
-		_notify (self, PROP_NAMESERVERS);
+		_notify_hashed (self, PROP_NAMESERVERS);
 	}
 }
 
@@ -2009,7 +2026,7 @@ nm_ip6_config_add_nameserver (NMIP6Config *self, const struct in6_addr *new)
 			return;
 
 	g_array_append_val (priv->nameservers, *new);
-	_notify (self, PROP_NAMESERVERS);
+	_notify_hashed (self, PROP_NAMESERVERS);
 }
 
 void
@@ -2020,7 +2037,7 @@ nm_ip6_config_del_nameserver (NMIP6Config *self, guint i)
 	g_return_if_fail (i < priv->nameservers->len);
 
 	g_array_remove_index (priv->nameservers, i);
-	_notify (self, PROP_NAMESERVERS);
+	_notify_hashed (self, PROP_NAMESERVERS);
 }
 
 guint
@@ -2048,7 +2065,7 @@ nm_ip6_config_reset_domains (NMIP6Config *self)
 
 	if (priv->domains->len != 0) {
 		g_ptr_array_set_size (priv->domains, 0);
-		_notify (self, PROP_DOMAINS);
+		_notify_hashed (self, PROP_DOMAINS);
 	}
 }
 
@@ -2066,7 +2083,7 @@ nm_ip6_config_add_domain (NMIP6Config *self, const char *domain)
 			return;
 
 	g_ptr_array_add (priv->domains, g_strdup (domain));
-	_notify (self, PROP_DOMAINS);
+	_notify_hashed (self, PROP_DOMAINS);
 }
 
 void
@@ -2077,7 +2094,7 @@ nm_ip6_config_del_domain (NMIP6Config *self, guint i)
 	g_return_if_fail (i < priv->domains->len);
 
 	g_ptr_array_remove_index (priv->domains, i);
-	_notify (self, PROP_DOMAINS);
+	_notify_hashed (self, PROP_DOMAINS);
 }
 
 guint
@@ -2105,7 +2122,7 @@ nm_ip6_config_reset_searches (NMIP6Config *self)
 
 	if (priv->searches->len != 0) {
 		g_ptr_array_set_size (priv->searches, 0);
-		_notify (self, PROP_SEARCHES);
+		_notify_hashed (self, PROP_SEARCHES);
 	}
 }
 
@@ -2138,7 +2155,7 @@ nm_ip6_config_add_search (NMIP6Config *self, const char *new)
 	}
 
 	g_ptr_array_add (priv->searches, search);
-	_notify (self, PROP_SEARCHES);
+	_notify_hashed (self, PROP_SEARCHES);
 }
 
 void
@@ -2149,7 +2166,7 @@ nm_ip6_config_del_search (NMIP6Config *self, guint i)
 	g_return_if_fail (i < priv->searches->len);
 
 	g_ptr_array_remove_index (priv->searches, i);
-	_notify (self, PROP_SEARCHES);
+	_notify_hashed (self, PROP_SEARCHES);
 }
 
 guint
@@ -2177,7 +2194,7 @@ nm_ip6_config_reset_dns_options (NMIP6Config *self)
 
 	if (priv->dns_options->len != 0) {
 		g_ptr_array_set_size (priv->dns_options, 0);
-		_notify (self, PROP_DNS_OPTIONS);
+		_notify_hashed (self, PROP_DNS_OPTIONS);
 	}
 }
 
@@ -2195,7 +2212,7 @@ nm_ip6_config_add_dns_option (NMIP6Config *self, const char *new)
 			return;
 
 	g_ptr_array_add (priv->dns_options, g_strdup (new));
-	_notify (self, PROP_DNS_OPTIONS);
+	_notify_hashed (self, PROP_DNS_OPTIONS);
 }
 
 void
@@ -2206,7 +2223,7 @@ nm_ip6_config_del_dns_option (NMIP6Config *self, guint i)
 	g_return_if_fail (i < priv->dns_options->len);
 
 	g_ptr_array_remove_index (priv->dns_options, i);
-	_notify (self, PROP_DNS_OPTIONS);
+	_notify_hashed (self, PROP_DNS_OPTIONS);
 }
 
 guint
@@ -2387,6 +2404,134 @@ nm_ip6_config_hash (const NMIP6Config *self, GChecksum *sum, gboolean dns_only)
 	}
 }
 
+static guint64
+_equal_hash (const NMIP6Config *self)
+{
+	NMIP6ConfigPrivate *priv = (NMIP6ConfigPrivate *) NM_IP6_CONFIG_GET_PRIVATE (self);
+	NMDedupMultiIter ipconf_iter;
+	const NMPlatformIP6Address *address;
+	const NMPlatformIP6Route *route;
+	NMHashState h;
+	guint i;
+
+	if (priv->equal_hash)
+		return priv->equal_hash;
+
+	nm_hash_init (&h, 2018367001u);
+
+	nm_ip_config_iter_ip6_address_for_each (&ipconf_iter, self, &address) {
+		nm_hash_update_vals (&h,
+		                     address->address,
+		                     address->plen);
+	}
+	nm_hash_update_val (&h, (char) 0);
+
+	nm_ip_config_iter_ip6_route_for_each (&ipconf_iter, self, &route) {
+		nm_hash_update_vals (&h,
+		                     route->network,
+		                     route->plen,
+		                     route->gateway,
+		                     route->metric);
+	}
+	nm_hash_update_val (&h, (char) 0);
+
+	nm_hash_update_val (&h, priv->nameservers->len);
+	for (i = 0; i < priv->nameservers->len; i++)
+		nm_hash_update_val (&h, g_array_index (priv->nameservers, struct in6_addr, i));
+
+	nm_hash_update_val (&h, priv->domains->len);
+	for (i = 0; i < priv->domains->len; i++)
+		nm_hash_update_str (&h, priv->domains->pdata[i]);
+
+	nm_hash_update_val (&h, priv->searches->len);
+	for (i = 0; i < priv->searches->len; i++)
+		nm_hash_update_str (&h, priv->searches->pdata[i]);
+
+	nm_hash_update_val (&h, priv->dns_options->len);
+	for (i = 0; i < priv->dns_options->len; i++)
+		nm_hash_update_str (&h, priv->dns_options->pdata[i]);
+
+	priv->equal_hash = nm_hash_complete_u64 (&h) ?: 1;
+	return priv->equal_hash;
+}
+
+static gboolean
+_equal_strv (const GPtrArray *a, const GPtrArray *b)
+{
+	guint i;
+
+	if (a->len != b->len)
+		return FALSE;
+	for (i = 0; i < a->len; i++) {
+		if (!nm_streq (a->pdata[i], b->pdata[i]))
+			return FALSE;
+	}
+	return TRUE;
+}
+
+static gboolean
+_equal_structural (const NMIP6Config *a, const NMIP6Config *b)
+{
+	const NMIP6ConfigPrivate *a_priv = NM_IP6_CONFIG_GET_PRIVATE (a);
+	const NMIP6ConfigPrivate *b_priv = NM_IP6_CONFIG_GET_PRIVATE (b);
+	NMDedupMultiIter a_iter, b_iter;
+	const NMPlatformIP6Address *a_address, *b_address;
+	const NMPlatformIP6Route *a_route, *b_route;
+	gboolean a_has, b_has;
+
+	nm_ip_config_iter_ip6_address_init (&a_iter, a);
+	nm_ip_config_iter_ip6_address_init (&b_iter, b);
+	while (TRUE) {
+		a_has = nm_ip_config_iter_ip6_address_next (&a_iter, &a_address);
+		b_has = nm_ip_config_iter_ip6_address_next (&b_iter, &b_address);
+		if (a_has != b_has)
+			return FALSE;
+		if (!a_has)
+			break;
+		if (   !IN6_ARE_ADDR_EQUAL (&a_address->address, &b_address->address)
+		    || a_address->plen != b_address->plen)
+			return FALSE;
+	}
+
+	nm_ip_config_iter_ip6_route_init (&a_iter, a);
+	nm_ip_config_iter_ip6_route_init (&b_iter, b);
+	while (TRUE) {
+		a_has = nm_ip_config_iter_ip6_route_next (&a_iter, &a_route);
+		b_has = nm_ip_config_iter_ip6_route_next (&b_iter, &b_route);
+		if (a_has != b_has)
+			return FALSE;
+		if (!a_has)
+			break;
+		if (   !IN6_ARE_ADDR_EQUAL (&a_route->network, &b_route->network)
+		    || a_route->plen != b_route->plen
+		    || !IN6_ARE_ADDR_EQUAL (&a_route->gateway, &b_route->gateway)
+		    || a_route->metric != b_route->metric)
+			return FALSE;
+	}
+
+	return    a_priv->nameservers->len == b_priv->nameservers->len
+	       && (   a_priv->nameservers->len == 0
+	           || memcmp (a_priv->nameservers->data,
+	                      b_priv->nameservers->data,
+	                      a_priv->nameservers->len * sizeof (struct in6_addr)) == 0)
+	       && _equal_strv (a_priv->domains, b_priv->domains)
+	       && _equal_strv (a_priv->searches, b_priv->searches)
+	       && _equal_strv (a_priv->dns_options, b_priv->dns_options);
+}
+
+static gboolean
+_equal_is_empty (const NMIP6Config *self)
+{
+	const NMIP6ConfigPrivate *priv = NM_IP6_CONFIG_GET_PRIVATE (self);
+
+	return    nm_ip6_config_get_num_addresses (self) == 0
+	       && nm_ip6_config_get_num_routes (self) == 0
+	       && priv->nameservers->len == 0
+	       && priv->domains->len == 0
+	       && priv->searches->len == 0
+	       && priv->dns_options->len == 0;
+}
+
 /**
  * nm_ip6_config_equal:
  * @a: first config to compare
@@ -2397,34 +2542,27 @@ nm_ip6_config_hash (const NMIP6Config *self, GChecksum *sum, gboolean dns_only)
  * domains, DNS servers, etc) but some attributes (address lifetimes, and address
  * and route sources) are ignored.
  *
+ * Each config caches a hash of these attributes, which is reset whenever
+ * one of them changes. Configs with different hashes are unequal without
+ * looking further; only on a matching hash the attributes are compared.
+ *
  * Returns: %TRUE if the configurations are basically equal to each other,
  * %FALSE if not
  */
 gboolean
 nm_ip6_config_equal (const NMIP6Config *a, const NMIP6Config *b)
 {
-	GChecksum *a_checksum = g_checksum_new (G_CHECKSUM_SHA1);
-	GChecksum *b_checksum = g_checksum_new (G_CHECKSUM_SHA1);
-	gsize a_len = g_checksum_type_get_length (G_CHECKSUM_SHA1);
-	gsize b_len = g_checksum_type_get_length (G_CHECKSUM_SHA1);
-	guchar a_data[a_len], b_data[b_len];
-	gboolean equal;
+	if (a == b)
+		return TRUE;
 
-	if (a)
-		nm_ip6_config_hash (a, a_checksum, FALSE);
-	if (b)
-		nm_ip6_config_hash (b, b_checksum, FALSE);
+	/* a missing config is equal to an empty one. */
+	if (!a || !b)
+		return _equal_is_empty (a ?: b);
 
-	g_checksum_get_digest (a_checksum, a_data, &a_len);
-	g_checksum_get_digest (b_checksum, b_data, &b_len);
-
-	g_assert (a_len == b_len);
-	equal = !memcmp (a_data, b_data, a_len);
-
-	g_checksum_free (a_checksum);
-	g_checksum_free (b_checksum);
+	if (_equal_hash (a) != _equal_hash (b))
+		return FALSE;
 
-	return equal;
+	return _equal_structural (a, b);
 }
 
 /*****************************************************************************/
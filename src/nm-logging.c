@@ -95,6 +95,9 @@ static struct Global {
 	bool uses_syslog:1;
 	bool syslog_identifier_initialized:1;
 	bool debug_stderr:1;
+	/* once the writer thread was started, it reads the backend settings
+	 * without synchronization. They can no longer be changed. */
+	bool async_started;
 	const char *prefix;
 	const char *syslog_identifier;
 	enum {
@@ -235,6 +238,8 @@ nm_logging_set_syslog_identifier (const char *domain)
 {
 	if (global.log_backend != LOG_BACKEND_GLIB)
 		g_return_if_reached ();
+	if (global.async_started)
+		g_return_if_reached ();
 
 	if (!_syslog_identifier_valid_domain (domain))
 		g_return_if_reached ();
@@ -587,41 +592,26 @@ _iovec_set_format (struct iovec *iov, gpointer *iov_free, const char *format, ..
 	} G_STMT_END
 #endif
 
-void
-_nm_log_impl (const char *file,
-              guint line,
-              const char *func,
-              NMLogLevel level,
-              NMLogDomain domain,
-              int error,
-              const char *ifname,
-              const char *conn_uuid,
-              const char *fmt,
-              ...)
-{
-	va_list args;
+/* A formatted logging message, ready to be written to the backend. */
+typedef struct {
+	const char *file;
+	const char *func;
+	const char *ifname;
+	const char *conn_uuid;
 	char *msg;
+	guint line;
+	NMLogLevel level;
+	NMLogDomain domain;
+	NMLogDomain domain_enabled;
+	int error;
 	GTimeVal tv;
-	int errno_saved;
-
-	if ((guint) level >= G_N_ELEMENTS (_nm_logging_enabled_state))
-		g_return_if_reached ();
-
-	if (!(_nm_logging_enabled_state[level] & domain))
-		return;
-
-	errno_saved = errno;
-
-	/* Make sure that %m maps to the specified error */
-	if (error != 0) {
-		if (error < 0)
-			error = -error;
-		errno = error;
-	}
+	gint64 now_ns;
+} LogRecord;
 
-	va_start (args, fmt);
-	msg = g_strdup_vprintf (fmt, args);
-	va_end (args);
+static void
+_log_record_write (const LogRecord *r)
+{
+	const NMLogLevel level = r->level;
 
 #define MESSAGE_FMT "%s%-7s [%ld.%04ld] %s"
 #define MESSAGE_ARG(global, tv, msg) \
@@ -631,10 +621,8 @@ _nm_log_impl (const char *file,
     ((tv).tv_usec / 100), \
     (msg)
 
-	g_get_current_time (&tv);
-
 	if (global.debug_stderr)
-		g_printerr (MESSAGE_FMT"\n", MESSAGE_ARG (global, tv, msg));
+		g_printerr (MESSAGE_FMT"\n", MESSAGE_ARG (global, r->tv, r->msg));
 
 	switch (global.log_backend) {
 #if SYSTEMD_JOURNAL
@@ -648,19 +636,19 @@ _nm_log_impl (const char *file,
 			gpointer *iov_free = iov_free_data;
 			nm_auto_free_gstring GString *s_domain_all = NULL;
 
-			now = nm_utils_get_monotonic_timestamp_ns ();
+			now = r->now_ns;
 			boottime = nm_utils_monotonic_timestamp_as_boottime (now, 1);
 
 			_iovec_set_format_a (iov++, 30, "PRIORITY=%d", global.level_desc[level].syslog_level);
-			_iovec_set_format (iov++, iov_free++, "MESSAGE="MESSAGE_FMT, MESSAGE_ARG (global, tv, msg));
+			_iovec_set_format (iov++, iov_free++, "MESSAGE="MESSAGE_FMT, MESSAGE_ARG (global, r->tv, r->msg));
 			_iovec_set_string (iov++, syslog_identifier_full (&global));
 			_iovec_set_format_a (iov++, 30, "SYSLOG_PID=%ld", (long) getpid ());
 			{
 				const LogDesc *diter;
 				int i_domain = _NUM_MAX_FIELDS_SYSLOG_FACILITY;
 				const char *s_domain_1 = NULL;
-				NMLogDomain dom_all = domain;
-				NMLogDomain dom = dom_all & _nm_logging_enabled_state[level];
+				NMLogDomain dom_all = r->domain;
+				NMLogDomain dom = dom_all & r->domain_enabled;
 
 				for (diter = &global.domain_desc[0]; diter->name; diter++) {
 					if (!NM_FLAGS_HAS (dom_all, diter->num))
@@ -698,18 +686,18 @@ _nm_log_impl (const char *file,
 					_iovec_set_format_a (iov++, _MAX_LEN (30, s_domain_1), "NM_LOG_DOMAINS=%s", s_domain_1);
 			}
 			_iovec_set_format_a (iov++, _MAX_LEN (15, global.level_desc[level].name), "NM_LOG_LEVEL=%s", global.level_desc[level].name);
-			if (func)
-				_iovec_set_format (iov++, iov_free++, "CODE_FUNC=%s", func);
-			_iovec_set_format (iov++, iov_free++, "CODE_FILE=%s", file ?: "");
-			_iovec_set_format_a (iov++, 20, "CODE_LINE=%u", line);
+			if (r->func)
+				_iovec_set_format (iov++, iov_free++, "CODE_FUNC=%s", r->func);
+			_iovec_set_format (iov++, iov_free++, "CODE_FILE=%s", r->file ?: "");
+			_iovec_set_format_a (iov++, 20, "CODE_LINE=%u", r->line);
 			_iovec_set_format_a (iov++, 60, "TIMESTAMP_MONOTONIC=%lld.%06lld", (long long) (now / NM_UTILS_NS_PER_SECOND), (long long) ((now % NM_UTILS_NS_PER_SECOND) / 1000));
 			_iovec_set_format_a (iov++, 60, "TIMESTAMP_BOOTTIME=%lld.%06lld", (long long) (boottime / NM_UTILS_NS_PER_SECOND), (long long) ((boottime % NM_UTILS_NS_PER_SECOND) / 1000));
-			if (error != 0)
-				_iovec_set_format_a (iov++, 30, "ERRNO=%d", error);
-			if (ifname)
-				_iovec_set_format (iov++, iov_free++, "NM_DEVICE=%s", ifname);
-			if (conn_uuid)
-				_iovec_set_format (iov++, iov_free++, "NM_CONNECTION=%s", conn_uuid);
+			if (r->error != 0)
+				_iovec_set_format_a (iov++, 30, "ERRNO=%d", r->error);
+			if (r->ifname)
+				_iovec_set_format (iov++, iov_free++, "NM_DEVICE=%s", r->ifname);
+			if (r->conn_uuid)
+				_iovec_set_format (iov++, iov_free++, "NM_CONNECTION=%s", r->conn_uuid);
 
 			nm_assert (iov <= &iov_data[G_N_ELEMENTS (iov_data)]);
 			nm_assert (iov_free <= &iov_free_data[G_N_ELEMENTS (iov_free_data)]);
@@ -723,15 +711,530 @@ _nm_log_impl (const char *file,
 #endif
 	case LOG_BACKEND_SYSLOG:
 		syslog (global.level_desc[level].syslog_level,
-		        MESSAGE_FMT, MESSAGE_ARG (global, tv, msg));
+		        MESSAGE_FMT, MESSAGE_ARG (global, r->tv, r->msg));
 		break;
 	default:
 		g_log (syslog_identifier_domain (&global), global.level_desc[level].g_log_level,
-		       MESSAGE_FMT, MESSAGE_ARG (global, tv, msg));
+		       MESSAGE_FMT, MESSAGE_ARG (global, r->tv, r->msg));
 		break;
 	}
+}
+
+/*****************************************************************************/
+
+/* The asynchronous logging pipeline. _nm_log_impl() only formats the message
+ * and queues the record into a bounded ring buffer, which is drained by a
+ * writer thread that talks to the backend. The ring is a lock-free
+ * multi-producer/single-consumer queue: each slot has a sequence number
+ * that tells whether it is free for the producer of a certain position,
+ * or filled for the consumer. When the ring is full, messages are
+ * dropped and counted. */
+
+#define LOG_RING_SIZE NM_LOGGING_ASYNC_RING_SIZE
+
+G_STATIC_ASSERT ((LOG_RING_SIZE & (LOG_RING_SIZE - 1)) == 0);
+
+typedef struct {
+	volatile gint seq;
+	LogRecord *record;
+} LogRingSlot;
+
+static struct {
+	GThread *thread;
+
+	/* whether _nm_log_impl() queues records. Read without lock. */
+	volatile gint enabled;
+	volatile gint stopping;
+
+	/* position of the next record to enqueue (producers) and to
+	 * dequeue (only advanced by the writer thread). */
+	volatile gint enqueue_pos;
+	volatile gint dequeue_pos;
+	/* like @dequeue_pos, but advanced after the record was written. */
+	volatile gint written_pos;
+
+	/* the writer thread sleeps on @cond while the ring is empty. Threads
+	 * that wait for the queued records to be written sleep on
+	 * @flushed_cond. */
+	GMutex lock;
+	GCond cond;
+	GCond flushed_cond;
+	volatile gint writer_sleeping;
+	volatile gint n_flush_waiting;
+
+	volatile gint n_dropped;
+	guint n_dropped_reported;
+	volatile gint n_written;
+
+	LogRingSlot slots[LOG_RING_SIZE];
+} log_async;
+
+static gboolean
+_log_ring_enqueue (LogRecord *record)
+{
+	LogRingSlot *slot;
+	guint pos;
+	gint diff;
+
+	pos = (guint) g_atomic_int_get (&log_async.enqueue_pos);
+	for (;;) {
+		slot = &log_async.slots[pos & (LOG_RING_SIZE - 1)];
+		diff = (gint) ((guint) g_atomic_int_get (&slot->seq) - pos);
+		if (diff == 0) {
+			if (g_atomic_int_compare_and_exchange (&log_async.enqueue_pos, (gint) pos, (gint) (pos + 1)))
+				break;
+		} else if (diff < 0) {
+			/* the writer didn't yet consume the record of the previous
+			 * round. The ring is full. */
+			return FALSE;
+		}
+		pos = (guint) g_atomic_int_get (&log_async.enqueue_pos);
+	}
+
+	slot->record = record;
+	g_atomic_int_set (&slot->seq, (gint) (pos + 1));
+	return TRUE;
+}
+
+static LogRecord *
+_log_ring_dequeue (void)
+{
+	LogRingSlot *slot;
+	LogRecord *record;
+	guint pos = (guint) g_atomic_int_get (&log_async.dequeue_pos);
+
+	slot = &log_async.slots[pos & (LOG_RING_SIZE - 1)];
+	if ((gint) ((guint) g_atomic_int_get (&slot->seq) - (pos + 1)) < 0)
+		return NULL;
+
+	record = slot->record;
+	slot->record = NULL;
+	g_atomic_int_set (&slot->seq, (gint) (pos + LOG_RING_SIZE));
+	g_atomic_int_set (&log_async.dequeue_pos, (gint) (pos + 1));
+	return record;
+}
+
+static void
+_log_record_free (LogRecord *r)
+{
+	g_free (r->msg);
+	g_free ((char *) r->ifname);
+	g_free ((char *) r->conn_uuid);
+	g_slice_free (LogRecord, r);
+}
+
+static void
+_log_async_report_dropped (void)
+{
+	guint n_dropped = (guint) g_atomic_int_get (&log_async.n_dropped);
+	LogRecord r = {
+		.level = LOGL_WARN,
+		.domain = LOGD_CORE,
+		.domain_enabled = LOGD_CORE,
+		.file = __FILE__,
+		.line = __LINE__,
+		.func = G_STRFUNC,
+	};
+
+	if (n_dropped == log_async.n_dropped_reported)
+		return;
+
+	r.msg = g_strdup_printf ("logging: dropped %u messages, the log writer could not keep up",
+	                         n_dropped - log_async.n_dropped_reported);
+	g_get_current_time (&r.tv);
+	r.now_ns = nm_utils_get_monotonic_timestamp_ns ();
+	_log_record_write (&r);
+	g_free (r.msg);
+
+	log_async.n_dropped_reported = n_dropped;
+}
+
+static void
+_log_async_drain (void)
+{
+	LogRecord *record;
+
+	while ((record = _log_ring_dequeue ())) {
+		_log_record_write (record);
+		_log_record_free (record);
+		g_atomic_int_inc (&log_async.n_written);
+		g_atomic_int_inc (&log_async.written_pos);
+	}
+
+	_log_async_report_dropped ();
+
+	if (g_atomic_int_get (&log_async.n_flush_waiting)) {
+		g_mutex_lock (&log_async.lock);
+		g_cond_broadcast (&log_async.flushed_cond);
+		g_mutex_unlock (&log_async.lock);
+	}
+}
+
+static gpointer
+_log_async_writer_thread (gpointer user_data)
+{
+	gboolean stopping;
+
+	for (;;) {
+		_log_async_drain ();
+
+		g_mutex_lock (&log_async.lock);
+		g_atomic_int_set (&log_async.writer_sleeping, 1);
+		/* check again, after announcing that we are going to sleep. A
+		 * producer that queued a record before seeing the flag is
+		 * detected here. */
+		stopping = g_atomic_int_get (&log_async.stopping);
+		if (   !stopping
+		    && !g_atomic_int_get (&log_async.n_flush_waiting)
+		    && g_atomic_int_get (&log_async.dequeue_pos) == g_atomic_int_get (&log_async.enqueue_pos))
+			g_cond_wait_until (&log_async.cond, &log_async.lock, g_get_monotonic_time () + G_TIME_SPAN_SECOND);
+		g_atomic_int_set (&log_async.writer_sleeping, 0);
+		g_mutex_unlock (&log_async.lock);
+
+		if (stopping) {
+			_log_async_drain ();
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+/* Waits until the writer thread wrote all records that were queued so far.
+ * Used before logging severe messages, which are written synchronously,
+ * so that the messages leading up to a crash are not lost in the ring. */
+static void
+_log_async_flush (void)
+{
+	const guint target = (guint) g_atomic_int_get (&log_async.enqueue_pos);
+	const gint64 end_time = g_get_monotonic_time () + 2 * G_TIME_SPAN_SECOND;
+
+	if (g_thread_self () == log_async.thread) {
+		/* the writer itself logs. Everything before is written already. */
+		return;
+	}
+
+	g_mutex_lock (&log_async.lock);
+	g_atomic_int_inc (&log_async.n_flush_waiting);
+	g_cond_signal (&log_async.cond);
+	while ((gint) ((guint) g_atomic_int_get (&log_async.written_pos) - target) < 0) {
+		/* don't hang forever on a stuck writer. */
+		if (!g_cond_wait_until (&log_async.flushed_cond, &log_async.lock, end_time))
+			break;
+	}
+	g_atomic_int_add (&log_async.n_flush_waiting, -1);
+	g_mutex_unlock (&log_async.lock);
+}
+
+static gboolean
+_log_async_queue (const LogRecord *r)
+{
+	LogRecord *record;
+
+	record = g_slice_new (LogRecord);
+	*record = *r;
+	record->ifname = g_strdup (r->ifname);
+	record->conn_uuid = g_strdup (r->conn_uuid);
+
+	if (!_log_ring_enqueue (record)) {
+		g_atomic_int_inc (&log_async.n_dropped);
+		/* the caller keeps ownership of the message. */
+		record->msg = NULL;
+		_log_record_free (record);
+		return FALSE;
+	}
+
+	if (g_atomic_int_get (&log_async.writer_sleeping)) {
+		g_mutex_lock (&log_async.lock);
+		g_cond_signal (&log_async.cond);
+		g_mutex_unlock (&log_async.lock);
+	}
+	return TRUE;
+}
+
+/**
+ * nm_logging_async_start:
+ *
+ * Start writing the logging messages from a separate thread. After this,
+ * nm_log() only formats the message and queues it. Errors are still
+ * written synchronously, after the queued messages.
+ * Must be called after nm_logging_syslog_openlog(). Afterwards, the
+ * logging backend, prefix and syslog identifier can no longer be changed.
+ */
+void
+nm_logging_async_start (void)
+{
+	guint i;
+
+	if (log_async.thread)
+		g_return_if_reached ();
+
+	for (i = 0; i < LOG_RING_SIZE; i++)
+		log_async.slots[i].seq = i;
+	log_async.enqueue_pos = 0;
+	log_async.dequeue_pos = 0;
+	log_async.written_pos = 0;
+	log_async.stopping = 0;
+	g_mutex_init (&log_async.lock);
+	g_cond_init (&log_async.cond);
+	g_cond_init (&log_async.flushed_cond);
+
+	global.async_started = TRUE;
+	log_async.thread = g_thread_new ("nm-log-writer", _log_async_writer_thread, NULL);
+	g_atomic_int_set (&log_async.enabled, 1);
+}
+
+/**
+ * nm_logging_async_stop:
+ *
+ * Writes all queued logging messages and returns to logging
+ * synchronously.
+ */
+void
+nm_logging_async_stop (void)
+{
+	if (!log_async.thread)
+		return;
+
+	g_atomic_int_set (&log_async.enabled, 0);
+
+	g_mutex_lock (&log_async.lock);
+	g_atomic_int_set (&log_async.stopping, 1);
+	g_cond_signal (&log_async.cond);
+	g_mutex_unlock (&log_async.lock);
+
+	g_thread_join (log_async.thread);
+	log_async.thread = NULL;
+
+	g_cond_clear (&log_async.cond);
+	g_cond_clear (&log_async.flushed_cond);
+	g_mutex_clear (&log_async.lock);
+}
+
+void
+nm_logging_async_get_stats (guint *out_n_written, guint *out_n_dropped)
+{
+	NM_SET_OUT (out_n_written, (guint) g_atomic_int_get (&log_async.n_written));
+	NM_SET_OUT (out_n_dropped, (guint) g_atomic_int_get (&log_async.n_dropped));
+}
+
+/*****************************************************************************/
+
+/* Rate limiting of logging messages. Every domain has a token bucket
+ * that holds up to @burst tokens and is refilled with @burst tokens
+ * per @interval. Each message costs one token, and when the bucket is
+ * empty, messages are suppressed and counted. The next message that
+ * gets through is preceded by a message with the number of suppressed
+ * ones. Warnings and errors are never rate limited.
+ *
+ * A message with several domains is accounted to its first domain.
+ * The tokens are kept as the time in microseconds it takes to earn them,
+ * so that refilling is a plain addition. */
+
+typedef struct {
+	gint64 credit_us;
+	gint64 last_us;
+	guint n_suppressed;
+} LogRateBucket;
+
+static struct {
+	/* whether rate limiting is enabled. Read without lock. */
+	volatile gint enabled;
+	gint64 interval_us;
+	gint64 cost_us;
+	volatile gint n_suppressed;
+	LogRateBucket buckets[64];
+} log_rate_limit;
+
+G_LOCK_DEFINE_STATIC (log_rate_limit);
+
+G_STATIC_ASSERT (sizeof (NMLogDomain) * 8 == G_N_ELEMENTS (log_rate_limit.buckets));
+
+/**
+ * nm_logging_set_rate_limit:
+ * @burst: the number of messages per domain that are logged within
+ *   @interval_sec, or 0 to disable rate limiting.
+ * @interval_sec: the interval in seconds, or 0 to disable rate limiting.
+ *
+ * Configures the per-domain rate limiting of logging messages with
+ * level INFO and below.
+ */
+void
+nm_logging_set_rate_limit (guint burst, guint interval_sec)
+{
+	G_LOCK (log_rate_limit);
+	memset (log_rate_limit.buckets, 0, sizeof (log_rate_limit.buckets));
+	if (burst > 0 && interval_sec > 0) {
+		log_rate_limit.interval_us = (gint64) interval_sec * G_USEC_PER_SEC;
+		log_rate_limit.cost_us = MAX (log_rate_limit.interval_us / burst, 1);
+		g_atomic_int_set (&log_rate_limit.enabled, 1);
+	} else {
+		log_rate_limit.interval_us = 0;
+		log_rate_limit.cost_us = 0;
+		g_atomic_int_set (&log_rate_limit.enabled, 0);
+	}
+	G_UNLOCK (log_rate_limit);
+}
+
+guint
+nm_logging_rate_limit_get_suppressed (void)
+{
+	return (guint) g_atomic_int_get (&log_rate_limit.n_suppressed);
+}
+
+/* Returns whether the message can be logged. If messages of the domain were
+ * suppressed since the last one got through, @out_n_suppressed is set to
+ * their number and the caller shall report it. */
+static gboolean
+_log_rate_limit_check (NMLogDomain domain, guint *out_n_suppressed)
+{
+	LogRateBucket *b;
+	gint64 now;
+	gboolean pass;
+
+	*out_n_suppressed = 0;
+
+	nm_assert (domain);
+
+	now = g_get_monotonic_time ();
+
+	G_LOCK (log_rate_limit);
+
+	if (!log_rate_limit.interval_us) {
+		/* disabled concurrently. */
+		G_UNLOCK (log_rate_limit);
+		return TRUE;
+	}
+
+	b = &log_rate_limit.buckets[__builtin_ctzll ((guint64) domain)];
+
+	if (b->last_us == 0)
+		b->credit_us = log_rate_limit.interval_us;
+	else
+		b->credit_us = MIN (b->credit_us + (now - b->last_us), log_rate_limit.interval_us);
+	b->last_us = now;
+
+	if (b->credit_us >= log_rate_limit.cost_us) {
+		b->credit_us -= log_rate_limit.cost_us;
+		*out_n_suppressed = b->n_suppressed;
+		b->n_suppressed = 0;
+		pass = TRUE;
+	} else {
+		b->n_suppressed++;
+		pass = FALSE;
+	}
+
+	G_UNLOCK (log_rate_limit);
 
-	g_free (msg);
+	if (!pass)
+		g_atomic_int_inc (&log_rate_limit.n_suppressed);
+	return pass;
+}
+
+static const char *
+_domain_name_first (NMLogDomain domain)
+{
+	const LogDesc *diter;
+	const guint64 first = ((guint64) domain) & (~((guint64) domain) + 1);
+
+	for (diter = &global.domain_desc[0]; diter->name; diter++) {
+		if (diter->num == first)
+			return diter->name;
+	}
+	return "?";
+}
+
+/*****************************************************************************/
+
+/* Writes the record or queues it for the writer thread. Takes ownership of
+ * the message. */
+static void
+_log_record_emit (LogRecord *r)
+{
+	if (   g_atomic_int_get (&log_async.enabled)
+	    && r->level < LOGL_ERR) {
+		/* on success, the queued record owns the message. Otherwise
+		 * the message is dropped. */
+		if (!_log_async_queue (r))
+			g_free (r->msg);
+	} else {
+		if (g_atomic_int_get (&log_async.enabled))
+			_log_async_flush ();
+		_log_record_write (r);
+		g_free (r->msg);
+	}
+	r->msg = NULL;
+}
+
+void
+_nm_log_impl (const char *file,
+              guint line,
+              const char *func,
+              NMLogLevel level,
+              NMLogDomain domain,
+              int error,
+              const char *ifname,
+              const char *conn_uuid,
+              const char *fmt,
+              ...)
+{
+	va_list args;
+	int errno_saved;
+	LogRecord r;
+	guint n_suppressed = 0;
+
+	if ((guint) level >= G_N_ELEMENTS (_nm_logging_enabled_state))
+		g_return_if_reached ();
+
+	if (!(_nm_logging_enabled_state[level] & domain))
+		return;
+
+	if (   level <= LOGL_INFO
+	    && g_atomic_int_get (&log_rate_limit.enabled)
+	    && !_log_rate_limit_check (domain, &n_suppressed))
+		return;
+
+	errno_saved = errno;
+
+	/* Make sure that %m maps to the specified error */
+	if (error != 0) {
+		if (error < 0)
+			error = -error;
+		errno = error;
+	}
+
+	r = (LogRecord) {
+		.file = file,
+		.line = line,
+		.func = func,
+		.level = level,
+		.domain = domain,
+		.domain_enabled = _nm_logging_enabled_state[level],
+		.error = error,
+		.ifname = ifname,
+		.conn_uuid = conn_uuid,
+	};
+
+	va_start (args, fmt);
+	r.msg = g_strdup_vprintf (fmt, args);
+	va_end (args);
+
+	g_get_current_time (&r.tv);
+#if SYSTEMD_JOURNAL
+	if (global.log_backend == LOG_BACKEND_JOURNAL)
+		r.now_ns = nm_utils_get_monotonic_timestamp_ns ();
+#endif
+
+	if (n_suppressed > 0) {
+		LogRecord r_suppressed = r;
+
+		r_suppressed.error = 0;
+		r_suppressed.msg = g_strdup_printf ("logging: suppressed %u messages of domain %s due to rate limiting",
+		                                    n_suppressed, _domain_name_first (domain));
+		_log_record_emit (&r_suppressed);
+	}
+
+	_log_record_emit (&r);
 
 	errno = errno_saved;
 }
@@ -768,6 +1271,11 @@ nm_log_handler (const gchar *log_domain,
 		break;
 	}
 
+	/* g_error() and g_critical() may abort right after. */
+	if (   syslog_priority <= LOG_ERR
+	    && g_atomic_int_get (&log_async.enabled))
+		_log_async_flush ();
+
 	switch (global.log_backend) {
 #if SYSTEMD_JOURNAL
 	case LOG_BACKEND_JOURNAL:
@@ -812,6 +1320,8 @@ nm_logging_set_prefix (const char *format, ...)
 	 * nm_logging_syslog_openlog() the prefix cannot be set either. */
 	if (global.log_backend != LOG_BACKEND_GLIB)
 		g_return_if_reached ();
+	if (global.async_started)
+		g_return_if_reached ();
 	if (global.prefix[0])
 		g_return_if_reached ();
 
@@ -831,6 +1341,8 @@ nm_logging_syslog_openlog (const char *logging_backend, gboolean debug)
 {
 	if (global.log_backend != LOG_BACKEND_GLIB)
 		g_return_if_reached ();
+	if (global.async_started)
+		g_return_if_reached ();
 
 	if (!logging_backend)
 		logging_backend = ""NM_CONFIG_DEFAULT_LOGGING_BACKEND;
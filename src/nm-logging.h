@@ -213,6 +213,12 @@ static inline gboolean
 nm_logging_enabled (NMLogLevel level, NMLogDomain domain)
 {
 	nm_assert (((guint) level) < G_N_ELEMENTS (_nm_logging_enabled_state));
+#ifdef NM_DISABLE_TRACE_LOGGING
+	/* with --disable-trace-logging, this is a constant for most call sites
+	 * and the compiler drops the guarded statements altogether. */
+	if (level == LOGL_TRACE)
+		return FALSE;
+#endif
 	return    (((guint) level) < G_N_ELEMENTS (_nm_logging_enabled_state))
 	       && !!(_nm_logging_enabled_state[level] & domain);
 }
@@ -233,25 +239,44 @@ void nm_logging_set_prefix (const char *format, ...) _nm_printf (1, 2);
 void     nm_logging_syslog_openlog (const char *logging_backend, gboolean debug);
 gboolean nm_logging_syslog_enabled (void);
 
+#define NM_LOGGING_ASYNC_RING_SIZE 4096
+
+void     nm_logging_async_start (void);
+void     nm_logging_async_stop (void);
+void     nm_logging_async_get_stats (guint *out_n_written, guint *out_n_dropped);
+
+void     nm_logging_set_rate_limit (guint burst, guint interval_sec);
+guint    nm_logging_rate_limit_get_suppressed (void);
+
 /*****************************************************************************/
 
 /* This is the default definition of _NMLOG_ENABLED(). Special implementations
  * might want to undef this and redefine it. */
 #define _NMLOG_ENABLED(level) ( nm_logging_enabled ((level), (_NMLOG_DOMAIN)) )
 
-#define _LOGT(...)          _NMLOG (LOGL_TRACE, __VA_ARGS__)
+/* With --disable-trace-logging, the _LOGT() family is compiled out. The
+ * statements are still passed to the compiler for the type checks, but
+ * neither the arguments are evaluated nor the message is formatted. */
+#ifndef NM_DISABLE_TRACE_LOGGING
+#define _LOGT(...)            _NMLOG (LOGL_TRACE, __VA_ARGS__)
+#define _LOGT_ENABLED(...)    _NMLOG_ENABLED (LOGL_TRACE, ##__VA_ARGS__)
+#define _LOGT_err(errsv, ...) _NMLOG_err (errsv, LOGL_TRACE, __VA_ARGS__)
+#else
+#define _LOGT(...)            G_STMT_START { if (FALSE) { _NMLOG (LOGL_TRACE, __VA_ARGS__); } } G_STMT_END
+#define _LOGT_ENABLED(...)    ( FALSE && (_NMLOG_ENABLED (LOGL_TRACE, ##__VA_ARGS__)) )
+#define _LOGT_err(errsv, ...) G_STMT_START { if (FALSE) { _NMLOG_err (errsv, LOGL_TRACE, __VA_ARGS__); } } G_STMT_END
+#endif
+
 #define _LOGD(...)          _NMLOG (LOGL_DEBUG, __VA_ARGS__)
 #define _LOGI(...)          _NMLOG (LOGL_INFO , __VA_ARGS__)
 #define _LOGW(...)          _NMLOG (LOGL_WARN , __VA_ARGS__)
 #define _LOGE(...)          _NMLOG (LOGL_ERR  , __VA_ARGS__)
 
-#define _LOGT_ENABLED(...)  _NMLOG_ENABLED (LOGL_TRACE, ##__VA_ARGS__)
 #define _LOGD_ENABLED(...)  _NMLOG_ENABLED (LOGL_DEBUG, ##__VA_ARGS__)
 #define _LOGI_ENABLED(...)  _NMLOG_ENABLED (LOGL_INFO , ##__VA_ARGS__)
 #define _LOGW_ENABLED(...)  _NMLOG_ENABLED (LOGL_WARN , ##__VA_ARGS__)
 #define _LOGE_ENABLED(...)  _NMLOG_ENABLED (LOGL_ERR  , ##__VA_ARGS__)
 
-#define _LOGT_err(errsv, ...) _NMLOG_err (errsv, LOGL_TRACE, __VA_ARGS__)
 #define _LOGD_err(errsv, ...) _NMLOG_err (errsv, LOGL_DEBUG, __VA_ARGS__)
 #define _LOGI_err(errsv, ...) _NMLOG_err (errsv, LOGL_INFO , __VA_ARGS__)
 #define _LOGW_err(errsv, ...) _NMLOG_err (errsv, LOGL_WARN , __VA_ARGS__)
@@ -260,9 +285,9 @@ gboolean nm_logging_syslog_enabled (void);
 /* _LOGT() and _LOGt() both log with level TRACE, but the latter is disabled by default,
  * unless building with --with-more-logging. */
 #ifdef NM_MORE_LOGGING
-#define _LOGt_ENABLED(...)    _NMLOG_ENABLED (LOGL_TRACE, ##__VA_ARGS__)
-#define _LOGt(...)            _NMLOG (LOGL_TRACE, __VA_ARGS__)
-#define _LOGt_err(errsv, ...) _NMLOG_err (errsv, LOGL_TRACE, __VA_ARGS__)
+#define _LOGt_ENABLED(...)    _LOGT_ENABLED (__VA_ARGS__)
+#define _LOGt(...)            _LOGT (__VA_ARGS__)
+#define _LOGt_err(errsv, ...) _LOGT_err (errsv, __VA_ARGS__)
 #else
 /* still call the logging macros to get compile time checks, but they will be optimized out. */
 #define _LOGt_ENABLED(...)    ( FALSE && (_NMLOG_ENABLED (LOGL_TRACE, ##__VA_ARGS__)) )
@@ -281,28 +306,35 @@ gboolean nm_logging_syslog_enabled (void);
 
 #define _NMLOG2_ENABLED(level) ( nm_logging_enabled ((level), (_NMLOG2_DOMAIN)) )
 
-#define _LOG2T(...)          _NMLOG2 (LOGL_TRACE, __VA_ARGS__)
+#ifndef NM_DISABLE_TRACE_LOGGING
+#define _LOG2T(...)            _NMLOG2 (LOGL_TRACE, __VA_ARGS__)
+#define _LOG2T_ENABLED(...)    _NMLOG2_ENABLED (LOGL_TRACE, ##__VA_ARGS__)
+#define _LOG2T_err(errsv, ...) _NMLOG2_err (errsv, LOGL_TRACE, __VA_ARGS__)
+#else
+#define _LOG2T(...)            G_STMT_START { if (FALSE) { _NMLOG2 (LOGL_TRACE, __VA_ARGS__); } } G_STMT_END
+#define _LOG2T_ENABLED(...)    ( FALSE && (_NMLOG2_ENABLED (LOGL_TRACE, ##__VA_ARGS__)) )
+#define _LOG2T_err(errsv, ...) G_STMT_START { if (FALSE) { _NMLOG2_err (errsv, LOGL_TRACE, __VA_ARGS__); } } G_STMT_END
+#endif
+
 #define _LOG2D(...)          _NMLOG2 (LOGL_DEBUG, __VA_ARGS__)
 #define _LOG2I(...)          _NMLOG2 (LOGL_INFO , __VA_ARGS__)
 #define _LOG2W(...)          _NMLOG2 (LOGL_WARN , __VA_ARGS__)
 #define _LOG2E(...)          _NMLOG2 (LOGL_ERR  , __VA_ARGS__)
 
-#define _LOG2T_ENABLED(...)  _NMLOG2_ENABLED (LOGL_TRACE, ##__VA_ARGS__)
 #define _LOG2D_ENABLED(...)  _NMLOG2_ENABLED (LOGL_DEBUG, ##__VA_ARGS__)
 #define _LOG2I_ENABLED(...)  _NMLOG2_ENABLED (LOGL_INFO , ##__VA_ARGS__)
 #define _LOG2W_ENABLED(...)  _NMLOG2_ENABLED (LOGL_WARN , ##__VA_ARGS__)
 #define _LOG2E_ENABLED(...)  _NMLOG2_ENABLED (LOGL_ERR  , ##__VA_ARGS__)
 
-#define _LOG2T_err(errsv, ...) _NMLOG2_err (errsv, LOGL_TRACE, __VA_ARGS__)
 #define _LOG2D_err(errsv, ...) _NMLOG2_err (errsv, LOGL_DEBUG, __VA_ARGS__)
 #define _LOG2I_err(errsv, ...) _NMLOG2_err (errsv, LOGL_INFO , __VA_ARGS__)
 #define _LOG2W_err(errsv, ...) _NMLOG2_err (errsv, LOGL_WARN , __VA_ARGS__)
 #define _LOG2E_err(errsv, ...) _NMLOG2_err (errsv, LOGL_ERR  , __VA_ARGS__)
 
 #ifdef NM_MORE_LOGGING
-#define _LOG2t_ENABLED(...)    _NMLOG2_ENABLED (LOGL_TRACE, ##__VA_ARGS__)
-#define _LOG2t(...)            _NMLOG2 (LOGL_TRACE, __VA_ARGS__)
-#define _LOG2t_err(errsv, ...) _NMLOG2_err (errsv, LOGL_TRACE, __VA_ARGS__)
+#define _LOG2t_ENABLED(...)    _LOG2T_ENABLED (__VA_ARGS__)
+#define _LOG2t(...)            _LOG2T (__VA_ARGS__)
+#define _LOG2t_err(errsv, ...) _LOG2T_err (errsv, __VA_ARGS__)
 #else
 /* still call the logging macros to get compile time checks, but they will be optimized out. */
 #define _LOG2t_ENABLED(...)    ( FALSE && (_NMLOG2_ENABLED (LOGL_TRACE, ##__VA_ARGS__)) )
@@ -312,28 +344,35 @@ gboolean nm_logging_syslog_enabled (void);
 
 #define _NMLOG3_ENABLED(level) ( nm_logging_enabled ((level), (_NMLOG3_DOMAIN)) )
 
-#define _LOG3T(...)          _NMLOG3 (LOGL_TRACE, __VA_ARGS__)
+#ifndef NM_DISABLE_TRACE_LOGGING
+#define _LOG3T(...)            _NMLOG3 (LOGL_TRACE, __VA_ARGS__)
+#define _LOG3T_ENABLED(...)    _NMLOG3_ENABLED (LOGL_TRACE, ##__VA_ARGS__)
+#define _LOG3T_err(errsv, ...) _NMLOG3_err (errsv, LOGL_TRACE, __VA_ARGS__)
+#else
+#define _LOG3T(...)            G_STMT_START { if (FALSE) { _NMLOG3 (LOGL_TRACE, __VA_ARGS__); } } G_STMT_END
+#define _LOG3T_ENABLED(...)    ( FALSE && (_NMLOG3_ENABLED (LOGL_TRACE, ##__VA_ARGS__)) )
+#define _LOG3T_err(errsv, ...) G_STMT_START { if (FALSE) { _NMLOG3_err (errsv, LOGL_TRACE, __VA_ARGS__); } } G_STMT_END
+#endif
+
 #define _LOG3D(...)          _NMLOG3 (LOGL_DEBUG, __VA_ARGS__)
 #define _LOG3I(...)          _NMLOG3 (LOGL_INFO , __VA_ARGS__)
 #define _LOG3W(...)          _NMLOG3 (LOGL_WARN , __VA_ARGS__)
 #define _LOG3E(...)          _NMLOG3 (LOGL_ERR  , __VA_ARGS__)
 
-#define _LOG3T_ENABLED(...)  _NMLOG3_ENABLED (LOGL_TRACE, ##__VA_ARGS__)
 #define _LOG3D_ENABLED(...)  _NMLOG3_ENABLED (LOGL_DEBUG, ##__VA_ARGS__)
 #define _LOG3I_ENABLED(...)  _NMLOG3_ENABLED (LOGL_INFO , ##__VA_ARGS__)
 #define _LOG3W_ENABLED(...)  _NMLOG3_ENABLED (LOGL_WARN , ##__VA_ARGS__)
 #define _LOG3E_ENABLED(...)  _NMLOG3_ENABLED (LOGL_ERR  , ##__VA_ARGS__)
 
-#define _LOG3T_err(errsv, ...) _NMLOG3_err (errsv, LOGL_TRACE, __VA_ARGS__)
 #define _LOG3D_err(errsv, ...) _NMLOG3_err (errsv, LOGL_DEBUG, __VA_ARGS__)
 #define _LOG3I_err(errsv, ...) _NMLOG3_err (errsv, LOGL_INFO , __VA_ARGS__)
 #define _LOG3W_err(errsv, ...) _NMLOG3_err (errsv, LOGL_WARN , __VA_ARGS__)
 #define _LOG3E_err(errsv, ...) _NMLOG3_err (errsv, LOGL_ERR  , __VA_ARGS__)
 
 #ifdef NM_MORE_LOGGING
-#define _LOG3t_ENABLED(...)    _NMLOG3_ENABLED (LOGL_TRACE, ##__VA_ARGS__)
-#define _LOG3t(...)            _NMLOG3 (LOGL_TRACE, __VA_ARGS__)
-#define _LOG3t_err(errsv, ...) _NMLOG3_err (errsv, LOGL_TRACE, __VA_ARGS__)
+#define _LOG3t_ENABLED(...)    _LOG3T_ENABLED (__VA_ARGS__)
+#define _LOG3t(...)            _LOG3T (__VA_ARGS__)
+#define _LOG3t_err(errsv, ...) _LOG3T_err (errsv, __VA_ARGS__)
 #else
 /* still call the logging macros to get compile time checks, but they will be optimized out. */
 #define _LOG3t_ENABLED(...)    ( FALSE && (_NMLOG3_ENABLED (LOGL_TRACE, ##__VA_ARGS__)) )
@@ -533,6 +533,34 @@ nm_manager_get_activatable_connections (NMManager *manager, guint *out_len, gboo
 	return connections;
 }
 
+/* Like nm_manager_get_activatable_connections(), but only returns (sorted)
+ * connections with autoconnect enabled that are not locked to a different
+ * interface-name than the one of @device. This is only a prefilter, the
+ * caller still has to check whether the candidates are compatible with
+ * @device. */
+NMSettingsConnection **
+nm_manager_get_autoconnect_candidates (NMManager *manager, NMDevice *device, guint *out_len)
+{
+	NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE (manager);
+	NMSettingsConnection **connections;
+	guint i, j, len;
+
+	connections = nm_settings_get_autoconnect_candidates (priv->settings,
+	                                                      nm_device_get_iface (device),
+	                                                      &len);
+	for (i = 0, j = 0; i < len; i++) {
+		if (_get_activatable_connections_filter (priv->settings, connections[i], manager))
+			connections[j++] = connections[i];
+	}
+	connections[j] = NULL;
+	len = j;
+
+	if (len > 1)
+		g_qsort_with_data (connections, len, sizeof (connections[0]), nm_settings_connection_cmp_autoconnect_priority_p_with_data, NULL);
+	NM_SET_OUT (out_len, len);
+	return connections;
+}
+
 static NMActiveConnection *
 active_connection_get_by_path (NMManager *manager, const char *path)
 {
@@ -5248,6 +5276,10 @@ nm_manager_stop (NMManager *self)
 	_active_connection_cleanup (self);
 
 	nm_clear_g_source (&priv->devices_inited_id);
+
+	/* write pending timestamps and seen-bssids to disk. */
+	if (priv->settings)
+		nm_settings_flush_state (priv->settings);
 }
 
 static gboolean
@@ -90,6 +90,9 @@ const GSList *nm_manager_get_active_connections        (NMManager *manager);
 NMSettingsConnection **nm_manager_get_activatable_connections (NMManager *manager,
                                                                guint *out_len,
                                                                gboolean sort);
+NMSettingsConnection **nm_manager_get_autoconnect_candidates (NMManager *manager,
+                                                              NMDevice *device,
+                                                              guint *out_len);
 
 void          nm_manager_write_device_state (NMManager *manager);
 
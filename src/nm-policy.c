@@ -1218,7 +1218,7 @@ auto_activate_device (NMPolicy *self,
 	if (!nm_device_autoconnect_allowed (device))
 		return;
 
-	connections = nm_manager_get_activatable_connections (priv->manager, &len, TRUE);
+	connections = nm_manager_get_autoconnect_candidates (priv->manager, device, &len);
 	if (!connections[0])
 		return;
 
@@ -1950,6 +1950,20 @@ device_ip6_config_changed (NMDevice *device,
 
 /*****************************************************************************/
 
+static void
+device_connectivity_changed (NMDevice *device,
+                             GParamSpec *pspec,
+                             gpointer user_data)
+{
+	NMPolicyPrivate *priv = user_data;
+	NMPolicy *self = _PRIV_TO_SELF (priv);
+
+	/* the device's default routes got a different metric penalty, which
+	 * may change the best device. */
+	if (nm_device_get_state (device) == NM_DEVICE_STATE_ACTIVATED)
+		update_routing_and_dns (self, FALSE);
+}
+
 static void
 device_autoconnect_changed (NMDevice *device,
                             GParamSpec *pspec,
@@ -1990,6 +2004,7 @@ devices_list_register (NMPolicy *self, NMDevice *device)
 	g_signal_connect       (device, NM_DEVICE_IP6_PREFIX_DELEGATED,   (GCallback) device_ip6_prefix_delegated, priv);
 	g_signal_connect       (device, NM_DEVICE_IP6_SUBNET_NEEDED,      (GCallback) device_ip6_subnet_needed, priv);
 	g_signal_connect       (device, "notify::" NM_DEVICE_AUTOCONNECT, (GCallback) device_autoconnect_changed, priv);
+	g_signal_connect       (device, "notify::" NM_DEVICE_CONNECTIVITY, (GCallback) device_connectivity_changed, priv);
 	g_signal_connect       (device, NM_DEVICE_RECHECK_AUTO_ACTIVATE,  (GCallback) device_recheck_auto_activate, priv);
 }
 
@@ -363,16 +363,11 @@ static int _support_kernel_extended_ifa_flags = 0;
 #define _support_kernel_extended_ifa_flags_still_undecided() (G_UNLIKELY (_support_kernel_extended_ifa_flags == 0))
 
 static void
-_support_kernel_extended_ifa_flags_detect (struct nl_msg *msg)
+_support_kernel_extended_ifa_flags_detect (struct nlmsghdr *msg_hdr)
 {
-	struct nlmsghdr *msg_hdr;
 	gboolean support;
 
 	nm_assert (_support_kernel_extended_ifa_flags_still_undecided ());
-	nm_assert (msg);
-
-	msg_hdr = nlmsg_hdr (msg);
-
 	nm_assert (msg_hdr && msg_hdr->nlmsg_type == RTM_NEWADDR);
 
 	/* IFA_FLAGS is set for IPv4 and IPv6 addresses. It was added first to IPv6,
@@ -2307,21 +2302,14 @@ errout:
  *   be correctly detected.
  * @cache: (allow-none): for certain objects, the netlink message doesn't contain all the information.
  *   If a cache is given, the object is completed with information from the cache.
- * @nlh: the netlink message header
+ * @msghdr: the netlink message header
  * @id_only: whether only to create an empty object with only the ID fields set.
  *
  * Returns: %NULL or a newly created NMPObject instance.
  **/
 static NMPObject *
-nmp_object_new_from_nl (NMPlatform *platform, const NMPCache *cache, struct nl_msg *msg, gboolean id_only)
+nmp_object_new_from_nl (NMPlatform *platform, const NMPCache *cache, struct nlmsghdr *msghdr, gboolean id_only)
 {
-	struct nlmsghdr *msghdr;
-
-	if (nlmsg_get_proto (msg) != NETLINK_ROUTE)
-		return NULL;
-
-	msghdr = nlmsg_hdr (msg);
-
 	switch (msghdr->nlmsg_type) {
 	case RTM_NEWLINK:
 	case RTM_DELLINK:
@@ -2812,6 +2800,34 @@ typedef struct {
 	} response;
 } DelayedActionWaitForNlResponseData;
 
+/* number of datagrams read from the netlink socket with one recvmmsg() call. */
+#define NL_RECV_SLOTS_NUM        8
+
+/* Per-datagram receive buffer size. The kernel caps the datagrams of a dump
+ * at 32 KiB (unless a single object does not fit), so leave plenty of room
+ * to never truncate a message. If it still happens, the buffer is grown
+ * up to NL_RECV_SLOT_SIZE_MAX. */
+#define NL_RECV_SLOT_SIZE_INIT   ((gsize) (64 * 1024))
+#define NL_RECV_SLOT_SIZE_MAX    ((gsize) (512 * 1024))
+
+#ifdef HAVE_RECVMMSG
+typedef struct mmsghdr NLRecvMsg;
+#else
+typedef struct {
+	struct msghdr msg_hdr;
+	unsigned int msg_len;
+} NLRecvMsg;
+#endif
+
+typedef struct {
+	struct sockaddr_nl nla;
+	struct iovec iov;
+	union {
+		struct cmsghdr align;
+		char buf[CMSG_SPACE (sizeof (struct ucred))];
+	} cmsg;
+} NLRecvSlot;
+
 typedef struct {
 	struct nl_sock *nlh;
 	guint32 nlh_seq_next;
@@ -2845,6 +2861,30 @@ typedef struct {
 		gint is_handling;
 	} delayed_action;
 
+	struct {
+		/* the receive buffers for the netlink socket, @slot_size bytes for
+		 * each of the NL_RECV_SLOTS_NUM slots. They are filled by one
+		 * recvmmsg() call and the datagrams are parsed in place. */
+		guint8 *buf;
+		gsize slot_size;
+		gsize slot_size_next;
+
+		/* the datagrams received with the last recvmmsg() call, and the index
+		 * of the next one to process. */
+		guint n_filled;
+		guint idx_next;
+
+		/* event_handler_recvmsgs() may be called recursively while a datagram
+		 * from @buf is still being processed. In that case, a nested refill
+		 * uses a new buffer and the old ones are kept here until the outermost
+		 * call returns. */
+		guint depth;
+		GPtrArray *buf_retired;
+
+		NLRecvMsg msgs[NL_RECV_SLOTS_NUM];
+		NLRecvSlot slots[NL_RECV_SLOTS_NUM];
+	} nl_recv;
+
 	GHashTable *wifi_data;
 } NMLinuxPlatformPrivate;
 
@@ -3826,6 +3866,39 @@ _nlh_seq_next_get (NMLinuxPlatformPrivate *priv)
 	return priv->nlh_seq_next++ ?: priv->nlh_seq_next++;
 }
 
+/* Send @buf with one or more complete netlink messages in one datagram.
+ * Returns: 0 on success or a negative errno. */
+static int
+_nl_sendmsg_buf (NMPlatform *platform, gconstpointer buf, gsize len)
+{
+	NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE (platform);
+	struct sockaddr_nl nladdr = {
+		.nl_family = AF_NETLINK,
+	};
+	struct iovec iov = {
+		.iov_base = (gpointer) buf,
+		.iov_len = len,
+	};
+	struct msghdr msg = {
+		.msg_name = &nladdr,
+		.msg_namelen = sizeof (nladdr),
+		.msg_iov = &iov,
+		.msg_iovlen = 1,
+	};
+	int try_count = 0;
+	int errsv;
+
+again:
+	if (sendmsg (nl_socket_get_fd (priv->nlh), &msg, 0) < 0) {
+		errsv = errno;
+		if (errsv == EINTR && try_count++ < 100)
+			goto again;
+		_LOGD ("netlink: sendmsg: failed sending %zu bytes: %s (%d)", len, g_strerror (errsv), errsv);
+		return -errsv;
+	}
+	return 0;
+}
+
 /**
  * _nl_send_nlmsghdr:
  * @platform:
@@ -3852,37 +3925,13 @@ _nl_send_nlmsghdr (NMPlatform *platform,
 	seq = _nlh_seq_next_get (priv);
 	nlhdr->nlmsg_seq = seq;
 
-	{
-		struct sockaddr_nl nladdr = {
-			.nl_family = AF_NETLINK,
-		};
-		struct iovec iov = {
-			.iov_base = nlhdr,
-			.iov_len = nlhdr->nlmsg_len
-		};
-		struct msghdr msg = {
-			.msg_name = &nladdr,
-			.msg_namelen = sizeof(nladdr),
-			.msg_iov = &iov,
-			.msg_iovlen = 1,
-		};
-		int try_count;
+	if (!nlhdr->nlmsg_pid)
+		nlhdr->nlmsg_pid = nl_socket_get_local_port (priv->nlh);
+	nlhdr->nlmsg_flags |= (NLM_F_REQUEST | NLM_F_ACK);
 
-		if (!nlhdr->nlmsg_pid)
-			nlhdr->nlmsg_pid = nl_socket_get_local_port (priv->nlh);
-		nlhdr->nlmsg_flags |= (NLM_F_REQUEST | NLM_F_ACK);
-
-		try_count = 0;
-again:
-		nle = sendmsg (nl_socket_get_fd (priv->nlh), &msg, 0);
-		if (nle < 0) {
-			nle = errno;
-			if (nle == EINTR && try_count++ < 100)
-				goto again;
-			_LOGD ("netlink: nl-send-nlmsghdr: failed sending message: %s (%d)", g_strerror (nle), nle);
-			return -nle;
-		}
-	}
+	nle = _nl_sendmsg_buf (platform, nlhdr, nlhdr->nlmsg_len);
+	if (nle < 0)
+		return nle;
 
 	delayed_action_schedule_WAIT_FOR_NL_RESPONSE (platform, seq, out_seq_result,
 	                                              response_type, response_out_data);
@@ -4109,22 +4158,19 @@ event_seq_check (NMPlatform *platform, guint32 seq_number, WaitForNlResponseResu
 }
 
 static void
-event_valid_msg (NMPlatform *platform, struct nl_msg *msg, gboolean handle_events)
+event_valid_msg (NMPlatform *platform, struct nlmsghdr *msghdr, gboolean handle_events)
 {
 	NMLinuxPlatformPrivate *priv;
 	nm_auto_nmpobj NMPObject *obj = NULL;
 	NMPCacheOpsType cache_op;
-	struct nlmsghdr *msghdr;
 	char buf_nlmsghdr[400];
 	gboolean id_only = FALSE;
 	NMPCache *cache = nm_platform_get_cache (platform);
 	gboolean is_dump;
 
-	msghdr = nlmsg_hdr (msg);
-
 	if (   _support_kernel_extended_ifa_flags_still_undecided ()
 	    && msghdr->nlmsg_type == RTM_NEWADDR)
-		_support_kernel_extended_ifa_flags_detect (msg);
+		_support_kernel_extended_ifa_flags_detect (msghdr);
 
 	if (!handle_events)
 		return;
@@ -4135,7 +4181,7 @@ event_valid_msg (NMPlatform *platform, struct nl_msg *msg, gboolean handle_event
 		id_only = TRUE;
 	}
 
-	obj = nmp_object_new_from_nl (platform, cache, msg, id_only);
+	obj = nmp_object_new_from_nl (platform, cache, msghdr, id_only);
 	if (!obj) {
 		_LOGT ("event-notification: %s: ignore",
 		       _nl_nlmsghdr_to_str (msghdr, buf_nlmsghdr, sizeof (buf_nlmsghdr)));
@@ -4195,7 +4241,7 @@ event_valid_msg (NMPlatform *platform, struct nl_msg *msg, gboolean handle_event
 						if (   data->response_type == DELAYED_ACTION_RESPONSE_TYPE_ROUTE_GET
 						    && data->response.out_route_get) {
 							nm_assert (!*data->response.out_route_get);
-							if (data->seq_number == nlmsg_hdr (msg)->nlmsg_seq) {
+							if (data->seq_number == msghdr->nlmsg_seq) {
 								*data->response.out_route_get = nmp_object_clone (obj, FALSE);
 								data->response.out_route_get = NULL;
 								break;
@@ -4323,32 +4369,13 @@ do_add_link_with_lookup (NMPlatform *platform,
 }
 
 static NMPlatformError
-do_add_addrroute (NMPlatform *platform,
-                  const NMPObject *obj_id,
-                  struct nl_msg *nlmsg,
-                  gboolean suppress_netlink_failure)
+_do_add_addrroute_complete (NMPlatform *platform,
+                            const NMPObject *obj_id,
+                            WaitForNlResponseResult seq_result,
+                            gboolean suppress_netlink_failure)
 {
-	WaitForNlResponseResult seq_result = WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN;
-	int nle;
 	char s_buf[256];
 
-	nm_assert (NM_IN_SET (NMP_OBJECT_GET_TYPE (obj_id),
-	                      NMP_OBJECT_TYPE_IP4_ADDRESS, NMP_OBJECT_TYPE_IP6_ADDRESS,
-	                      NMP_OBJECT_TYPE_IP4_ROUTE, NMP_OBJECT_TYPE_IP6_ROUTE));
-
-	event_handler_read_netlink (platform, FALSE);
-
-	nle = _nl_send_nlmsg (platform, nlmsg, &seq_result, DELAYED_ACTION_RESPONSE_TYPE_VOID, NULL);
-	if (nle < 0) {
-		_LOGE ("do-add-%s[%s]: failure sending netlink request \"%s\" (%d)",
-		       NMP_OBJECT_GET_CLASS (obj_id)->obj_type_name,
-		       nmp_object_to_string (obj_id, NMP_OBJECT_TO_STRING_ID, NULL, 0),
-		       nl_geterror (nle), -nle);
-		return NM_PLATFORM_ERROR_NETLINK;
-	}
-
-	delayed_action_handle_all (platform, FALSE);
-
 	nm_assert (seq_result);
 
 	_NMLOG ((   seq_result == WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK
@@ -4376,28 +4403,44 @@ do_add_addrroute (NMPlatform *platform,
 	return wait_for_nl_response_to_plerr (seq_result);
 }
 
-static gboolean
-do_delete_object (NMPlatform *platform, const NMPObject *obj_id, struct nl_msg *nlmsg)
+static NMPlatformError
+do_add_addrroute (NMPlatform *platform,
+                  const NMPObject *obj_id,
+                  struct nl_msg *nlmsg,
+                  gboolean suppress_netlink_failure)
 {
 	WaitForNlResponseResult seq_result = WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN;
 	int nle;
-	char s_buf[256];
-	gboolean success;
-	const char *log_detail = "";
+
+	nm_assert (NM_IN_SET (NMP_OBJECT_GET_TYPE (obj_id),
+	                      NMP_OBJECT_TYPE_IP4_ADDRESS, NMP_OBJECT_TYPE_IP6_ADDRESS,
+	                      NMP_OBJECT_TYPE_IP4_ROUTE, NMP_OBJECT_TYPE_IP6_ROUTE));
 
 	event_handler_read_netlink (platform, FALSE);
 
 	nle = _nl_send_nlmsg (platform, nlmsg, &seq_result, DELAYED_ACTION_RESPONSE_TYPE_VOID, NULL);
 	if (nle < 0) {
-		_LOGE ("do-delete-%s[%s]: failure sending netlink request \"%s\" (%d)",
+		_LOGE ("do-add-%s[%s]: failure sending netlink request \"%s\" (%d)",
 		       NMP_OBJECT_GET_CLASS (obj_id)->obj_type_name,
 		       nmp_object_to_string (obj_id, NMP_OBJECT_TO_STRING_ID, NULL, 0),
 		       nl_geterror (nle), -nle);
-		return FALSE;
+		return NM_PLATFORM_ERROR_NETLINK;
 	}
 
 	delayed_action_handle_all (platform, FALSE);
 
+	return _do_add_addrroute_complete (platform, obj_id, seq_result, suppress_netlink_failure);
+}
+
+static gboolean
+_do_delete_object_complete (NMPlatform *platform,
+                            const NMPObject *obj_id,
+                            WaitForNlResponseResult seq_result)
+{
+	char s_buf[256];
+	gboolean success;
+	const char *log_detail = "";
+
 	nm_assert (seq_result);
 
 	success = TRUE;
@@ -4437,6 +4480,28 @@ do_delete_object (NMPlatform *platform, const NMPObject *obj_id, struct nl_msg *
 	return success;
 }
 
+static gboolean
+do_delete_object (NMPlatform *platform, const NMPObject *obj_id, struct nl_msg *nlmsg)
+{
+	WaitForNlResponseResult seq_result = WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN;
+	int nle;
+
+	event_handler_read_netlink (platform, FALSE);
+
+	nle = _nl_send_nlmsg (platform, nlmsg, &seq_result, DELAYED_ACTION_RESPONSE_TYPE_VOID, NULL);
+	if (nle < 0) {
+		_LOGE ("do-delete-%s[%s]: failure sending netlink request \"%s\" (%d)",
+		       NMP_OBJECT_GET_CLASS (obj_id)->obj_type_name,
+		       nmp_object_to_string (obj_id, NMP_OBJECT_TO_STRING_ID, NULL, 0),
+		       nl_geterror (nle), -nle);
+		return FALSE;
+	}
+
+	delayed_action_handle_all (platform, FALSE);
+
+	return _do_delete_object_complete (platform, obj_id, seq_result);
+}
+
 static NMPlatformError
 do_change_link (NMPlatform *platform,
                 ChangeLinkType change_link_type,
@@ -6132,6 +6197,162 @@ ip_route_delete (NMPlatform *platform,
 
 /*****************************************************************************/
 
+/* the maximum number of bytes that object_batch() packs into one sendmsg()
+ * call. The replies (and the notifications for the changes) must fit into
+ * the socket receive buffer. */
+#define OBJECT_BATCH_BUF_SIZE ((gsize) (32 * 1024))
+
+static struct nl_msg *
+_nl_msg_new_object_batch_op (const NMPlatformObjBatchOp *op)
+{
+	const NMPObject *obj = op->obj;
+
+	switch (NMP_OBJECT_GET_TYPE (obj)) {
+	case NMP_OBJECT_TYPE_IP4_ADDRESS: {
+		const NMPlatformIP4Address *a = NMP_OBJECT_CAST_IP4_ADDRESS (obj);
+
+		if (op->is_delete) {
+			return _nl_msg_new_address (RTM_DELADDR, 0, AF_INET, a->ifindex,
+			                            &a->address, a->plen, &a->peer_address,
+			                            0, RT_SCOPE_NOWHERE,
+			                            NM_PLATFORM_LIFETIME_PERMANENT, NM_PLATFORM_LIFETIME_PERMANENT,
+			                            NULL);
+		}
+		return _nl_msg_new_address (RTM_NEWADDR, NLM_F_CREATE | NLM_F_REPLACE, AF_INET, a->ifindex,
+		                            &a->address, a->plen, &a->peer_address,
+		                            op->ifa_flags,
+		                            nm_utils_ip4_address_is_link_local (a->address) ? RT_SCOPE_LINK : RT_SCOPE_UNIVERSE,
+		                            op->lifetime, op->preferred,
+		                            a->label);
+	}
+	case NMP_OBJECT_TYPE_IP6_ADDRESS: {
+		const NMPlatformIP6Address *a = NMP_OBJECT_CAST_IP6_ADDRESS (obj);
+
+		if (op->is_delete) {
+			return _nl_msg_new_address (RTM_DELADDR, 0, AF_INET6, a->ifindex,
+			                            &a->address, a->plen, NULL,
+			                            0, RT_SCOPE_NOWHERE,
+			                            NM_PLATFORM_LIFETIME_PERMANENT, NM_PLATFORM_LIFETIME_PERMANENT,
+			                            NULL);
+		}
+		return _nl_msg_new_address (RTM_NEWADDR, NLM_F_CREATE | NLM_F_REPLACE, AF_INET6, a->ifindex,
+		                            &a->address, a->plen, &a->peer_address,
+		                            op->ifa_flags, RT_SCOPE_UNIVERSE,
+		                            op->lifetime, op->preferred,
+		                            NULL);
+	}
+	case NMP_OBJECT_TYPE_IP4_ROUTE:
+	case NMP_OBJECT_TYPE_IP6_ROUTE:
+		if (op->is_delete)
+			return _nl_msg_new_route (RTM_DELROUTE, 0, obj);
+		else {
+			NMPObject obj_norm;
+
+			nmp_object_stackinit (&obj_norm, NMP_OBJECT_GET_TYPE (obj), &obj->object);
+			nm_platform_ip_route_normalize (NMP_OBJECT_GET_CLASS (obj)->addr_family,
+			                                NMP_OBJECT_CAST_IP_ROUTE (&obj_norm));
+			return _nl_msg_new_route (RTM_NEWROUTE, op->nlm_flags & NMP_NLM_FLAG_FMASK, &obj_norm);
+		}
+	default:
+		g_return_val_if_reached (NULL);
+	}
+}
+
+static void
+object_batch (NMPlatform *platform, NMPlatformObjBatchOp *ops, guint n_ops)
+{
+	NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE (platform);
+	gs_free WaitForNlResponseResult *seq_results = NULL;
+	gs_free guint32 *seqs = NULL;
+	GByteArray *buf;
+	guint i, i_start, j;
+	int errsv;
+
+	nm_assert (n_ops > 0);
+
+	/* The kernel handles the messages of one datagram in order and sends
+	 * a separate ACK for each of them. Thus, we can pack many requests
+	 * into one sendmsg() call and track the replies by their sequence
+	 * numbers, just as if the requests were sent individually. */
+
+	seq_results = g_new0 (WaitForNlResponseResult, n_ops);
+	seqs = g_new0 (guint32, n_ops);
+	buf = g_byte_array_sized_new (OBJECT_BATCH_BUF_SIZE);
+
+	event_handler_read_netlink (platform, FALSE);
+
+	for (i_start = 0; i_start < n_ops; i_start = i) {
+		g_byte_array_set_size (buf, 0);
+
+		for (i = i_start; i < n_ops; i++) {
+			nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
+			struct nlmsghdr *nlhdr;
+			gsize len_aligned;
+
+			nlmsg = _nl_msg_new_object_batch_op (&ops[i]);
+			if (!nlmsg)
+				continue;
+
+			nlhdr = nlmsg_hdr (nlmsg);
+			len_aligned = NLMSG_ALIGN (nlhdr->nlmsg_len);
+			if (   buf->len > 0
+			    && buf->len + len_aligned > OBJECT_BATCH_BUF_SIZE)
+				break;
+
+			seqs[i] = _nlh_seq_next_get (priv);
+			nlhdr->nlmsg_seq = seqs[i];
+			nlhdr->nlmsg_pid = nl_socket_get_local_port (priv->nlh);
+			nlhdr->nlmsg_flags |= (NLM_F_REQUEST | NLM_F_ACK);
+
+			g_byte_array_append (buf, (const guint8 *) nlhdr, nlhdr->nlmsg_len);
+			g_byte_array_set_size (buf, buf->len + (len_aligned - nlhdr->nlmsg_len));
+		}
+
+		if (buf->len == 0)
+			continue;
+
+		errsv = _nl_sendmsg_buf (platform, buf->data, buf->len);
+		if (errsv < 0) {
+			_LOGE ("do-object-batch: failure sending netlink request with %u messages: %s (%d)",
+			       i - i_start, g_strerror (-errsv), -errsv);
+			for (j = i_start; j < i; j++)
+				seqs[j] = 0;
+			continue;
+		}
+
+		for (j = i_start; j < i; j++) {
+			if (seqs[j]) {
+				delayed_action_schedule_WAIT_FOR_NL_RESPONSE (platform, seqs[j], &seq_results[j],
+				                                              DELAYED_ACTION_RESPONSE_TYPE_VOID, NULL);
+			}
+		}
+
+		delayed_action_handle_all (platform, FALSE);
+	}
+
+	g_byte_array_unref (buf);
+
+	for (i = 0; i < n_ops; i++) {
+		NMPlatformObjBatchOp *op = &ops[i];
+
+		if (!seqs[i]) {
+			op->plerr = NM_PLATFORM_ERROR_NETLINK;
+			continue;
+		}
+
+		if (op->is_delete) {
+			op->plerr =   _do_delete_object_complete (platform, op->obj, seq_results[i])
+			            ? NM_PLATFORM_ERROR_SUCCESS
+			            : wait_for_nl_response_to_plerr (seq_results[i]);
+		} else {
+			op->plerr = _do_add_addrroute_complete (platform, op->obj, seq_results[i],
+			                                        NM_FLAGS_HAS (op->nlm_flags, NMP_NLM_FLAG_SUPPRESS_NETLINK_FAILURE));
+		}
+	}
+}
+
+/*****************************************************************************/
+
 static NMPlatformError
 ip_route_get (NMPlatform *platform,
               int addr_family,
@@ -6226,99 +6447,188 @@ event_handler (GIOChannel *channel,
 
 /*****************************************************************************/
 
-/* copied from libnl3's recvmsgs() */
+static void
+_nl_recv_buf_release (NMLinuxPlatformPrivate *priv)
+{
+	if (!priv->nl_recv.buf)
+		return;
+
+	if (priv->nl_recv.depth > 1) {
+		/* an outer event_handler_recvmsgs() call may still parse a datagram
+		 * from this buffer. Keep it alive until it returns. */
+		if (!priv->nl_recv.buf_retired)
+			priv->nl_recv.buf_retired = g_ptr_array_new_with_free_func (g_free);
+		g_ptr_array_add (priv->nl_recv.buf_retired, priv->nl_recv.buf);
+	} else
+		g_free (priv->nl_recv.buf);
+	priv->nl_recv.buf = NULL;
+}
+
 static int
-event_handler_recvmsgs (NMPlatform *platform, gboolean handle_events)
+_nl_recv_fill (NMPlatform *platform)
 {
 	NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE (platform);
-	struct nl_sock *sk = priv->nlh;
-	int n, err = 0, multipart = 0, interrupted = 0;
-	struct nlmsghdr *hdr;
-	WaitForNlResponseResult seq_result;
+	int fd = nl_socket_get_fd (priv->nlh);
+	gsize slot_size;
+	guint i;
+	int n, errsv;
 
-	/*
-	nla is passed on to not only to nl_recv() but may also be passed
-	to a function pointer provided by the caller which may or may not
-	initialize the variable. Thomas Graf.
-	*/
-	struct sockaddr_nl nla = {0};
-	nm_auto_free struct ucred *creds = NULL;
-	nm_auto_free unsigned char *buf = NULL;
+	nm_assert (priv->nl_recv.idx_next == priv->nl_recv.n_filled);
 
-continue_reading:
-	g_clear_pointer (&buf, free);
-	g_clear_pointer (&creds, free);
-	errno = 0;
-	n = nl_recv (sk, &nla, &buf, &creds);
-
-	if (n <= 0) {
-		/* workaround libnl3 <= 3.2.15 returning danling pointers in case nl_recv()
-		 * fails. Fixed by libnl3 69468517d0de1675d80f24661ff57a5dbac7275c. */
-		buf = NULL;
-		creds = NULL;
-	}
-
-	switch (n) {
-	case 0:
-		/* Work around a libnl bug fixed in 3.2.22 (375a6294) */
-		if (errno == EAGAIN) {
-			/* EAGAIN is equal to EWOULDBLOCK. If it would not be, we'd have to
-			 * workaround libnl3 mapping EWOULDBLOCK to -NLE_FAILURE. */
-			G_STATIC_ASSERT (EAGAIN == EWOULDBLOCK);
-			n = -NLE_AGAIN;
+	priv->nl_recv.n_filled = 0;
+	priv->nl_recv.idx_next = 0;
+
+	if (   priv->nl_recv.depth > 1
+	    || priv->nl_recv.slot_size != priv->nl_recv.slot_size_next)
+		_nl_recv_buf_release (priv);
+
+	slot_size = priv->nl_recv.slot_size_next;
+	if (!priv->nl_recv.buf) {
+		priv->nl_recv.buf = g_malloc (slot_size * NL_RECV_SLOTS_NUM);
+		priv->nl_recv.slot_size = slot_size;
+	}
+
+	for (i = 0; i < NL_RECV_SLOTS_NUM; i++) {
+		NLRecvSlot *slot = &priv->nl_recv.slots[i];
+
+		slot->iov.iov_base = &priv->nl_recv.buf[i * slot_size];
+		slot->iov.iov_len = slot_size;
+		priv->nl_recv.msgs[i] = (NLRecvMsg) {
+			.msg_hdr = {
+				.msg_name = &slot->nla,
+				.msg_namelen = sizeof (slot->nla),
+				.msg_iov = &slot->iov,
+				.msg_iovlen = 1,
+				.msg_control = slot->cmsg.buf,
+				.msg_controllen = sizeof (slot->cmsg.buf),
+			},
+		};
+	}
+
+again:
+#ifdef HAVE_RECVMMSG
+	n = recvmmsg (fd, priv->nl_recv.msgs, NL_RECV_SLOTS_NUM, MSG_DONTWAIT, NULL);
+#else
+	n = recvmsg (fd, &priv->nl_recv.msgs[0].msg_hdr, MSG_DONTWAIT);
+	if (n >= 0) {
+		priv->nl_recv.msgs[0].msg_len = n;
+		n = 1;
+	}
+#endif
+	if (n < 0) {
+		errsv = errno;
+		if (errsv == EINTR)
+			goto again;
+		if (errsv == EAGAIN)
+			return -NLE_AGAIN;
+		if (errsv == ENOBUFS) {
+			/* we are very much interested in a overrun of the receive buffer.
+			 * Hack our own return code to signal the overrun. */
+			return -_NLE_NM_NOBUFS;
 		}
-		break;
-	case -NLE_MSG_TRUNC: {
-		int buf_size;
+		return -nl_syserr2nlerr (errsv);
+	}
+	if (n == 0)
+		return -NLE_AGAIN;
+
+	priv->nl_recv.n_filled = n;
+	return n;
+}
 
+/**
+ * _nl_recv_next:
+ * @platform: the platform instance
+ * @out_buf: (out): the received datagram. It points into the receive buffer
+ *   and is valid until the outermost event_handler_recvmsgs() returns.
+ * @out_creds: (out): the credentials of the sender.
+ * @out_has_creds: (out): whether @out_creds were received.
+ *
+ * Returns the next datagram from the socket. Multiple datagrams are read
+ * at once and handed out one by one.
+ *
+ * Returns: the length of the datagram or a negative libnl error code.
+ */
+static int
+_nl_recv_next (NMPlatform *platform,
+               unsigned char **out_buf,
+               struct ucred *out_creds,
+               gboolean *out_has_creds)
+{
+	NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE (platform);
+	struct msghdr *mhdr;
+	struct cmsghdr *cmsg;
+	guint idx;
+	int n;
+
+	if (priv->nl_recv.idx_next >= priv->nl_recv.n_filled) {
+		n = _nl_recv_fill (platform);
+		if (n < 0)
+			return n;
+	}
+
+	idx = priv->nl_recv.idx_next++;
+	mhdr = &priv->nl_recv.msgs[idx].msg_hdr;
+
+	if (NM_FLAGS_HAS (mhdr->msg_flags, MSG_TRUNC)) {
 		/* the message receive buffer was too small. We lost one message, which
 		 * is unfortunate. Try to double the buffer size for the next time. */
-		buf_size = nl_socket_get_msg_buf_size (sk);
-		if (buf_size < 512*1024) {
-			buf_size *= 2;
-			_LOGT ("netlink: recvmsg: increase message buffer size for recvmsg() to %d bytes", buf_size);
-			if (nl_socket_set_msg_buf_size (sk, buf_size) < 0)
-				nm_assert_not_reached ();
-			if (!handle_events)
-				goto continue_reading;
+		if (priv->nl_recv.slot_size_next < NL_RECV_SLOT_SIZE_MAX) {
+			priv->nl_recv.slot_size_next *= 2;
+			_LOGT ("netlink: recvmsg: increase message buffer size for recvmsg() to %zu bytes",
+			       priv->nl_recv.slot_size_next);
 		}
-		n = -_NLE_MSG_TRUNC;
-		break;
+		return -_NLE_MSG_TRUNC;
 	}
-	case -NLE_NOMEM:
-		if (errno == ENOBUFS) {
-			/* we are very much interested in a overrun of the receive buffer.
-			 * nl_recv() maps all kinds of errors to NLE_NOMEM, so check also
-			 * for errno explicitly. And if so, hack our own return code to signal
-			 * the overrun. */
-			n = -_NLE_NM_NOBUFS;
+
+	*out_has_creds = FALSE;
+	for (cmsg = CMSG_FIRSTHDR (mhdr); cmsg; cmsg = CMSG_NXTHDR (mhdr, cmsg)) {
+		if (   cmsg->cmsg_level == SOL_SOCKET
+		    && cmsg->cmsg_type == SCM_CREDENTIALS) {
+			memcpy (out_creds, CMSG_DATA (cmsg), sizeof (*out_creds));
+			*out_has_creds = TRUE;
+			break;
 		}
-		break;
 	}
 
+	*out_buf = priv->nl_recv.slots[idx].iov.iov_base;
+	return priv->nl_recv.msgs[idx].msg_len;
+}
+
+/* copied from libnl3's recvmsgs() */
+static int
+_event_handler_recvmsgs (NMPlatform *platform, gboolean handle_events)
+{
+	NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE (platform);
+	int n, err = 0, multipart = 0, interrupted = 0;
+	struct nlmsghdr *hdr;
+	WaitForNlResponseResult seq_result;
+	struct ucred creds;
+	gboolean has_creds;
+	unsigned char *buf;
+	gsize slot_size_old;
+
+continue_reading:
+	slot_size_old = priv->nl_recv.slot_size_next;
+	n = _nl_recv_next (platform, &buf, &creds, &has_creds);
+
+	if (   n == -_NLE_MSG_TRUNC
+	    && priv->nl_recv.slot_size_next != slot_size_old
+	    && !handle_events)
+		goto continue_reading;
+
 	if (n <= 0)
 		return n;
 
 	hdr = (struct nlmsghdr *) buf;
 	while (nlmsg_ok (hdr, n)) {
-		nm_auto_nlmsg struct nl_msg *msg = NULL;
 		gboolean abort_parsing = FALSE;
 		gboolean process_valid_msg = FALSE;
 		guint32 seq_number;
 		char buf_nlmsghdr[400];
 
-		msg = nlmsg_convert (hdr);
-		if (!msg) {
-			err = -NLE_NOMEM;
-			goto out;
-		}
-
-		nlmsg_set_proto (msg, NETLINK_ROUTE);
-		nlmsg_set_src (msg, &nla);
-
-		if (!creds || creds->pid) {
-			if (creds)
-				_LOGT ("netlink: recvmsg: received non-kernel message (pid %d)", creds->pid);
+		if (!has_creds || creds.pid) {
+			if (has_creds)
+				_LOGT ("netlink: recvmsg: received non-kernel message (pid %d)", creds.pid);
 			else
 				_LOGT ("netlink: recvmsg: received message without credentials");
 			err = 0;
@@ -6328,9 +6638,6 @@ continue_reading:
 		_LOGt ("netlink: recvmsg: new message %s",
 		       _nl_nlmsghdr_to_str (hdr, buf_nlmsghdr, sizeof (buf_nlmsghdr)));
 
-		if (creds)
-			nlmsg_set_creds (msg, creds);
-
 		if (hdr->nlmsg_flags & NLM_F_MULTI)
 			multipart = 1;
 
@@ -6386,14 +6693,14 @@ continue_reading:
 				_LOGD ("netlink: recvmsg: error message from kernel: %s (%d) for request %d",
 				       strerror (errsv),
 				       errsv,
-				       nlmsg_hdr (msg)->nlmsg_seq);
+				       hdr->nlmsg_seq);
 				seq_result = -errsv;
 			} else
 				seq_result = WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK;
 		} else
 			process_valid_msg = TRUE;
 
-		seq_number = nlmsg_hdr (msg)->nlmsg_seq;
+		seq_number = hdr->nlmsg_seq;
 
 		/* check whether the seq number is different from before, and
 		 * whether the previous number (@nlh_seq_last_seen) is a pending
@@ -6409,7 +6716,7 @@ continue_reading:
 			 * get along with broken kernels. NL_SKIP has no
 			 * effect on this.  */
 
-			event_valid_msg (platform, msg, handle_events);
+			event_valid_msg (platform, hdr, handle_events);
 
 			seq_result = WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK;
 		}
@@ -6434,12 +6741,25 @@ stop:
 		 * Repeat reading. */
 		goto continue_reading;
 	}
-out:
 	if (interrupted)
 		err = -NLE_DUMP_INTR;
 	return err;
 }
 
+static int
+event_handler_recvmsgs (NMPlatform *platform, gboolean handle_events)
+{
+	NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE (platform);
+	int err;
+
+	priv->nl_recv.depth++;
+	err = _event_handler_recvmsgs (platform, handle_events);
+	if (   --priv->nl_recv.depth == 0
+	    && priv->nl_recv.buf_retired)
+		g_ptr_array_set_size (priv->nl_recv.buf_retired, 0);
+	return err;
+}
+
 /*****************************************************************************/
 
 static gboolean
@@ -6693,6 +7013,7 @@ nm_linux_platform_init (NMLinuxPlatform *self)
 	NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE (self);
 
 	priv->nlh_seq_next = 1;
+	priv->nl_recv.slot_size_next = NL_RECV_SLOT_SIZE_INIT;
 	priv->delayed_action.list_master_connected = g_ptr_array_new ();
 	priv->delayed_action.list_refresh_link = g_ptr_array_new ();
 	priv->delayed_action.list_wait_for_nl_response = g_array_new (FALSE, TRUE, sizeof (DelayedActionWaitForNlResponseData));
@@ -6742,12 +7063,6 @@ constructed (GObject *_object)
 	nle = nl_socket_set_buffer_size (priv->nlh, 8*1024*1024, 0);
 	g_assert (!nle);
 
-	/* explicitly set the msg buffer size and disable MSG_PEEK.
-	 * If we later encounter NLE_MSG_TRUNC, we will adjust the buffer size. */
-	nl_socket_disable_msg_peek (priv->nlh);
-	nle = nl_socket_set_msg_buf_size (priv->nlh, 32 * 1024);
-	g_assert (!nle);
-
 	nle = nl_socket_add_memberships (priv->nlh,
 	                                 RTNLGRP_LINK,
 	                                 RTNLGRP_IPV4_IFADDR, RTNLGRP_IPV6_IFADDR,
@@ -6841,6 +7156,10 @@ finalize (GObject *object)
 	g_io_channel_unref (priv->event_channel);
 	nl_socket_free (priv->nlh);
 
+	g_free (priv->nl_recv.buf);
+	if (priv->nl_recv.buf_retired)
+		g_ptr_array_unref (priv->nl_recv.buf_retired);
+
 	g_hash_table_unref (priv->wifi_data);
 
 	if (priv->sysctl_get_prev_values) {
@@ -6941,6 +7260,7 @@ nm_linux_platform_class_init (NMLinuxPlatformClass *klass)
 
 	platform_class->ip_route_add = ip_route_add;
 	platform_class->ip_route_delete = ip_route_delete;
+	platform_class->object_batch = object_batch;
 	platform_class->ip_route_get = ip_route_get;
 
 	platform_class->check_kernel_support = check_kernel_support;
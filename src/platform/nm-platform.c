@@ -98,6 +98,11 @@ typedef struct _NMPlatformPrivate {
 	guint ip4_dev_route_blacklist_check_id;
 	guint ip4_dev_route_blacklist_gc_timeout_id;
 	GHashTable *ip4_dev_route_blacklist_hash;
+
+	/* per-ifindex RouteSyncState, for nm_platform_ip_route_get_prune_list_delta(). */
+	GHashTable *route_sync_states_4;
+	GHashTable *route_sync_states_6;
+
 	NMDedupMultiIndex *multi_idx;
 	NMPCache *cache;
 } NMPlatformPrivate;
@@ -3301,6 +3306,7 @@ nm_platform_ip4_address_sync (NMPlatform *self,
 	GHashTable *plat_subnets = NULL;
 	GHashTable *known_subnets = NULL;
 	gs_unref_hashtable GHashTable *known_addresses_idx = NULL;
+	gs_unref_array GArray *ops = NULL;
 	guint i, j, len;
 	NMPLookup lookup;
 	guint32 lifetime, preferred;
@@ -3428,6 +3434,7 @@ delete_and_next:
 	            : 0;
 
 	/* Add missing addresses */
+	ops = g_array_sized_new (FALSE, FALSE, sizeof (NMPlatformObjBatchOp), known_addresses->len);
 	for (i = 0; i < known_addresses->len; i++) {
 		const NMPObject *o;
 
@@ -3438,19 +3445,34 @@ delete_and_next:
 		known_address = NMP_OBJECT_CAST_IP4_ADDRESS (o);
 
 		if (!nm_utils_lifetime_get (known_address->timestamp, known_address->lifetime, known_address->preferred,
-		                            now, &lifetime, &preferred))
-			goto delete_and_next2;
-
-		if (!nm_platform_ip4_address_add (self, ifindex, known_address->address, known_address->plen,
-		                                  known_address->peer_address, lifetime, preferred,
-		                                  ifa_flags,
-		                                  known_address->label))
-			goto delete_and_next2;
-
-		continue;
-delete_and_next2:
-		nmp_object_unref (o);
-		known_addresses->pdata[i] = NULL;
+		                            now, &lifetime, &preferred)) {
+			nmp_object_unref (o);
+			known_addresses->pdata[i] = NULL;
+			continue;
+		}
+
+		g_array_append_val (ops, ((NMPlatformObjBatchOp) {
+			.obj = o,
+			.lifetime = lifetime,
+			.preferred = preferred,
+			.ifa_flags = ifa_flags,
+		}));
+	}
+
+	nm_platform_object_batch (self, (NMPlatformObjBatchOp *) ops->data, ops->len);
+
+	for (i = 0, j = 0; i < known_addresses->len; i++) {
+		const NMPObject *o;
+
+		o = known_addresses->pdata[i];
+		if (!o)
+			continue;
+
+		nm_assert (g_array_index (ops, NMPlatformObjBatchOp, j).obj == o);
+		if (g_array_index (ops, NMPlatformObjBatchOp, j++).plerr != NM_PLATFORM_ERROR_SUCCESS) {
+			nmp_object_unref (o);
+			known_addresses->pdata[i] = NULL;
+		}
 	}
 
 	return TRUE;
@@ -3477,11 +3499,15 @@ nm_platform_ip6_address_sync (NMPlatform *self,
                               gboolean keep_link_local)
 {
 	gs_unref_ptrarray GPtrArray *plat_addresses = NULL;
+	gs_unref_array GArray *ops = NULL;
 	NMPlatformIP6Address *address;
 	gint32 now = nm_utils_get_monotonic_timestamp_s ();
 	guint i;
 	NMPLookup lookup;
 	guint32 ifa_flags;
+	gboolean success = TRUE;
+
+	ops = g_array_new (FALSE, FALSE, sizeof (NMPlatformObjBatchOp));
 
 	/* Delete unknown addresses */
 	plat_addresses = nm_platform_lookup_clone (self,
@@ -3497,40 +3523,54 @@ nm_platform_ip6_address_sync (NMPlatform *self,
 			if (keep_link_local && IN6_IS_ADDR_LINKLOCAL (&address->address))
 				continue;
 
-			if (!array_contains_ip6_address (known_addresses, address, now))
-				nm_platform_ip6_address_delete (self, ifindex, address->address, address->plen);
+			if (!array_contains_ip6_address (known_addresses, address, now)) {
+				g_array_append_val (ops, ((NMPlatformObjBatchOp) {
+					.obj = plat_addresses->pdata[i],
+					.is_delete = TRUE,
+				}));
+			}
 		}
 	}
 
-	if (!known_addresses)
-		return TRUE;
+	if (known_addresses) {
+		ifa_flags =   nm_platform_check_kernel_support (self, NM_PLATFORM_KERNEL_SUPPORT_EXTENDED_IFA_FLAGS)
+		            ? IFA_F_NOPREFIXROUTE
+		            : 0;
 
-	ifa_flags =   nm_platform_check_kernel_support (self, NM_PLATFORM_KERNEL_SUPPORT_EXTENDED_IFA_FLAGS)
-	            ? IFA_F_NOPREFIXROUTE
-	            : 0;
+		/* Add missing addresses */
+		for (i = 0; i < known_addresses->len; i++) {
+			const NMPlatformIP6Address *known_address = NMP_OBJECT_CAST_IP6_ADDRESS (known_addresses->pdata[i]);
+			guint32 lifetime, preferred;
 
-	/* Add missing addresses */
-	for (i = 0; i < known_addresses->len; i++) {
-		const NMPlatformIP6Address *known_address = NMP_OBJECT_CAST_IP6_ADDRESS (known_addresses->pdata[i]);
-		guint32 lifetime, preferred;
+			if (NM_FLAGS_HAS (known_address->n_ifa_flags, IFA_F_TEMPORARY)) {
+				/* Kernel manages these */
+				continue;
+			}
 
-		if (NM_FLAGS_HAS (known_address->n_ifa_flags, IFA_F_TEMPORARY)) {
-			/* Kernel manages these */
-			continue;
+			if (!nm_utils_lifetime_get (known_address->timestamp, known_address->lifetime, known_address->preferred,
+			                            now, &lifetime, &preferred))
+				continue;
+
+			g_array_append_val (ops, ((NMPlatformObjBatchOp) {
+				.obj = known_addresses->pdata[i],
+				.lifetime = lifetime,
+				.preferred = preferred,
+				.ifa_flags = ifa_flags | known_address->n_ifa_flags,
+			}));
 		}
+	}
 
-		if (!nm_utils_lifetime_get (known_address->timestamp, known_address->lifetime, known_address->preferred,
-		                            now, &lifetime, &preferred))
-			continue;
+	nm_platform_object_batch (self, (NMPlatformObjBatchOp *) ops->data, ops->len);
 
-		if (!nm_platform_ip6_address_add (self, ifindex, known_address->address,
-		                                  known_address->plen, known_address->peer_address,
-		                                  lifetime, preferred,
-		                                  ifa_flags | known_address->n_ifa_flags))
-			return FALSE;
+	for (i = 0; i < ops->len; i++) {
+		const NMPlatformObjBatchOp *op = &g_array_index (ops, NMPlatformObjBatchOp, i);
+
+		if (   !op->is_delete
+		    && op->plerr != NM_PLATFORM_ERROR_SUCCESS)
+			success = FALSE;
 	}
 
-	return TRUE;
+	return success;
 }
 
 gboolean
@@ -3591,6 +3631,21 @@ _err_inval_due_to_ipv6_tentative_pref_src (NMPlatform *self, const NMPObject *ob
 	return TRUE;
 }
 
+static gboolean
+_route_table_sync_mode_covers (NMIPRouteTableSyncMode route_table_sync,
+                               const NMPObject *obj)
+{
+	switch (route_table_sync) {
+	case NM_IP_ROUTE_TABLE_SYNC_MODE_FULL:
+		return nm_platform_route_table_uncoerce (NMP_OBJECT_CAST_IP_ROUTE (obj)->table_coerced, TRUE) != RT_TABLE_LOCAL;
+	case NM_IP_ROUTE_TABLE_SYNC_MODE_MAIN:
+		return nm_platform_route_table_is_main (NMP_OBJECT_CAST_IP_ROUTE (obj)->table_coerced);
+	default:
+		nm_assert (route_table_sync == NM_IP_ROUTE_TABLE_SYNC_MODE_ALL);
+		return TRUE;
+	}
+}
+
 GPtrArray *
 nm_platform_ip_route_get_prune_list (NMPlatform *self,
                                      int addr_family,
@@ -3623,14 +3678,8 @@ nm_platform_ip_route_get_prune_list (NMPlatform *self,
 	c_list_for_each (iter, &head_entry->lst_entries_head) {
 		const NMPObject *obj = c_list_entry (iter, NMDedupMultiEntry, lst_entries)->obj;
 
-		if (route_table_sync == NM_IP_ROUTE_TABLE_SYNC_MODE_FULL) {
-			if (nm_platform_route_table_uncoerce (NMP_OBJECT_CAST_IP_ROUTE (obj)->table_coerced, TRUE) == RT_TABLE_LOCAL)
-				continue;
-		} else if (route_table_sync == NM_IP_ROUTE_TABLE_SYNC_MODE_MAIN) {
-			if (!nm_platform_route_table_is_main (NMP_OBJECT_CAST_IP_ROUTE (obj)->table_coerced))
-				continue;
-		} else
-			nm_assert (route_table_sync == NM_IP_ROUTE_TABLE_SYNC_MODE_ALL);
+		if (!_route_table_sync_mode_covers (route_table_sync, obj))
+			continue;
 
 		g_ptr_array_add (routes_prune, (gpointer) nmp_object_ref (obj));
 	}
@@ -3669,6 +3718,7 @@ nm_platform_ip_route_sync (NMPlatform *self,
 {
 	const NMPlatformVTableRoute *vt;
 	gs_unref_hashtable GHashTable *routes_idx = NULL;
+	gs_unref_array GArray *ops = NULL;
 	const NMPObject *conf_o;
 	const NMDedupMultiEntry *plat_entry;
 	guint i;
@@ -3686,10 +3736,12 @@ nm_platform_ip_route_sync (NMPlatform *self,
 	     ? &nm_platform_vtable_route_v4
 	     : &nm_platform_vtable_route_v6;
 
+	/* first collect all changes, so that they can be sent to kernel
+	 * in one batch. See nm_platform_object_batch(). */
+	ops = g_array_new (FALSE, FALSE, sizeof (NMPlatformObjBatchOp));
+
 	for (i_type = 0; routes && i_type < 2; i_type++) {
 		for (i = 0; i < routes->len; i++) {
-			NMPlatformError plerr;
-
 			conf_o = routes->pdata[i];
 
 #define VTABLE_IS_DEVICE_ROUTE(vt, o) (vt->is_ip4 \
@@ -3728,67 +3780,18 @@ nm_platform_ip_route_sync (NMPlatform *self,
 					continue;
 
 				/* we need to replace the existing route with a (slightly) differnt
-				 * one. Delete it first. */
-				if (!nm_platform_ip_route_delete (self, plat_o)) {
-					/* ignore error. */
-				}
+				 * one. Delete it first. Errors are ignored. */
+				g_array_append_val (ops, ((NMPlatformObjBatchOp) {
+					.obj = plat_o,
+					.is_delete = TRUE,
+				}));
 			}
 
-			plerr = nm_platform_ip_route_add (self,
-			                                    NMP_NLM_FLAG_APPEND
-			                                  | NMP_NLM_FLAG_SUPPRESS_NETLINK_FAILURE,
-			                                  conf_o);
-			if (plerr != NM_PLATFORM_ERROR_SUCCESS) {
-				if (-((int) plerr) == EEXIST) {
-					/* Don't fail for EEXIST. It's not clear that the existing route
-					 * is identical to the one that we were about to add. However,
-					 * above we should have deleted conflicting (non-identical) routes. */
-					if (_LOGD_ENABLED ()) {
-						plat_entry = nm_platform_lookup_entry (self,
-						                                       NMP_CACHE_ID_TYPE_OBJECT_TYPE,
-						                                       conf_o);
-						if (!plat_entry) {
-							_LOGD ("route-sync: adding route %s failed with EEXIST, however we cannot find such a route",
-							       nmp_object_to_string (conf_o, NMP_OBJECT_TO_STRING_PUBLIC, sbuf1, sizeof (sbuf1)));
-						} else if (vt->route_cmp (NMP_OBJECT_CAST_IPX_ROUTE (conf_o),
-						                          NMP_OBJECT_CAST_IPX_ROUTE (plat_entry->obj),
-						                          NM_PLATFORM_IP_ROUTE_CMP_TYPE_SEMANTICALLY) != 0) {
-							_LOGD ("route-sync: adding route %s failed due to existing (different!) route %s",
-							       nmp_object_to_string (conf_o, NMP_OBJECT_TO_STRING_PUBLIC, sbuf1, sizeof (sbuf1)),
-							       nmp_object_to_string (plat_entry->obj, NMP_OBJECT_TO_STRING_PUBLIC, sbuf2, sizeof (sbuf2)));
-						}
-					}
-				} else if (   -((int) plerr) == EINVAL
-				           && out_temporary_not_available
-				           && _err_inval_due_to_ipv6_tentative_pref_src (self, conf_o)) {
-					_LOGD ("route-sync: ignore failure to add IPv6 route with tentative IPv6 pref-src: %s: %s",
-					       nmp_object_to_string (conf_o, NMP_OBJECT_TO_STRING_PUBLIC, sbuf1, sizeof (sbuf1)),
-					       nm_platform_error_to_string (plerr, sbuf_err, sizeof (sbuf_err)));
-					if (!*out_temporary_not_available)
-						*out_temporary_not_available = g_ptr_array_new_full (0, (GDestroyNotify) nmp_object_unref);
-					g_ptr_array_add (*out_temporary_not_available, (gpointer) nmp_object_ref (conf_o));
-				} else if (NMP_OBJECT_CAST_IP_ROUTE (conf_o)->rt_source < NM_IP_CONFIG_SOURCE_USER) {
-					_LOGD ("route-sync: ignore failure to add IPv%c route: %s: %s",
-					       vt->is_ip4 ? '4' : '6',
-					       nmp_object_to_string (conf_o, NMP_OBJECT_TO_STRING_PUBLIC, sbuf1, sizeof (sbuf1)),
-					       nm_platform_error_to_string (plerr, sbuf_err, sizeof (sbuf_err)));
-				} else {
-					const char *reason = "";
-
-					if (   -((int) plerr) == ENETUNREACH
-					    && (  vt->is_ip4
-					        ? !!NMP_OBJECT_CAST_IP4_ROUTE (conf_o)->gateway
-					        : !IN6_IS_ADDR_UNSPECIFIED (&NMP_OBJECT_CAST_IP6_ROUTE (conf_o)->gateway)))
-						reason = "; is the gateway directly reachable?";
-
-					_LOGW ("route-sync: failure to add IPv%c route: %s: %s%s",
-					       vt->is_ip4 ? '4' : '6',
-					       nmp_object_to_string (conf_o, NMP_OBJECT_TO_STRING_PUBLIC, sbuf1, sizeof (sbuf1)),
-					       nm_platform_error_to_string (plerr, sbuf_err, sizeof (sbuf_err)),
-					       reason);
-					success = FALSE;
-				}
-			}
+			g_array_append_val (ops, ((NMPlatformObjBatchOp) {
+				.obj = conf_o,
+				.nlm_flags =   NMP_NLM_FLAG_APPEND
+				             | NMP_NLM_FLAG_SUPPRESS_NETLINK_FAILURE,
+			}));
 		}
 	}
 
@@ -3810,15 +3813,297 @@ nm_platform_ip_route_sync (NMPlatform *self,
 			                               prune_o))
 				continue;
 
-			if (!nm_platform_ip_route_delete (self, prune_o)) {
-				/* ignore error... */
+			/* errors are ignored. */
+			g_array_append_val (ops, ((NMPlatformObjBatchOp) {
+				.obj = prune_o,
+				.is_delete = TRUE,
+			}));
+		}
+	}
+
+	/* the objects in @ops are kept alive by @routes, @routes_prune
+	 * and the platform cache. The cache might change during the
+	 * batch, so take a reference. */
+	for (i = 0; i < ops->len; i++)
+		nmp_object_ref (g_array_index (ops, NMPlatformObjBatchOp, i).obj);
+
+	nm_platform_object_batch (self, (NMPlatformObjBatchOp *) ops->data, ops->len);
+
+	for (i = 0; i < ops->len; i++) {
+		const NMPlatformObjBatchOp *op = &g_array_index (ops, NMPlatformObjBatchOp, i);
+		NMPlatformError plerr = op->plerr;
+
+		conf_o = op->obj;
+
+		if (   op->is_delete
+		    || plerr == NM_PLATFORM_ERROR_SUCCESS)
+			continue;
+
+		if (-((int) plerr) == EEXIST) {
+			/* Don't fail for EEXIST. It's not clear that the existing route
+			 * is identical to the one that we were about to add. However,
+			 * above we should have deleted conflicting (non-identical) routes. */
+			if (_LOGD_ENABLED ()) {
+				plat_entry = nm_platform_lookup_entry (self,
+				                                       NMP_CACHE_ID_TYPE_OBJECT_TYPE,
+				                                       conf_o);
+				if (!plat_entry) {
+					_LOGD ("route-sync: adding route %s failed with EEXIST, however we cannot find such a route",
+					       nmp_object_to_string (conf_o, NMP_OBJECT_TO_STRING_PUBLIC, sbuf1, sizeof (sbuf1)));
+				} else if (vt->route_cmp (NMP_OBJECT_CAST_IPX_ROUTE (conf_o),
+				                          NMP_OBJECT_CAST_IPX_ROUTE (plat_entry->obj),
+				                          NM_PLATFORM_IP_ROUTE_CMP_TYPE_SEMANTICALLY) != 0) {
+					_LOGD ("route-sync: adding route %s failed due to existing (different!) route %s",
+					       nmp_object_to_string (conf_o, NMP_OBJECT_TO_STRING_PUBLIC, sbuf1, sizeof (sbuf1)),
+					       nmp_object_to_string (plat_entry->obj, NMP_OBJECT_TO_STRING_PUBLIC, sbuf2, sizeof (sbuf2)));
+				}
 			}
+		} else if (   -((int) plerr) == EINVAL
+		           && out_temporary_not_available
+		           && _err_inval_due_to_ipv6_tentative_pref_src (self, conf_o)) {
+			_LOGD ("route-sync: ignore failure to add IPv6 route with tentative IPv6 pref-src: %s: %s",
+			       nmp_object_to_string (conf_o, NMP_OBJECT_TO_STRING_PUBLIC, sbuf1, sizeof (sbuf1)),
+			       nm_platform_error_to_string (plerr, sbuf_err, sizeof (sbuf_err)));
+			if (!*out_temporary_not_available)
+				*out_temporary_not_available = g_ptr_array_new_full (0, (GDestroyNotify) nmp_object_unref);
+			g_ptr_array_add (*out_temporary_not_available, (gpointer) nmp_object_ref (conf_o));
+		} else if (NMP_OBJECT_CAST_IP_ROUTE (conf_o)->rt_source < NM_IP_CONFIG_SOURCE_USER) {
+			_LOGD ("route-sync: ignore failure to add IPv%c route: %s: %s",
+			       vt->is_ip4 ? '4' : '6',
+			       nmp_object_to_string (conf_o, NMP_OBJECT_TO_STRING_PUBLIC, sbuf1, sizeof (sbuf1)),
+			       nm_platform_error_to_string (plerr, sbuf_err, sizeof (sbuf_err)));
+		} else {
+			const char *reason = "";
+
+			if (   -((int) plerr) == ENETUNREACH
+			    && (  vt->is_ip4
+			        ? !!NMP_OBJECT_CAST_IP4_ROUTE (conf_o)->gateway
+			        : !IN6_IS_ADDR_UNSPECIFIED (&NMP_OBJECT_CAST_IP6_ROUTE (conf_o)->gateway)))
+				reason = "; is the gateway directly reachable?";
+
+			_LOGW ("route-sync: failure to add IPv%c route: %s: %s%s",
+			       vt->is_ip4 ? '4' : '6',
+			       nmp_object_to_string (conf_o, NMP_OBJECT_TO_STRING_PUBLIC, sbuf1, sizeof (sbuf1)),
+			       nm_platform_error_to_string (plerr, sbuf_err, sizeof (sbuf_err)),
+			       reason);
+			success = FALSE;
 		}
 	}
 
+	for (i = 0; i < ops->len; i++)
+		nmp_object_unref (g_array_index (ops, NMPlatformObjBatchOp, i).obj);
+
 	return success;
 }
 
+/*****************************************************************************/
+
+typedef struct {
+	NMIPRouteTableSyncMode route_table_sync;
+
+	/* the routes passed to the last nm_platform_ip_route_get_prune_list_delta()
+	 * call, indexed by their ID. Holds a reference on the objects. */
+	GHashTable *routes;
+
+	/* the routes that appeared in the platform cache since the last call
+	 * and that are not in @routes, for example added by another daemon.
+	 * Indexed by their ID, the values are the cached objects. */
+	GHashTable *routes_dirty;
+} RouteSyncState;
+
+static void
+_route_sync_state_free (gpointer data)
+{
+	RouteSyncState *state = data;
+
+	g_hash_table_unref (state->routes);
+	g_hash_table_unref (state->routes_dirty);
+	g_slice_free (RouteSyncState, state);
+}
+
+static GHashTable *
+_route_sync_routes_new (void)
+{
+	return g_hash_table_new_full ((GHashFunc) nmp_object_id_hash,
+	                              (GEqualFunc) nmp_object_id_equal,
+	                              (GDestroyNotify) nmp_object_unref,
+	                              NULL);
+}
+
+static GHashTable **
+_route_sync_states_get (NMPlatformPrivate *priv, int addr_family)
+{
+	nm_assert (NM_IN_SET (addr_family, AF_INET, AF_INET6));
+
+	return   addr_family == AF_INET
+	       ? &priv->route_sync_states_4
+	       : &priv->route_sync_states_6;
+}
+
+static void
+_route_sync_state_forget (NMPlatform *self,
+                          int addr_family,
+                          int ifindex)
+{
+	NMPlatformPrivate *priv = NM_PLATFORM_GET_PRIVATE (self);
+	GHashTable **p_states;
+
+	p_states = _route_sync_states_get (priv, addr_family);
+	if (!*p_states)
+		return;
+
+	g_hash_table_remove (*p_states, GINT_TO_POINTER (ifindex));
+	if (g_hash_table_size (*p_states) == 0)
+		g_clear_pointer (p_states, g_hash_table_unref);
+}
+
+static void
+_route_sync_state_notify_route (NMPlatform *self,
+                                NMPCacheOpsType cache_op,
+                                const NMPObject *obj)
+{
+	NMPlatformPrivate *priv = NM_PLATFORM_GET_PRIVATE (self);
+	GHashTable *states;
+	RouteSyncState *state;
+
+	states = *_route_sync_states_get (priv,
+	                                  NMP_OBJECT_GET_TYPE (obj) == NMP_OBJECT_TYPE_IP4_ROUTE
+	                                  ? AF_INET
+	                                  : AF_INET6);
+	if (!states)
+		return;
+
+	state = g_hash_table_lookup (states, GINT_TO_POINTER (obj->object.ifindex));
+	if (!state)
+		return;
+
+	if (cache_op == NMP_CACHE_OPS_REMOVED) {
+		g_hash_table_remove (state->routes_dirty, obj);
+		return;
+	}
+
+	/* routes that we committed ourself are already tracked. */
+	if (g_hash_table_contains (state->routes, obj))
+		return;
+
+	g_hash_table_replace (state->routes_dirty, (gpointer) nmp_object_ref (obj), NULL);
+}
+
+/**
+ * nm_platform_ip_route_get_prune_list_delta:
+ * @self: the #NMPlatform instance.
+ * @addr_family: AF_INET or AF_INET6.
+ * @ifindex: the @ifindex for which the routes are to be synced.
+ * @routes: (allow-none): the list of routes that are about to be
+ *   configured with nm_platform_ip_route_sync().
+ * @route_table_sync: which tables are under control of NetworkManager.
+ *
+ * Like nm_platform_ip_route_get_prune_list(), but instead of returning
+ * every route on @ifindex, only return the routes that changed since the
+ * previous call for this @ifindex: the routes that were passed as @routes
+ * back then and are now gone, and the routes that appeared in the platform
+ * cache in the meantime without being passed as @routes (for example,
+ * added by the kernel, another daemon or the user) and are not in @routes
+ * now. That way, a commit does not need to walk all routes on the interface,
+ * which matters when other routing daemons place a large number of
+ * routes there, while the result is the same as with the full prune list.
+ *
+ * The state is tracked per @addr_family and @ifindex, because successive
+ * commits of one device usually come from different #NMIP4Config/#NMIP6Config
+ * instances. The first call for an interface, and a call after
+ * @route_table_sync changed, falls back to nm_platform_ip_route_get_prune_list().
+ * The state is dropped when the link disappears or on nm_platform_ip_route_flush().
+ *
+ * Returns: (transfer full): the list of routes to prune, or %NULL.
+ */
+GPtrArray *
+nm_platform_ip_route_get_prune_list_delta (NMPlatform *self,
+                                           int addr_family,
+                                           int ifindex,
+                                           GPtrArray *routes,
+                                           NMIPRouteTableSyncMode route_table_sync)
+{
+	NMPlatformPrivate *priv;
+	GHashTable **p_states;
+	RouteSyncState *state;
+	GPtrArray *routes_prune = NULL;
+	gs_unref_hashtable GHashTable *routes_new = NULL;
+	GHashTableIter iter;
+	const NMPObject *obj;
+	guint i;
+
+	nm_assert (NM_IS_PLATFORM (self));
+	nm_assert (NM_IN_SET (addr_family, AF_INET, AF_INET6));
+	nm_assert (ifindex > 0);
+
+	priv = NM_PLATFORM_GET_PRIVATE (self);
+
+	routes_new = _route_sync_routes_new ();
+	if (routes) {
+		for (i = 0; i < routes->len; i++) {
+			obj = routes->pdata[i];
+			g_hash_table_add (routes_new, (gpointer) nmp_object_ref (obj));
+		}
+	}
+
+	p_states = _route_sync_states_get (priv, addr_family);
+	state =   *p_states
+	        ? g_hash_table_lookup (*p_states, GINT_TO_POINTER (ifindex))
+	        : NULL;
+
+	if (   !state
+	    || state->route_table_sync != route_table_sync) {
+		_LOGT ("route-sync: full sync of IPv%c routes on ifindex %d",
+		       addr_family == AF_INET ? '4' : '6', ifindex);
+		routes_prune = nm_platform_ip_route_get_prune_list (self,
+		                                                    addr_family,
+		                                                    ifindex,
+		                                                    route_table_sync);
+	} else {
+		g_hash_table_iter_init (&iter, state->routes);
+		while (g_hash_table_iter_next (&iter, (gpointer *) &obj, NULL)) {
+			if (g_hash_table_contains (routes_new, obj))
+				continue;
+			if (!_route_table_sync_mode_covers (route_table_sync, obj))
+				continue;
+			if (!routes_prune)
+				routes_prune = g_ptr_array_new_with_free_func ((GDestroyNotify) nmp_object_unref);
+			g_ptr_array_add (routes_prune, (gpointer) nmp_object_ref (obj));
+		}
+
+		g_hash_table_iter_init (&iter, state->routes_dirty);
+		while (g_hash_table_iter_next (&iter, (gpointer *) &obj, NULL)) {
+			if (   g_hash_table_contains (routes_new, obj)
+			    || g_hash_table_contains (state->routes, obj))
+				continue;
+			if (!_route_table_sync_mode_covers (route_table_sync, obj))
+				continue;
+			if (!routes_prune)
+				routes_prune = g_ptr_array_new_with_free_func ((GDestroyNotify) nmp_object_unref);
+			g_ptr_array_add (routes_prune, (gpointer) nmp_object_ref (obj));
+		}
+	}
+
+	if (!*p_states) {
+		*p_states = g_hash_table_new_full (g_direct_hash,
+		                                   g_direct_equal,
+		                                   NULL,
+		                                   _route_sync_state_free);
+	}
+	if (!state) {
+		state = g_slice_new0 (RouteSyncState);
+		state->routes_dirty = _route_sync_routes_new ();
+		g_hash_table_insert (*p_states, GINT_TO_POINTER (ifindex), state);
+	} else {
+		g_hash_table_unref (state->routes);
+		g_hash_table_remove_all (state->routes_dirty);
+	}
+	state->route_table_sync = route_table_sync;
+	state->routes = g_steal_pointer (&routes_new);
+
+	return routes_prune;
+}
+
 gboolean
 nm_platform_ip_route_flush (NMPlatform *self,
                             int addr_family,
@@ -3832,6 +4117,11 @@ nm_platform_ip_route_flush (NMPlatform *self,
 	                                   AF_INET,
 	                                   AF_INET6));
 
+	if (NM_IN_SET (addr_family, AF_UNSPEC, AF_INET))
+		_route_sync_state_forget (self, AF_INET, ifindex);
+	if (NM_IN_SET (addr_family, AF_UNSPEC, AF_INET6))
+		_route_sync_state_forget (self, AF_INET6, ifindex);
+
 	if (NM_IN_SET (addr_family, AF_UNSPEC, AF_INET)) {
 		gs_unref_ptrarray GPtrArray *routes_prune = NULL;
 
@@ -4004,6 +4294,104 @@ nm_platform_ip_route_delete (NMPlatform *self,
 	return klass->ip_route_delete (self, obj);
 }
 
+static NMPlatformError
+_object_batch_op_do (NMPlatform *self, const NMPlatformObjBatchOp *op)
+{
+	const NMPObject *obj = op->obj;
+	gboolean success;
+
+	switch (NMP_OBJECT_GET_TYPE (obj)) {
+	case NMP_OBJECT_TYPE_IP4_ADDRESS: {
+		const NMPlatformIP4Address *a = NMP_OBJECT_CAST_IP4_ADDRESS (obj);
+
+		if (op->is_delete)
+			success = nm_platform_ip4_address_delete (self, a->ifindex, a->address, a->plen, a->peer_address);
+		else {
+			success = nm_platform_ip4_address_add (self, a->ifindex, a->address, a->plen, a->peer_address,
+			                                       op->lifetime, op->preferred, op->ifa_flags, a->label);
+		}
+		break;
+	}
+	case NMP_OBJECT_TYPE_IP6_ADDRESS: {
+		const NMPlatformIP6Address *a = NMP_OBJECT_CAST_IP6_ADDRESS (obj);
+
+		if (op->is_delete)
+			success = nm_platform_ip6_address_delete (self, a->ifindex, a->address, a->plen);
+		else {
+			success = nm_platform_ip6_address_add (self, a->ifindex, a->address, a->plen, a->peer_address,
+			                                       op->lifetime, op->preferred, op->ifa_flags);
+		}
+		break;
+	}
+	case NMP_OBJECT_TYPE_IP4_ROUTE:
+	case NMP_OBJECT_TYPE_IP6_ROUTE:
+		if (!op->is_delete)
+			return nm_platform_ip_route_add (self, op->nlm_flags, obj);
+		success = nm_platform_ip_route_delete (self, obj);
+		break;
+	default:
+		g_return_val_if_reached (NM_PLATFORM_ERROR_BUG);
+	}
+
+	return success ? NM_PLATFORM_ERROR_SUCCESS : NM_PLATFORM_ERROR_UNSPECIFIED;
+}
+
+/**
+ * nm_platform_object_batch:
+ * @self: the #NMPlatform instance.
+ * @ops: the operations to perform, in order.
+ * @n_ops: the number of operations in @ops.
+ *
+ * Adds and deletes a list of addresses and routes. If the platform
+ * implementation supports it, the requests are sent together and the
+ * replies are collected at once, instead of waiting for the reply to
+ * each request before sending the next one. Otherwise, the operations
+ * are performed one by one.
+ *
+ * Either way, the operations are performed in order and the result of
+ * each one is returned in its @plerr field. For deletions, an object
+ * that is already gone counts as success.
+ */
+void
+nm_platform_object_batch (NMPlatform *self,
+                          NMPlatformObjBatchOp *ops,
+                          guint n_ops)
+{
+	char sbuf[sizeof (_nm_utils_to_string_buffer)];
+	guint i;
+
+	_CHECK_SELF_VOID (self, klass);
+
+	if (n_ops == 0)
+		return;
+
+	g_return_if_fail (ops);
+
+	if (!klass->object_batch) {
+		for (i = 0; i < n_ops; i++)
+			ops[i].plerr = _object_batch_op_do (self, &ops[i]);
+		return;
+	}
+
+	if (_LOGD_ENABLED ()) {
+		for (i = 0; i < n_ops; i++) {
+			const NMPObject *obj = ops[i].obj;
+
+			_LOGD ("batch: %-10s %s %s",
+			       ops[i].is_delete
+			         ? "delete"
+			         : (  NM_IN_SET (NMP_OBJECT_GET_TYPE (obj), NMP_OBJECT_TYPE_IP4_ROUTE,
+			                                                   NMP_OBJECT_TYPE_IP6_ROUTE)
+			            ? _nmp_nlm_flag_to_string (ops[i].nlm_flags & NMP_NLM_FLAG_FMASK)
+			            : "add"),
+			       NMP_OBJECT_GET_CLASS (obj)->obj_type_name,
+			       nmp_object_to_string (obj, NMP_OBJECT_TO_STRING_PUBLIC, sbuf, sizeof (sbuf)));
+		}
+	}
+
+	klass->object_batch (self, ops, n_ops);
+}
+
 /*****************************************************************************/
 
 NMPlatformError
@@ -6030,6 +6418,17 @@ nm_platform_cache_update_emit_signal (NMPlatform *self,
 
 	klass = NMP_OBJECT_GET_CLASS (o);
 
+	if (   klass->obj_type == NMP_OBJECT_TYPE_LINK
+	    && cache_op == NMP_CACHE_OPS_REMOVED) {
+		_route_sync_state_forget (self, AF_INET, o->object.ifindex);
+		_route_sync_state_forget (self, AF_INET6, o->object.ifindex);
+	}
+
+	if (   NM_IN_SET (klass->obj_type, NMP_OBJECT_TYPE_IP4_ROUTE,
+	                                   NMP_OBJECT_TYPE_IP6_ROUTE)
+	    && o->object.ifindex > 0)
+		_route_sync_state_notify_route (self, cache_op, o);
+
 	if (   klass->obj_type == NMP_OBJECT_TYPE_IP4_ROUTE
 	    && NM_PLATFORM_GET_PRIVATE (self)->ip4_dev_route_blacklist_gc_timeout_id
 	    && NM_IN_SET (cache_op, NMP_CACHE_OPS_ADDED, NMP_CACHE_OPS_UPDATED))
@@ -6183,6 +6582,8 @@ finalize (GObject *object)
 	nm_clear_g_source (&priv->ip4_dev_route_blacklist_check_id);
 	nm_clear_g_source (&priv->ip4_dev_route_blacklist_gc_timeout_id);
 	g_clear_pointer (&priv->ip4_dev_route_blacklist_hash, g_hash_table_unref);
+	g_clear_pointer (&priv->route_sync_states_4, g_hash_table_unref);
+	g_clear_pointer (&priv->route_sync_states_6, g_hash_table_unref);
 	g_clear_object (&self->_netns);
 	nm_dedup_multi_index_unref (priv->multi_idx);
 	nmp_cache_free (priv->cache);
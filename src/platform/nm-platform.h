@@ -665,6 +665,30 @@ typedef enum {
 	NM_PLATFORM_KERNEL_SUPPORT_RTA_PREF                         = (1LL <<  2),
 } NMPlatformKernelSupportFlags;
 
+/**
+ * NMPlatformObjBatchOp:
+ * @obj: the address or route to add or delete.
+ * @is_delete: whether to delete @obj instead of adding it.
+ * @nlm_flags: when adding a route, the #NMPNlmFlags for the request.
+ * @lifetime: when adding an address, the valid lifetime to set.
+ * @preferred: when adding an address, the preferred lifetime to set.
+ * @ifa_flags: when adding an address, the IFA_F_* flags to set.
+ * @plerr: (out): the result of the operation.
+ *
+ * One operation for nm_platform_object_batch(). For adding addresses,
+ * the lifetimes and flags of @obj are ignored in favour of the explicit
+ * fields, because they are relative to the time of the request.
+ */
+typedef struct {
+	const NMPObject *obj;
+	bool is_delete:1;
+	NMPNlmFlags nlm_flags;
+	guint32 lifetime;
+	guint32 preferred;
+	guint32 ifa_flags;
+	NMPlatformError plerr;
+} NMPlatformObjBatchOp;
+
 /*****************************************************************************/
 
 struct _NMPlatformPrivate;
@@ -824,6 +848,8 @@ typedef struct {
 	                                 const NMPlatformIPRoute *route);
 	gboolean (*ip_route_delete) (NMPlatform *, const NMPObject *obj);
 
+	void (*object_batch) (NMPlatform *, NMPlatformObjBatchOp *ops, guint n_ops);
+
 	NMPlatformError (*ip_route_get) (NMPlatform *self,
 	                                 int addr_family,
 	                                 gconstpointer address,
@@ -1223,10 +1249,19 @@ NMPlatformError nm_platform_ip6_route_add (NMPlatform *self, NMPNlmFlags flags,
 
 gboolean nm_platform_ip_route_delete (NMPlatform *self, const NMPObject *route);
 
+void nm_platform_object_batch (NMPlatform *self,
+                               NMPlatformObjBatchOp *ops,
+                               guint n_ops);
+
 GPtrArray *nm_platform_ip_route_get_prune_list (NMPlatform *self,
                                                 int addr_family,
                                                 int ifindex,
                                                 NMIPRouteTableSyncMode route_table_sync);
+GPtrArray *nm_platform_ip_route_get_prune_list_delta (NMPlatform *self,
+                                                      int addr_family,
+                                                      int ifindex,
+                                                      GPtrArray *routes,
+                                                      NMIPRouteTableSyncMode route_table_sync);
 
 gboolean nm_platform_ip_route_sync (NMPlatform *self,
                                     int addr_family,
@@ -835,6 +835,98 @@ again_find_idx:
 
 /*****************************************************************************/
 
+static void
+_route_sync_many_commit (GPtrArray *routes,
+                         guint expected_prune_len,
+                         const char *what)
+{
+	const int IFINDEX = nm_platform_link_get_ifindex (NM_PLATFORM_GET, DEVICE_NAME);
+	gs_unref_ptrarray GPtrArray *routes_prune = NULL;
+	gs_unref_ptrarray GPtrArray *routes_plat = NULL;
+	gint64 start_time;
+	gint64 time;
+
+	start_time = nm_utils_get_monotonic_timestamp_ns ();
+
+	routes_prune = nm_platform_ip_route_get_prune_list_delta (NM_PLATFORM_GET,
+	                                                          AF_INET,
+	                                                          IFINDEX,
+	                                                          routes,
+	                                                          NM_IP_ROUTE_TABLE_SYNC_MODE_MAIN);
+	g_assert_cmpint (routes_prune ? routes_prune->len : 0, ==, expected_prune_len);
+	g_assert (nm_platform_ip_route_sync (NM_PLATFORM_GET, AF_INET, IFINDEX, routes, routes_prune, NULL));
+
+	time = nm_utils_get_monotonic_timestamp_ns () - start_time;
+	_LOGI (">>> %s: commit of %u routes (prune %u) in %ld.%09ld seconds",
+	       what, routes->len, expected_prune_len,
+	       (long) (time / NM_UTILS_NS_PER_SECOND), (long) (time % NM_UTILS_NS_PER_SECOND));
+
+	routes_plat = nmtstp_ip4_route_get_all (NM_PLATFORM_GET, IFINDEX);
+	g_assert_cmpint (routes_plat ? routes_plat->len : 0, ==, routes->len);
+}
+
+static void
+test_ip4_route_sync_many (gconstpointer test_data)
+{
+	const guint n_routes = GPOINTER_TO_UINT (test_data);
+	const int IFINDEX = nm_platform_link_get_ifindex (NM_PLATFORM_GET, DEVICE_NAME);
+	gs_unref_ptrarray GPtrArray *routes = NULL;
+	gs_unref_ptrarray GPtrArray *routes2 = NULL;
+	guint i;
+
+	if (n_routes > 1000 && nmtst_test_quick ()) {
+		g_print ("Skipping test: don't run long running test %s (NMTST_DEBUG=slow)\n", g_get_prgname () ?: "test-route-linux");
+		g_test_skip ("Skip long running test");
+		return;
+	}
+
+	routes = g_ptr_array_new_with_free_func ((GDestroyNotify) nmp_object_unref);
+	routes2 = g_ptr_array_new_with_free_func ((GDestroyNotify) nmp_object_unref);
+	for (i = 0; i < n_routes; i++) {
+		NMPlatformIP4Route r = {
+			.ifindex = IFINDEX,
+			.rt_source = NM_IP_CONFIG_SOURCE_USER,
+			.network = htonl (0x0a000000u + i),
+			.plen = 32,
+			.metric = 100,
+		};
+		NMPObject *o;
+
+		nm_platform_ip_route_normalize (AF_INET, NM_PLATFORM_IP_ROUTE_CAST (&r));
+		o = nmp_object_new (NMP_OBJECT_TYPE_IP4_ROUTE, (const NMPlatformObject *) &r);
+		g_ptr_array_add (routes, o);
+		if (i % 10 != 0)
+			g_ptr_array_add (routes2, nmp_object_ref (o));
+	}
+
+	/* the first commit has no previous state and falls back to a full sync. */
+	_route_sync_many_commit (routes, 0, "initial");
+
+	/* committing the same routes again, nothing needs to be pruned. */
+	_route_sync_many_commit (routes, 0, "unchanged");
+
+	/* drop every tenth route. */
+	_route_sync_many_commit (routes2, routes->len - routes2->len, "remove");
+
+	/* and add them back. */
+	_route_sync_many_commit (routes, 0, "re-add");
+
+	/* a route added by somebody else between two commits is pruned by the
+	 * next commit, just like with a full sync. */
+	nmtstp_ip4_route_add (NM_PLATFORM_GET, IFINDEX, NM_IP_CONFIG_SOURCE_USER,
+	                      nmtst_inet4_from_string ("10.255.0.0"), 24, INADDR_ANY, 0, 100, 0);
+	_route_sync_many_commit (routes, 1, "foreign");
+
+	/* and together with routes that we no longer commit. */
+	nmtstp_ip4_route_add (NM_PLATFORM_GET, IFINDEX, NM_IP_CONFIG_SOURCE_USER,
+	                      nmtst_inet4_from_string ("10.255.0.0"), 24, INADDR_ANY, 0, 100, 0);
+	_route_sync_many_commit (routes2, routes->len - routes2->len + 1, "foreign-and-remove");
+
+	g_assert (nm_platform_ip_route_flush (NM_PLATFORM_GET, AF_INET, IFINDEX));
+}
+
+/*****************************************************************************/
+
 NMTstpSetupFunc const _nmtstp_setup_platform_func = SETUP;
 
 void
@@ -862,5 +954,7 @@ _nmtstp_setup_tests (void)
 		add_test_func_data ("/route/ip/1", test_ip, GINT_TO_POINTER (1));
 		add_test_func ("/route/ip_route_get", test_ip_route_get);
 		add_test_func ("/route/ip4_zero_gateway", test_ip4_zero_gateway);
+		add_test_func_data ("/route/ip4_sync_many/1000", test_ip4_route_sync_many, GUINT_TO_POINTER (1000));
+		add_test_func_data ("/route/ip4_sync_many/50000", test_ip4_route_sync_many, GUINT_TO_POINTER (50000));
 	}
 }
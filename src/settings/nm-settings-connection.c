@@ -36,12 +36,10 @@
 #include "NetworkManagerUtils.h"
 #include "nm-core-internal.h"
 #include "nm-audit-manager.h"
+#include "nm-settings.h"
 
 #include "introspection/org.freedesktop.NetworkManager.Settings.Connection.h"
 
-#define SETTINGS_TIMESTAMPS_FILE  NMSTATEDIR "/timestamps"
-#define SETTINGS_SEEN_BSSIDS_FILE NMSTATEDIR "/seen-bssids"
-
 #define AUTOCONNECT_RETRIES_UNSET       -2
 #define AUTOCONNECT_RETRIES_FOREVER     -1
 #define AUTOCONNECT_RETRIES_DEFAULT      4
@@ -70,6 +68,12 @@ static guint signals[LAST_SIGNAL] = { 0 };
 
 typedef struct _NMSettingsConnectionPrivate {
 
+	/* the NMSettings instance that owns the connection, which keeps the
+	 * timestamps and seen-bssids databases. Only set while the connection
+	 * is claimed by NMSettings, which holds a reference to itself for
+	 * that time. */
+	NMSettings *settings;
+
 	NMAgentManager *agent_mgr;
 	NMSessionMonitor *session_monitor;
 	gulong session_changed_id;
@@ -708,42 +712,6 @@ nm_settings_connection_commit_changes (NMSettingsConnection *self,
 	return TRUE;
 }
 
-static void
-remove_entry_from_db (NMSettingsConnection *self, const char* db_name)
-{
-	GKeyFile *key_file;
-	const char *db_file;
-
-	if (strcmp (db_name, "timestamps") == 0)
-		db_file = SETTINGS_TIMESTAMPS_FILE;
-	else if (strcmp (db_name, "seen-bssids") == 0)
-		db_file = SETTINGS_SEEN_BSSIDS_FILE;
-	else
-		return;
-
-	key_file = g_key_file_new ();
-	if (g_key_file_load_from_file (key_file, db_file, G_KEY_FILE_KEEP_COMMENTS, NULL)) {
-		const char *connection_uuid;
-		char *data;
-		gsize len;
-		GError *error = NULL;
-
-		connection_uuid = nm_settings_connection_get_uuid (self);
-
-		g_key_file_remove_key (key_file, db_name, connection_uuid, NULL);
-		data = g_key_file_to_data (key_file, &len, &error);
-		if (data) {
-			g_file_set_contents (db_file, data, len, &error);
-			g_free (data);
-		}
-		if (error) {
-			_LOGW ("error writing %s file '%s': %s", db_name, db_file, error->message);
-			g_error_free (error);
-		}
-	}
-	g_key_file_free (key_file);
-}
-
 gboolean
 nm_settings_connection_delete (NMSettingsConnection *self,
                                GError **error)
@@ -780,11 +748,9 @@ nm_settings_connection_delete (NMSettingsConnection *self,
 	                                 for_agents);
 	g_object_unref (for_agents);
 
-	/* Remove timestamp from timestamps database file */
-	remove_entry_from_db (self, "timestamps");
-
-	/* Remove connection from seen-bssids database file */
-	remove_entry_from_db (self, "seen-bssids");
+	/* Remove timestamp and seen-bssids from the look-aside databases */
+	if (priv->settings)
+		nm_settings_forget_connection_state (priv->settings, nm_settings_connection_get_uuid (self));
 
 	nm_settings_connection_signal_remove (self, FALSE);
 	return TRUE;
@@ -2275,7 +2241,8 @@ nm_settings_connection_get_timestamp (NMSettingsConnection *self,
  * @self: the #NMSettingsConnection
  * @timestamp: timestamp to set into the connection and to store into
  * the timestamps database
- * @flush_to_disk: if %TRUE, commit timestamp update to persistent storage
+ * @flush_to_disk: if %TRUE, commit timestamp update to persistent storage.
+ *   The database file is written with a delay, coalescing multiple updates.
  *
  * Updates the connection and timestamps database with the provided timestamp.
  **/
@@ -2285,11 +2252,6 @@ nm_settings_connection_update_timestamp (NMSettingsConnection *self,
                                          gboolean flush_to_disk)
 {
 	NMSettingsConnectionPrivate *priv = NM_SETTINGS_CONNECTION_GET_PRIVATE (self);
-	const char *connection_uuid;
-	GKeyFile *timestamps_file;
-	char *data, *tmp;
-	gsize len;
-	GError *error = NULL;
 
 	g_return_if_fail (NM_IS_SETTINGS_CONNECTION (self));
 
@@ -2300,66 +2262,48 @@ nm_settings_connection_update_timestamp (NMSettingsConnection *self,
 	if (flush_to_disk == FALSE)
 		return;
 
-	/* Save timestamp to timestamps database file */
-	timestamps_file = g_key_file_new ();
-	if (!g_key_file_load_from_file (timestamps_file, SETTINGS_TIMESTAMPS_FILE, G_KEY_FILE_KEEP_COMMENTS, &error)) {
-		if (!g_error_matches (error, G_FILE_ERROR, G_FILE_ERROR_NOENT))
-			_LOGW ("error parsing timestamps file '%s': %s", SETTINGS_TIMESTAMPS_FILE, error->message);
-		g_clear_error (&error);
-	}
+	/* Save timestamp to timestamps database. It gets written to disk later. */
+	if (priv->settings)
+		nm_settings_set_timestamp (priv->settings, nm_settings_connection_get_uuid (self), timestamp);
+}
 
-	connection_uuid = nm_settings_connection_get_uuid (self);
-	tmp = g_strdup_printf ("%" G_GUINT64_FORMAT, timestamp);
-	g_key_file_set_value (timestamps_file, "timestamps", connection_uuid, tmp);
-	g_free (tmp);
+/**
+ * nm_settings_connection_set_settings:
+ * @self: the #NMSettingsConnection
+ * @settings: (allow-none): the #NMSettings that claimed @self, or %NULL
+ *
+ * Sets the #NMSettings whose timestamps and seen-bssids databases are
+ * used by @self. If unset, the timestamp and the seen BSSIDs are only
+ * kept in @self.
+ **/
+void
+nm_settings_connection_set_settings (NMSettingsConnection *self,
+                                     NMSettings *settings)
+{
+	g_return_if_fail (NM_IS_SETTINGS_CONNECTION (self));
+	g_return_if_fail (!settings || NM_IS_SETTINGS (settings));
 
-	data = g_key_file_to_data (timestamps_file, &len, &error);
-	if (data) {
-		g_file_set_contents (SETTINGS_TIMESTAMPS_FILE, data, len, &error);
-		g_free (data);
-	}
-	if (error) {
-		_LOGW ("error saving timestamp to file '%s': %s", SETTINGS_TIMESTAMPS_FILE, error->message);
-		g_error_free (error);
-	}
-	g_key_file_free (timestamps_file);
+	NM_SETTINGS_CONNECTION_GET_PRIVATE (self)->settings = settings;
 }
 
 /**
  * nm_settings_connection_read_and_fill_timestamp:
  * @self: the #NMSettingsConnection
  *
- * Retrieves timestamp of the connection's last usage from database file and
+ * Retrieves timestamp of the connection's last usage from the timestamps database and
  * stores it into the connection private data.
  **/
 void
 nm_settings_connection_read_and_fill_timestamp (NMSettingsConnection *self)
 {
 	NMSettingsConnectionPrivate *priv = NM_SETTINGS_CONNECTION_GET_PRIVATE (self);
-	gs_unref_keyfile GKeyFile *timestamps_file = NULL;
-	gs_free_error GError *error = NULL;
-	gs_free char *tmp_str = NULL;
-	const char *connection_uuid;
-	gint64 timestamp;
+	guint64 timestamp;
 
 	g_return_if_fail (NM_IS_SETTINGS_CONNECTION (self));
 
-	timestamps_file = g_key_file_new ();
-	if (!g_key_file_load_from_file (timestamps_file, SETTINGS_TIMESTAMPS_FILE, G_KEY_FILE_KEEP_COMMENTS, &error)) {
-		_LOGD ("failed to read connection timestamp: %s", error->message);
-		return;
-	}
-
-	connection_uuid = nm_settings_connection_get_uuid (self);
-	tmp_str = g_key_file_get_value (timestamps_file, "timestamps", connection_uuid, &error);
-	if (!tmp_str) {
-		_LOGD ("failed to read connection timestamp: %s", error->message);
-		return;
-	}
-
-	timestamp = _nm_utils_ascii_str_to_int64 (tmp_str, 10, 0, G_MAXINT64, -1);
-	if (timestamp < 0) {
-		_LOGD ("failed to read connection timestamp: %s", "invalid number");
+	if (   !priv->settings
+	    || !nm_settings_get_timestamp (priv->settings, nm_settings_connection_get_uuid (self), &timestamp)) {
+		_LOGD ("failed to read connection timestamp: %s", "no valid entry in the database");
 		return;
 	}
 
@@ -2427,12 +2371,8 @@ nm_settings_connection_add_seen_bssid (NMSettingsConnection *self,
                                        const char *seen_bssid)
 {
 	NMSettingsConnectionPrivate *priv = NM_SETTINGS_CONNECTION_GET_PRIVATE (self);
-	const char *connection_uuid;
-	GKeyFile *seen_bssids_file;
-	char *data, *bssid_str;
-	const char **list;
-	gsize len;
-	GError *error = NULL;
+	gs_free const char **list = NULL;
+	char *bssid_str;
 	GHashTableIter iter;
 	guint n;
 
@@ -2452,60 +2392,30 @@ nm_settings_connection_add_seen_bssid (NMSettingsConnection *self,
 	while (g_hash_table_iter_next (&iter, NULL, (gpointer) &bssid_str))
 		list[n++] = bssid_str;
 
-	/* Save BSSID to seen-bssids file */
-	seen_bssids_file = g_key_file_new ();
-	g_key_file_set_list_separator (seen_bssids_file, ',');
-	if (!g_key_file_load_from_file (seen_bssids_file, SETTINGS_SEEN_BSSIDS_FILE, G_KEY_FILE_KEEP_COMMENTS, &error)) {
-		if (!g_error_matches (error, G_FILE_ERROR, G_FILE_ERROR_NOENT)) {
-			_LOGW ("error parsing seen-bssids file '%s': %s",
-			       SETTINGS_SEEN_BSSIDS_FILE, error->message);
-		}
-		g_clear_error (&error);
-	}
-
-	connection_uuid = nm_settings_connection_get_uuid (self);
-	g_key_file_set_string_list (seen_bssids_file, "seen-bssids", connection_uuid, list, n);
-	g_free (list);
-
-	data = g_key_file_to_data (seen_bssids_file, &len, &error);
-	if (data) {
-		g_file_set_contents (SETTINGS_SEEN_BSSIDS_FILE, data, len, &error);
-		g_free (data);
-	}
-	g_key_file_free (seen_bssids_file);
-
-	if (error) {
-		_LOGW ("error saving seen-bssids to file '%s': %s",
-		       SETTINGS_SEEN_BSSIDS_FILE, error->message);
-		g_error_free (error);
-	}
+	/* Save BSSIDs to the seen-bssids database. It gets written to disk later. */
+	if (priv->settings)
+		nm_settings_set_seen_bssids (priv->settings, nm_settings_connection_get_uuid (self), list, n);
 }
 
 /**
  * nm_settings_connection_read_and_fill_seen_bssids:
  * @self: the #NMSettingsConnection
  *
- * Retrieves seen BSSIDs of the connection from database file and stores then into the
+ * Retrieves seen BSSIDs of the connection from the seen-bssids database and stores them into the
  * connection private data.
  **/
 void
 nm_settings_connection_read_and_fill_seen_bssids (NMSettingsConnection *self)
 {
 	NMSettingsConnectionPrivate *priv = NM_SETTINGS_CONNECTION_GET_PRIVATE (self);
-	const char *connection_uuid;
-	GKeyFile *seen_bssids_file;
-	char **tmp_strv = NULL;
+	char **tmp_strv;
 	gsize i, len = 0;
 	NMSettingWireless *s_wifi;
 
-	/* Get seen BSSIDs from database file */
-	seen_bssids_file = g_key_file_new ();
-	g_key_file_set_list_separator (seen_bssids_file, ',');
-	if (g_key_file_load_from_file (seen_bssids_file, SETTINGS_SEEN_BSSIDS_FILE, G_KEY_FILE_KEEP_COMMENTS, NULL)) {
-		connection_uuid = nm_settings_connection_get_uuid (self);
-		tmp_strv = g_key_file_get_string_list (seen_bssids_file, "seen-bssids", connection_uuid, &len, NULL);
-	}
-	g_key_file_free (seen_bssids_file);
+	/* Get seen BSSIDs from database */
+	tmp_strv =   priv->settings
+	           ? nm_settings_get_seen_bssids (priv->settings, nm_settings_connection_get_uuid (self), &len)
+	           : NULL;
 
 	/* Update connection's seen-bssids */
 	if (tmp_strv) {
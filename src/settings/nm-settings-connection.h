@@ -201,6 +201,9 @@ void nm_settings_connection_update_timestamp (NMSettingsConnection *self,
                                               guint64 timestamp,
                                               gboolean flush_to_disk);
 
+void nm_settings_connection_set_settings (NMSettingsConnection *self,
+                                          NMSettings *settings);
+
 void nm_settings_connection_read_and_fill_timestamp (NMSettingsConnection *self);
 
 char **nm_settings_connection_get_seen_bssids (NMSettingsConnection *self);
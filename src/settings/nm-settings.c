@@ -135,6 +135,20 @@ enum {
 
 static guint signals[LAST_SIGNAL] = { 0 };
 
+typedef enum {
+	STATE_DB_TIMESTAMPS,
+	STATE_DB_SEEN_BSSIDS,
+	_STATE_DB_NUM,
+} StateDBType;
+
+/* Buckets of connections by a string key. Each connection is in at most
+ * one bucket, @keys remembers which one so that it can be moved when the
+ * connection changes. The index doesn't own references to the connections. */
+typedef struct {
+	GHashTable *buckets;
+	GHashTable *keys;
+} ConnIdx;
+
 typedef struct {
 	NMAgentManager *agent_mgr;
 
@@ -146,14 +160,34 @@ typedef struct {
 	gboolean connections_loaded;
 	GHashTable *connections;
 	NMSettingsConnection **connections_cached_list;
+
+	/* connections with autoconnect enabled, bucketed by their interface-name.
+	 * Connections that don't restrict the interface-name are kept in the
+	 * bucket with the empty key. */
+	ConnIdx autoconnect_idx;
+
+	/* wired and PPPoE connections, see _wired_idx_update(). */
+	ConnIdx wired_idx;
+
 	GSList *unmanaged_specs;
 	GSList *unrecognized_specs;
+	NMMatchSpecDevice *unmanaged_specs_compiled;
+	NMMatchSpecDevice *unrecognized_specs_compiled;
 
 	gboolean started;
 	gboolean startup_complete;
 
 	NMHostnameManager *hostname_manager;
 
+	/* the look-aside databases with per-connection state, indexed by
+	 * StateDBType. They are loaded once and written back to disk
+	 * with a delay. */
+	struct {
+		GKeyFile *keyfile;
+		bool dirty;
+	} state_db[_STATE_DB_NUM];
+	guint state_db_flush_id;
+
 } NMSettingsPrivate;
 
 struct _NMSettings {
@@ -532,6 +566,14 @@ nm_settings_get_unmanaged_specs (NMSettings *self)
 	return priv->unmanaged_specs;
 }
 
+const NMMatchSpecDevice *
+nm_settings_get_unmanaged_specs_compiled (NMSettings *self)
+{
+	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
+
+	return priv->unmanaged_specs_compiled;
+}
+
 static NMSettingsPlugin *
 get_plugin (NMSettings *self, guint32 capability)
 {
@@ -566,6 +608,7 @@ find_spec (GSList *spec_list, const char *spec)
 
 static void
 update_specs (NMSettings *self, GSList **specs_ptr,
+              NMMatchSpecDevice **compiled_ptr,
               GSList * (*get_specs_func) (NMSettingsPlugin *))
 {
 	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
@@ -587,6 +630,9 @@ update_specs (NMSettings *self, GSList **specs_ptr,
 
 		g_slist_free (specs);
 	}
+
+	nm_match_spec_device_free (*compiled_ptr);
+	*compiled_ptr = nm_match_spec_device_compile (*specs_ptr);
 }
 
 static void
@@ -597,6 +643,7 @@ unmanaged_specs_changed (NMSettingsPlugin *config,
 	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
 
 	update_specs (self, &priv->unmanaged_specs,
+	              &priv->unmanaged_specs_compiled,
 	              nm_settings_plugin_get_unmanaged_specs);
 	_notify (self, PROP_UNMANAGED_SPECS);
 }
@@ -609,6 +656,7 @@ unrecognized_specs_changed (NMSettingsPlugin *config,
 	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
 
 	update_specs (self, &priv->unrecognized_specs,
+	              &priv->unrecognized_specs_compiled,
 	              nm_settings_plugin_get_unrecognized_specs);
 }
 
@@ -827,9 +875,200 @@ next:
 	return success;
 }
 
+static void
+_conn_idx_init (ConnIdx *idx)
+{
+	idx->buckets = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, (GDestroyNotify) g_hash_table_unref);
+	idx->keys = g_hash_table_new_full (nm_direct_hash, NULL, NULL, g_free);
+}
+
+static void
+_conn_idx_destroy (ConnIdx *idx)
+{
+	g_clear_pointer (&idx->buckets, g_hash_table_destroy);
+	g_clear_pointer (&idx->keys, g_hash_table_destroy);
+}
+
+static GHashTable *
+_conn_idx_lookup (ConnIdx *idx, const char *key)
+{
+	return g_hash_table_lookup (idx->buckets, key);
+}
+
+/* Move @connection to the bucket @key of @idx. A %NULL @key removes it
+ * from the index. */
+static void
+_conn_idx_set (ConnIdx *idx, NMSettingsConnection *connection, const char *key)
+{
+	const char *old_key;
+	GHashTable *bucket;
+
+	old_key = g_hash_table_lookup (idx->keys, connection);
+	if (nm_streq0 (old_key, key))
+		return;
+
+	if (old_key) {
+		bucket = g_hash_table_lookup (idx->buckets, old_key);
+		nm_assert (bucket && g_hash_table_contains (bucket, connection));
+		g_hash_table_remove (bucket, connection);
+		if (g_hash_table_size (bucket) == 0)
+			g_hash_table_remove (idx->buckets, old_key);
+		g_hash_table_remove (idx->keys, connection);
+	}
+
+	if (!key)
+		return;
+
+	bucket = g_hash_table_lookup (idx->buckets, key);
+	if (!bucket) {
+		bucket = g_hash_table_new (nm_direct_hash, NULL);
+		g_hash_table_insert (idx->buckets, g_strdup (key), bucket);
+	}
+	g_hash_table_add (bucket, connection);
+	g_hash_table_insert (idx->keys, connection, g_strdup (key));
+}
+
+static void
+_autoconnect_idx_update (NMSettings *self, NMSettingsConnection *connection)
+{
+	NMSettingConnection *s_con;
+	const char *key = NULL;
+
+	s_con = nm_connection_get_setting_connection (NM_CONNECTION (connection));
+	if (s_con && nm_setting_connection_get_autoconnect (s_con))
+		key = nm_setting_connection_get_interface_name (s_con) ?: "";
+
+	_conn_idx_set (&NM_SETTINGS_GET_PRIVATE (self)->autoconnect_idx, connection, key);
+}
+
+static guint
+_autoconnect_idx_collect (NMSettings *self,
+                          const char *key,
+                          NMSettingsConnection **list,
+                          guint i)
+{
+	GHashTable *bucket;
+	GHashTableIter iter;
+	NMSettingsConnection *con;
+
+	bucket = _conn_idx_lookup (&NM_SETTINGS_GET_PRIVATE (self)->autoconnect_idx, key);
+	if (bucket) {
+		g_hash_table_iter_init (&iter, bucket);
+		while (g_hash_table_iter_next (&iter, (gpointer *) &con, NULL))
+			list[i++] = con;
+	}
+	return i;
+}
+
+/* Wired and PPPoE connections are indexed for have_connection_for_device().
+ * Connections locked to a MAC address are keyed by the canonical address,
+ * connections locked only to an interface-name by the name. All other
+ * wired connections apply to any device. */
+#define WIRED_IDX_KEY_ANY  "*"
+
+static void
+_wired_idx_update (NMSettings *self, NMSettingsConnection *connection)
+{
+	NMConnection *c = NM_CONNECTION (connection);
+	NMSettingWired *s_wired;
+	const char *ctype;
+	const char *iface;
+	const char *setting_hwaddr;
+	gs_free char *mac = NULL;
+	gs_free char *key = NULL;
+
+	ctype = nm_connection_get_connection_type (c);
+	if (NM_IN_STRSET (ctype, NM_SETTING_WIRED_SETTING_NAME,
+	                         NM_SETTING_PPPOE_SETTING_NAME)) {
+		s_wired = nm_connection_get_setting_wired (c);
+		setting_hwaddr = s_wired ? nm_setting_wired_get_mac_address (s_wired) : NULL;
+		iface = nm_connection_get_interface_name (c);
+
+		if (setting_hwaddr) {
+			mac = nm_utils_hwaddr_canonical (setting_hwaddr, -1);
+			key = g_strdup_printf ("mac:%s", mac ?: setting_hwaddr);
+		} else if (iface)
+			key = g_strdup_printf ("iface:%s", iface);
+		else
+			key = g_strdup (WIRED_IDX_KEY_ANY);
+	}
+
+	_conn_idx_set (&NM_SETTINGS_GET_PRIVATE (self)->wired_idx, connection, key);
+}
+
+static void
+_connection_idx_update (NMSettings *self, NMSettingsConnection *connection)
+{
+	_autoconnect_idx_update (self, connection);
+	_wired_idx_update (self, connection);
+}
+
+static void
+_connection_idx_remove (NMSettings *self, NMSettingsConnection *connection)
+{
+	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
+
+	_conn_idx_set (&priv->autoconnect_idx, connection, NULL);
+	_conn_idx_set (&priv->wired_idx, connection, NULL);
+}
+
+/**
+ * nm_settings_get_autoconnect_candidates:
+ * @self: the #NMSettings
+ * @iface: the interface name of the device, or %NULL
+ * @out_len: (allow-none): returns the number of returned connections.
+ *
+ * Returns the connections with autoconnect enabled that are not locked
+ * to an interface-name other than @iface. The candidates are not
+ * checked for anything else and not sorted.
+ *
+ * Returns: (transfer container): a NULL terminated array of
+ *   #NMSettingsConnection. The caller must free the array with g_free()
+ *   but must not unref the connections.
+ */
+NMSettingsConnection **
+nm_settings_get_autoconnect_candidates (NMSettings *self,
+                                        const char *iface,
+                                        guint *out_len)
+{
+	NMSettingsPrivate *priv;
+	NMSettingsConnection **list;
+	GHashTable *bucket;
+	guint len = 0;
+	guint i = 0;
+
+	g_return_val_if_fail (NM_IS_SETTINGS (self), NULL);
+
+	priv = NM_SETTINGS_GET_PRIVATE (self);
+
+	if (iface && !iface[0])
+		iface = NULL;
+
+	bucket = _conn_idx_lookup (&priv->autoconnect_idx, "");
+	if (bucket)
+		len += g_hash_table_size (bucket);
+	if (iface) {
+		bucket = _conn_idx_lookup (&priv->autoconnect_idx, iface);
+		if (bucket)
+			len += g_hash_table_size (bucket);
+	}
+
+	list = g_new (NMSettingsConnection *, (gsize) len + 1);
+	i = _autoconnect_idx_collect (self, "", list, i);
+	if (iface)
+		i = _autoconnect_idx_collect (self, iface, list, i);
+	nm_assert (i == len);
+	list[i] = NULL;
+
+	NM_SET_OUT (out_len, len);
+	return list;
+}
+
 static void
 connection_updated (NMSettingsConnection *connection, gboolean by_user, gpointer user_data)
 {
+	_connection_idx_update (NM_SETTINGS (user_data), connection);
+
 	g_signal_emit (NM_SETTINGS (user_data),
 	               signals[CONNECTION_UPDATED],
 	               0,
@@ -870,9 +1109,11 @@ connection_removed (NMSettingsConnection *connection, gpointer user_data)
 	g_signal_handlers_disconnect_by_func (connection, G_CALLBACK (connection_visibility_changed), self);
 	if (!priv->startup_complete)
 		g_signal_handlers_disconnect_by_func (connection, G_CALLBACK (connection_ready_changed), self);
+	nm_settings_connection_set_settings (connection, NULL);
 	g_object_unref (self);
 
 	/* Forget about the connection internally */
+	_connection_idx_remove (self, connection);
 	g_hash_table_remove (priv->connections, (gpointer) cpath);
 	g_clear_pointer (&priv->connections_cached_list, g_free);
 
@@ -984,6 +1225,8 @@ claim_connection (NMSettings *self, NMSettingsConnection *connection)
 		return;
 	}
 
+	nm_settings_connection_set_settings (connection, self);
+
 	/* Read timestamp from look-aside file and put it into the connection's data */
 	nm_settings_connection_read_and_fill_timestamp (connection);
 
@@ -1021,6 +1264,7 @@ claim_connection (NMSettings *self, NMSettingsConnection *connection)
 	                     (gpointer) nm_connection_get_path (NM_CONNECTION (connection)),
 	                     g_object_ref (connection));
 	g_clear_pointer (&priv->connections_cached_list, g_free);
+	_connection_idx_update (self, connection);
 
 	nm_utils_log_connection_diff (NM_CONNECTION (connection), NULL, LOGL_DEBUG, LOGD_CORE, "new connection", "++ ");
 
@@ -1570,63 +1814,98 @@ done:
 /*****************************************************************************/
 
 static gboolean
-have_connection_for_device (NMSettings *self, NMDevice *device)
+_wired_connection_applies (NMDevice *device, NMConnection *connection, const char *perm_hw_addr)
 {
-	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
-	GHashTableIter iter;
-	gpointer data;
 	NMSettingConnection *s_con;
 	NMSettingWired *s_wired;
 	const char *setting_hwaddr;
-	const char *perm_hw_addr;
+	const char *ctype, *iface;
 
-	g_return_val_if_fail (NM_IS_SETTINGS (self), FALSE);
+	if (!nm_device_check_connection_compatible (device, connection))
+		return FALSE;
 
-	perm_hw_addr = nm_device_get_permanent_hw_address (device);
+	s_con = nm_connection_get_setting_connection (connection);
 
-	/* Find a wired connection locked to the given MAC address, if any */
-	g_hash_table_iter_init (&iter, priv->connections);
-	while (g_hash_table_iter_next (&iter, NULL, &data)) {
-		NMConnection *connection = NM_CONNECTION (data);
-		const char *ctype, *iface;
+	iface = nm_setting_connection_get_interface_name (s_con);
+	if (iface && strcmp (iface, nm_device_get_iface (device)) != 0)
+		return FALSE;
 
-		if (!nm_device_check_connection_compatible (device, connection))
-			continue;
+	ctype = nm_setting_connection_get_connection_type (s_con);
+	if (   strcmp (ctype, NM_SETTING_WIRED_SETTING_NAME)
+	    && strcmp (ctype, NM_SETTING_PPPOE_SETTING_NAME))
+		return FALSE;
 
-		s_con = nm_connection_get_setting_connection (connection);
+	s_wired = nm_connection_get_setting_wired (connection);
 
-		iface = nm_setting_connection_get_interface_name (s_con);
-		if (iface && strcmp (iface, nm_device_get_iface (device)) != 0)
-			continue;
+	if (!s_wired && !strcmp (ctype, NM_SETTING_PPPOE_SETTING_NAME)) {
+		/* No wired setting; therefore the PPPoE connection applies to any device */
+		return TRUE;
+	}
 
-		ctype = nm_setting_connection_get_connection_type (s_con);
-		if (   strcmp (ctype, NM_SETTING_WIRED_SETTING_NAME)
-		    && strcmp (ctype, NM_SETTING_PPPOE_SETTING_NAME))
-			continue;
+	g_assert (s_wired != NULL);
+
+	setting_hwaddr = nm_setting_wired_get_mac_address (s_wired);
+	if (setting_hwaddr) {
+		/* A connection mac-locked to this device */
+		return    perm_hw_addr
+		       && nm_utils_hwaddr_matches (setting_hwaddr, -1, perm_hw_addr, -1);
+	}
 
-		s_wired = nm_connection_get_setting_wired (connection);
+	/* A connection that applies to any wired device */
+	return TRUE;
+}
 
-		if (!s_wired && !strcmp (ctype, NM_SETTING_PPPOE_SETTING_NAME)) {
-			/* No wired setting; therefore the PPPoE connection applies to any device */
+static gboolean
+_wired_idx_bucket_applies (NMSettings *self, const char *key, NMDevice *device, const char *perm_hw_addr)
+{
+	GHashTable *bucket;
+	GHashTableIter iter;
+	NMConnection *connection;
+
+	bucket = _conn_idx_lookup (&NM_SETTINGS_GET_PRIVATE (self)->wired_idx, key);
+	if (!bucket)
+		return FALSE;
+
+	g_hash_table_iter_init (&iter, bucket);
+	while (g_hash_table_iter_next (&iter, (gpointer *) &connection, NULL)) {
+		if (_wired_connection_applies (device, connection, perm_hw_addr))
 			return TRUE;
-		}
+	}
+	return FALSE;
+}
 
-		g_assert (s_wired != NULL);
+static gboolean
+have_connection_for_device (NMSettings *self, NMDevice *device)
+{
+	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
+	const char *perm_hw_addr;
+	gs_free char *key = NULL;
 
-		setting_hwaddr = nm_setting_wired_get_mac_address (s_wired);
-		if (setting_hwaddr) {
-			/* A connection mac-locked to this device */
-			if (   perm_hw_addr
-			    && nm_utils_hwaddr_matches (setting_hwaddr, -1, perm_hw_addr, -1))
-				return TRUE;
-		} else {
-			/* A connection that applies to any wired device */
+	g_return_val_if_fail (NM_IS_SETTINGS (self), FALSE);
+
+	perm_hw_addr = nm_device_get_permanent_hw_address (device);
+
+	/* Find a wired connection locked to the given MAC address or interface
+	 * name, or one that applies to any device. Only the matching buckets
+	 * of the index need to be checked. */
+	if (perm_hw_addr) {
+		gs_free char *mac = nm_utils_hwaddr_canonical (perm_hw_addr, -1);
+
+		key = g_strdup_printf ("mac:%s", mac ?: perm_hw_addr);
+		if (_wired_idx_bucket_applies (self, key, device, perm_hw_addr))
 			return TRUE;
-		}
+		g_clear_pointer (&key, g_free);
 	}
 
+	key = g_strdup_printf ("iface:%s", nm_device_get_iface (device));
+	if (_wired_idx_bucket_applies (self, key, device, perm_hw_addr))
+		return TRUE;
+
+	if (_wired_idx_bucket_applies (self, WIRED_IDX_KEY_ANY, device, perm_hw_addr))
+		return TRUE;
+
 	/* See if there's a known non-NetworkManager configuration for the device */
-	if (nm_device_spec_match_list (device, priv->unrecognized_specs))
+	if (nm_device_spec_match_compiled (device, priv->unrecognized_specs_compiled))
 		return TRUE;
 
 	return FALSE;
@@ -1799,6 +2078,228 @@ _hostname_changed_cb (NMHostnameManager *hostname_manager,
 
 /*****************************************************************************/
 
+/* how long to coalesce changes to the state databases before writing them. */
+#define STATE_DB_FLUSH_DELAY_SEC 10
+
+static const struct {
+	const char *filename;
+	const char *group;
+} state_db_info[_STATE_DB_NUM] = {
+	[STATE_DB_TIMESTAMPS]  = { .filename = NMSTATEDIR "/timestamps",  .group = "timestamps",  },
+	[STATE_DB_SEEN_BSSIDS] = { .filename = NMSTATEDIR "/seen-bssids", .group = "seen-bssids", },
+};
+
+static GKeyFile *
+_state_db_get (NMSettings *self, StateDBType db)
+{
+	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
+	gs_free_error GError *error = NULL;
+	GKeyFile *keyfile;
+
+	nm_assert (db < _STATE_DB_NUM);
+
+	if (G_LIKELY (priv->state_db[db].keyfile))
+		return priv->state_db[db].keyfile;
+
+	keyfile = g_key_file_new ();
+	g_key_file_set_list_separator (keyfile, ',');
+	if (!g_key_file_load_from_file (keyfile, state_db_info[db].filename, G_KEY_FILE_KEEP_COMMENTS, &error)) {
+		if (!g_error_matches (error, G_FILE_ERROR, G_FILE_ERROR_NOENT)) {
+			_LOGW ("error parsing %s file '%s': %s",
+			       state_db_info[db].group, state_db_info[db].filename, error->message);
+		}
+	}
+	priv->state_db[db].keyfile = keyfile;
+	return keyfile;
+}
+
+static void
+_state_db_write (NMSettings *self, StateDBType db)
+{
+	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
+	gs_free_error GError *error = NULL;
+	gs_free char *data = NULL;
+	gsize len;
+
+	if (!priv->state_db[db].dirty)
+		return;
+	priv->state_db[db].dirty = FALSE;
+
+	nm_assert (priv->state_db[db].keyfile);
+
+	/* g_file_set_contents() replaces the file atomically by renaming
+	 * a temporary file. */
+	data = g_key_file_to_data (priv->state_db[db].keyfile, &len, &error);
+	if (   !data
+	    || !g_file_set_contents (state_db_info[db].filename, data, len, &error)) {
+		_LOGW ("error writing %s file '%s': %s",
+		       state_db_info[db].group, state_db_info[db].filename, error->message);
+	}
+}
+
+/**
+ * nm_settings_flush_state:
+ * @self: the #NMSettings
+ *
+ * Writes pending changes to the timestamps and seen-bssids databases
+ * to disk now, instead of waiting for the delayed write.
+ */
+void
+nm_settings_flush_state (NMSettings *self)
+{
+	NMSettingsPrivate *priv;
+	StateDBType db;
+
+	g_return_if_fail (NM_IS_SETTINGS (self));
+
+	priv = NM_SETTINGS_GET_PRIVATE (self);
+
+	nm_clear_g_source (&priv->state_db_flush_id);
+	for (db = 0; db < _STATE_DB_NUM; db++)
+		_state_db_write (self, db);
+}
+
+static gboolean
+_state_db_flush_cb (gpointer user_data)
+{
+	NMSettings *self = user_data;
+
+	NM_SETTINGS_GET_PRIVATE (self)->state_db_flush_id = 0;
+	nm_settings_flush_state (self);
+	return G_SOURCE_REMOVE;
+}
+
+static void
+_state_db_set_dirty (NMSettings *self, StateDBType db)
+{
+	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
+
+	priv->state_db[db].dirty = TRUE;
+	if (!priv->state_db_flush_id)
+		priv->state_db_flush_id = g_timeout_add_seconds (STATE_DB_FLUSH_DELAY_SEC, _state_db_flush_cb, self);
+}
+
+/**
+ * nm_settings_get_timestamp:
+ * @self: the #NMSettings
+ * @uuid: the connection UUID
+ * @out_timestamp: (out): the timestamp of the connection's last usage
+ *
+ * Returns: %TRUE if the timestamps database has an entry for @uuid.
+ */
+gboolean
+nm_settings_get_timestamp (NMSettings *self, const char *uuid, guint64 *out_timestamp)
+{
+	gs_free char *tmp_str = NULL;
+	gint64 timestamp;
+
+	g_return_val_if_fail (NM_IS_SETTINGS (self), FALSE);
+	g_return_val_if_fail (uuid, FALSE);
+
+	tmp_str = g_key_file_get_value (_state_db_get (self, STATE_DB_TIMESTAMPS),
+	                                state_db_info[STATE_DB_TIMESTAMPS].group,
+	                                uuid, NULL);
+	if (!tmp_str)
+		return FALSE;
+
+	timestamp = _nm_utils_ascii_str_to_int64 (tmp_str, 10, 0, G_MAXINT64, -1);
+	if (timestamp < 0)
+		return FALSE;
+
+	*out_timestamp = timestamp;
+	return TRUE;
+}
+
+/**
+ * nm_settings_set_timestamp:
+ * @self: the #NMSettings
+ * @uuid: the connection UUID
+ * @timestamp: the timestamp to store
+ *
+ * Stores @timestamp for @uuid in the timestamps database. The file is
+ * written later.
+ */
+void
+nm_settings_set_timestamp (NMSettings *self, const char *uuid, guint64 timestamp)
+{
+	char buf[30];
+
+	g_return_if_fail (NM_IS_SETTINGS (self));
+	g_return_if_fail (uuid);
+
+	nm_sprintf_buf (buf, "%" G_GUINT64_FORMAT, timestamp);
+	g_key_file_set_value (_state_db_get (self, STATE_DB_TIMESTAMPS),
+	                      state_db_info[STATE_DB_TIMESTAMPS].group,
+	                      uuid, buf);
+	_state_db_set_dirty (self, STATE_DB_TIMESTAMPS);
+}
+
+/**
+ * nm_settings_get_seen_bssids:
+ * @self: the #NMSettings
+ * @uuid: the connection UUID
+ * @out_len: (out) (allow-none): the number of returned BSSIDs
+ *
+ * Returns: (transfer full): the BSSIDs stored for @uuid in the
+ *   seen-bssids database, or %NULL if there is no entry.
+ */
+char **
+nm_settings_get_seen_bssids (NMSettings *self, const char *uuid, gsize *out_len)
+{
+	g_return_val_if_fail (NM_IS_SETTINGS (self), NULL);
+	g_return_val_if_fail (uuid, NULL);
+
+	return g_key_file_get_string_list (_state_db_get (self, STATE_DB_SEEN_BSSIDS),
+	                                   state_db_info[STATE_DB_SEEN_BSSIDS].group,
+	                                   uuid, out_len, NULL);
+}
+
+/**
+ * nm_settings_set_seen_bssids:
+ * @self: the #NMSettings
+ * @uuid: the connection UUID
+ * @bssids: the BSSIDs to store
+ * @len: the number of elements in @bssids
+ *
+ * Stores @bssids for @uuid in the seen-bssids database. The file is
+ * written later.
+ */
+void
+nm_settings_set_seen_bssids (NMSettings *self, const char *uuid, const char *const*bssids, gsize len)
+{
+	g_return_if_fail (NM_IS_SETTINGS (self));
+	g_return_if_fail (uuid);
+
+	g_key_file_set_string_list (_state_db_get (self, STATE_DB_SEEN_BSSIDS),
+	                            state_db_info[STATE_DB_SEEN_BSSIDS].group,
+	                            uuid, bssids, len);
+	_state_db_set_dirty (self, STATE_DB_SEEN_BSSIDS);
+}
+
+/**
+ * nm_settings_forget_connection_state:
+ * @self: the #NMSettings
+ * @uuid: the connection UUID
+ *
+ * Removes the entries for @uuid from the timestamps and seen-bssids
+ * databases.
+ */
+void
+nm_settings_forget_connection_state (NMSettings *self, const char *uuid)
+{
+	StateDBType db;
+
+	g_return_if_fail (NM_IS_SETTINGS (self));
+	g_return_if_fail (uuid);
+
+	for (db = 0; db < _STATE_DB_NUM; db++) {
+		if (g_key_file_remove_key (_state_db_get (self, db), state_db_info[db].group, uuid, NULL))
+			_state_db_set_dirty (self, db);
+	}
+}
+
+/*****************************************************************************/
+
 gboolean
 nm_settings_start (NMSettings *self, GError **error)
 {
@@ -1885,6 +2386,8 @@ nm_settings_init (NMSettings *self)
 	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
 
 	priv->connections = g_hash_table_new_full (nm_str_hash, g_str_equal, NULL, g_object_unref);
+	_conn_idx_init (&priv->autoconnect_idx);
+	_conn_idx_init (&priv->wired_idx);
 
 	/* Hold a reference to the agent manager so it stays alive; the only
 	 * other holders are NMSettingsConnection objects which are often
@@ -1922,6 +2425,8 @@ dispose (GObject *object)
 		g_clear_object (&priv->hostname_manager);
 	}
 
+	nm_settings_flush_state (self);
+
 	G_OBJECT_CLASS (nm_settings_parent_class)->dispose (object);
 }
 
@@ -1930,17 +2435,25 @@ finalize (GObject *object)
 {
 	NMSettings *self = NM_SETTINGS (object);
 	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
+	StateDBType db;
 
 	g_hash_table_destroy (priv->connections);
 	g_clear_pointer (&priv->connections_cached_list, g_free);
+	_conn_idx_destroy (&priv->autoconnect_idx);
+	_conn_idx_destroy (&priv->wired_idx);
 
 	g_slist_free_full (priv->unmanaged_specs, g_free);
 	g_slist_free_full (priv->unrecognized_specs, g_free);
+	nm_match_spec_device_free (priv->unmanaged_specs_compiled);
+	nm_match_spec_device_free (priv->unrecognized_specs_compiled);
 
 	g_slist_free_full (priv->plugins, g_object_unref);
 
 	g_clear_object (&priv->config);
 
+	for (db = 0; db < _STATE_DB_NUM; db++)
+		g_clear_pointer (&priv->state_db[db].keyfile, g_key_file_unref);
+
 	G_OBJECT_CLASS (nm_settings_parent_class)->finalize (object);
 }
 
@@ -73,6 +73,13 @@ NMSettings *nm_settings_get (void);
 NMSettings *nm_settings_new (void);
 gboolean nm_settings_start (NMSettings *self, GError **error);
 
+gboolean nm_settings_get_timestamp (NMSettings *self, const char *uuid, guint64 *out_timestamp);
+void nm_settings_set_timestamp (NMSettings *self, const char *uuid, guint64 timestamp);
+char **nm_settings_get_seen_bssids (NMSettings *self, const char *uuid, gsize *out_len);
+void nm_settings_set_seen_bssids (NMSettings *self, const char *uuid, const char *const*bssids, gsize len);
+void nm_settings_forget_connection_state (NMSettings *self, const char *uuid);
+void nm_settings_flush_state (NMSettings *self);
+
 typedef void (*NMSettingsForEachFunc) (NMSettings *settings,
                                        NMSettingsConnection *connection,
                                        gpointer user_data);
@@ -105,6 +112,10 @@ NMSettingsConnection **nm_settings_get_connections_clone (NMSettings *self,
 NMSettingsConnection **nm_settings_get_connections_sorted (NMSettings *self,
                                                            guint *out_len);
 
+NMSettingsConnection **nm_settings_get_autoconnect_candidates (NMSettings *self,
+                                                               const char *iface,
+                                                               guint *out_len);
+
 NMSettingsConnection *nm_settings_add_connection (NMSettings *settings,
                                                   NMConnection *connection,
                                                   gboolean save_to_disk,
@@ -118,6 +129,7 @@ NMSettingsConnection *nm_settings_get_connection_by_uuid (NMSettings *settings,
 gboolean nm_settings_has_connection (NMSettings *self, NMSettingsConnection *connection);
 
 const GSList *nm_settings_get_unmanaged_specs (NMSettings *self);
+const NMMatchSpecDevice *nm_settings_get_unmanaged_specs_compiled (NMSettings *self);
 
 void nm_settings_device_added (NMSettings *self, NMDevice *device);
 
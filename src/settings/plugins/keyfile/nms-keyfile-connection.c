@@ -125,6 +125,7 @@ nms_keyfile_connection_init (NMSKeyfileConnection *connection)
 NMSKeyfileConnection *
 nms_keyfile_connection_new (NMConnection *source,
                             const char *full_path,
+                            NMConnection *preread,
                             GError **error)
 {
 	GObject *object;
@@ -133,14 +134,21 @@ nms_keyfile_connection_new (NMConnection *source,
 	gboolean update_unsaved = TRUE;
 
 	g_assert (source || full_path);
+	g_assert (!source || !preread);
 
 	/* If we're given a connection already, prefer that instead of re-reading */
 	if (source)
 		tmp = g_object_ref (source);
 	else {
-		tmp = nms_keyfile_reader_from_file (full_path, error);
-		if (!tmp)
-			return NULL;
+		/* @preread is the (already normalized) content of @full_path, which
+		 * was read ahead of time. */
+		if (preread)
+			tmp = g_object_ref (preread);
+		else {
+			tmp = nms_keyfile_reader_from_file (full_path, error);
+			if (!tmp)
+				return NULL;
+		}
 
 		uuid = nm_connection_get_uuid (NM_CONNECTION (tmp));
 		if (!uuid) {
@@ -40,6 +40,7 @@
 #include "settings/nm-settings-plugin.h"
 
 #include "nms-keyfile-connection.h"
+#include "nms-keyfile-reader.h"
 #include "nms-keyfile-writer.h"
 #include "nms-keyfile-utils.h"
 
@@ -130,12 +131,22 @@ find_by_path (NMSKeyfilePlugin *self, const char *path)
 	return NULL;
 }
 
+/* A keyfile that was read ahead of time, off the main thread. */
+typedef struct {
+	const char *filename;
+	NMConnection *connection;
+	GError *error;
+	GPtrArray *warnings;
+} ReadJob;
+
 /* update_connection:
  * @self: the plugin instance
  * @source: if %NULL, this re-reads the connection from @full_path
  *   and updates it. When passing @source, this adds a connection from
  *   memory.
  * @full_path: the filename of the keyfile to be loaded
+ * @preread: (allow-none): if given, the result of reading @full_path
+ *   ahead of time. The file is not read again. Only valid without @source.
  * @connection: an existing connection that might be updated.
  *   If given, @connection must be an existing connection that is currently
  *   owned by the plugin.
@@ -165,6 +176,7 @@ static NMSKeyfileConnection *
 update_connection (NMSKeyfilePlugin *self,
                    NMConnection *source,
                    const char *full_path,
+                   ReadJob *preread,
                    NMSKeyfileConnection *connection,
                    gboolean protect_existing_connection,
                    GHashTable *protected_connections,
@@ -178,11 +190,20 @@ update_connection (NMSKeyfilePlugin *self,
 
 	g_return_val_if_fail (!source || NM_IS_CONNECTION (source), NULL);
 	g_return_val_if_fail (full_path || source, NULL);
+	g_return_val_if_fail (!source || !preread, NULL);
 
 	if (full_path)
 		_LOGD ("loading from file \"%s\"...", full_path);
 
-	connection_new = nms_keyfile_connection_new (source, full_path, &local);
+	if (preread) {
+		nms_keyfile_reader_log_warnings (preread->warnings);
+		if (!preread->connection) {
+			connection_new = NULL;
+			local = g_steal_pointer (&preread->error);
+		} else
+			connection_new = nms_keyfile_connection_new (NULL, full_path, preread->connection, &local);
+	} else
+		connection_new = nms_keyfile_connection_new (source, full_path, NULL, &local);
 	if (!connection_new) {
 		/* Error; remove the connection */
 		if (source)
@@ -324,7 +345,7 @@ dir_changed (GFileMonitor *monitor,
 	case G_FILE_MONITOR_EVENT_CREATED:
 	case G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT:
 		if (exists)
-			update_connection (NMS_KEYFILE_PLUGIN (config), NULL, full_path, connection, TRUE, NULL, NULL);
+			update_connection (NMS_KEYFILE_PLUGIN (config), NULL, full_path, NULL, connection, TRUE, NULL, NULL);
 		break;
 	default:
 		break;
@@ -410,6 +431,53 @@ _sort_paths (const char **f1, const char **f2, GHashTable *paths)
 	return strcmp (*f1, *f2);
 }
 
+/* Reading many keyfiles is dominated by parsing and normalizing the
+ * connections, which doesn't touch any state of the plugin. Do that on
+ * a pool of worker threads. */
+#define READ_PARALLEL_MIN_FILES 8
+
+static void
+_read_job_func (gpointer data, gpointer user_data)
+{
+	ReadJob *job = data;
+
+	/* nothing is logged here. update_connection() logs the warnings and
+	 * the error on the main thread, in the order of the files. */
+	job->connection = nms_keyfile_reader_from_file_deferred (job->filename,
+	                                                         &job->warnings,
+	                                                         &job->error);
+}
+
+static ReadJob *
+_read_files_parallel (GPtrArray *filenames)
+{
+	GThreadPool *pool;
+	ReadJob *jobs;
+	guint n_threads;
+	guint i;
+
+	if (filenames->len < READ_PARALLEL_MIN_FILES)
+		return NULL;
+
+	n_threads = MIN (g_get_num_processors (), filenames->len);
+	if (n_threads < 2)
+		return NULL;
+
+	pool = g_thread_pool_new (_read_job_func, NULL, n_threads, TRUE, NULL);
+	if (!pool)
+		return NULL;
+
+	jobs = g_new0 (ReadJob, filenames->len);
+	for (i = 0; i < filenames->len; i++) {
+		jobs[i].filename = filenames->pdata[i];
+		g_thread_pool_push (pool, &jobs[i], NULL);
+	}
+
+	/* wait until all files are read. */
+	g_thread_pool_free (pool, FALSE, TRUE);
+	return jobs;
+}
+
 static void
 read_connections (NMSettingsPlugin *config)
 {
@@ -425,6 +493,7 @@ read_connections (NMSettingsPlugin *config)
 	guint i;
 	GPtrArray *filenames;
 	GHashTable *paths;
+	ReadJob *preread;
 
 	dir = g_dir_open (nms_keyfile_utils_get_path (), 0, &error);
 	if (!dir) {
@@ -455,11 +524,25 @@ read_connections (NMSettingsPlugin *config)
 	g_ptr_array_sort_with_data (filenames, (GCompareDataFunc) _sort_paths, paths);
 	g_hash_table_destroy (paths);
 
+	preread = _read_files_parallel (filenames);
+
+	/* Claim the connections in the sorted order, so that the result doesn't
+	 * depend on which worker finished first. */
 	for (i = 0; i < filenames->len; i++) {
-		connection = update_connection (self, NULL, filenames->pdata[i], NULL, FALSE, alive_connections, NULL);
+		connection = update_connection (self, NULL, filenames->pdata[i],
+		                                preread ? &preread[i] : NULL,
+		                                NULL, FALSE, alive_connections, NULL);
 		if (connection)
 			g_hash_table_add (alive_connections, connection);
 	}
+	if (preread) {
+		for (i = 0; i < filenames->len; i++) {
+			g_clear_object (&preread[i].connection);
+			g_clear_error (&preread[i].error);
+			g_clear_pointer (&preread[i].warnings, g_ptr_array_unref);
+		}
+		g_free (preread);
+	}
 	g_ptr_array_free (filenames, TRUE);
 
 	g_hash_table_iter_init (&iter, priv->connections);
@@ -511,7 +594,7 @@ load_connection (NMSettingsPlugin *config,
 	if (nms_keyfile_utils_should_ignore_file (filename + dir_len + 1))
 		return FALSE;
 
-	connection = update_connection (self, NULL, filename, find_by_path (self, filename), TRUE, NULL, NULL);
+	connection = update_connection (self, NULL, filename, NULL, find_by_path (self, filename), TRUE, NULL, NULL);
 
 	return (connection != NULL);
 }
@@ -542,7 +625,7 @@ add_connection (NMSettingsPlugin *config,
 		                                    error))
 			return NULL;
 	}
-	return NM_SETTINGS_CONNECTION (update_connection (self, reread ?: connection, path, NULL, FALSE, NULL, error));
+	return NM_SETTINGS_CONNECTION (update_connection (self, reread ?: connection, path, NULL, NULL, FALSE, NULL, error));
 }
 
 static GSList *
@@ -56,8 +56,25 @@ _fmt_warn (const char *group, NMSetting *setting, const char *property_name, con
 		return message;
 }
 
+typedef struct {
+	NMLogLevel level;
+	char *uuid;
+	char *message;
+} DeferredWarning;
+
+static void
+_deferred_warning_free (gpointer data)
+{
+	DeferredWarning *warning = data;
+
+	g_free (warning->uuid);
+	g_free (warning->message);
+	g_slice_free (DeferredWarning, warning);
+}
+
 typedef struct {
 	bool verbose;
+	GPtrArray *deferred;
 } HandlerReadData;
 
 static gboolean
@@ -87,6 +104,20 @@ _handler_read (GKeyFile *keyfile,
 		else
 			level = LOGL_INFO;
 
+		if (handler_data->deferred) {
+			DeferredWarning *warning;
+
+			warning = g_slice_new (DeferredWarning);
+			warning->level = level;
+			warning->uuid = g_strdup (nm_connection_get_uuid (connection));
+			warning->message = g_strdup (_fmt_warn (warn_data->group, warn_data->setting,
+			                                        warn_data->property_name, warn_data->message,
+			                                        &message_free));
+			g_ptr_array_add (handler_data->deferred, warning);
+			g_free (message_free);
+			return TRUE;
+		}
+
 		nm_log (level, LOGD_SETTINGS, NULL,
 		        nm_connection_get_uuid (connection),
 		        "keyfile: %s",
@@ -112,9 +143,13 @@ nms_keyfile_reader_from_keyfile (GKeyFile *key_file,
 	return nm_keyfile_read (key_file, filename, NULL, _handler_read, &data, error);
 }
 
-NMConnection *
-nms_keyfile_reader_from_file (const char *filename, GError **error)
+static NMConnection *
+_reader_from_file (const char *filename, GPtrArray *deferred, GError **error)
 {
+	HandlerReadData data = {
+		.verbose = TRUE,
+		.deferred = deferred,
+	};
 	GKeyFile *key_file;
 	struct stat statbuf;
 	NMConnection *connection = NULL;
@@ -146,7 +181,7 @@ nms_keyfile_reader_from_file (const char *filename, GError **error)
 	if (!g_key_file_load_from_file (key_file, filename, G_KEY_FILE_NONE, error))
 		goto out;
 
-	connection = nms_keyfile_reader_from_keyfile (key_file, filename, TRUE, error);
+	connection = nm_keyfile_read (key_file, filename, NULL, _handler_read, &data, error);
 	if (!connection)
 		goto out;
 
@@ -165,3 +200,56 @@ out:
 	return connection;
 }
 
+NMConnection *
+nms_keyfile_reader_from_file (const char *filename, GError **error)
+{
+	return _reader_from_file (filename, NULL, error);
+}
+
+/**
+ * nms_keyfile_reader_from_file_deferred:
+ * @filename: the keyfile to read
+ * @out_warnings: (out): on return, the warnings about the file that were not
+ *   logged, or %NULL if there are none.
+ * @error: the error
+ *
+ * Like nms_keyfile_reader_from_file(), but it doesn't log and can be used
+ * from other threads. Instead, pass the warnings to
+ * nms_keyfile_reader_log_warnings() on the main thread.
+ *
+ * Returns: the normalized connection or %NULL on failure.
+ */
+NMConnection *
+nms_keyfile_reader_from_file_deferred (const char *filename,
+                                       GPtrArray **out_warnings,
+                                       GError **error)
+{
+	gs_unref_ptrarray GPtrArray *deferred = NULL;
+	NMConnection *connection;
+
+	g_return_val_if_fail (out_warnings && !*out_warnings, NULL);
+
+	deferred = g_ptr_array_new_with_free_func (_deferred_warning_free);
+	connection = _reader_from_file (filename, deferred, error);
+	if (deferred->len)
+		*out_warnings = g_steal_pointer (&deferred);
+	return connection;
+}
+
+void
+nms_keyfile_reader_log_warnings (const GPtrArray *warnings)
+{
+	guint i;
+
+	if (!warnings)
+		return;
+
+	for (i = 0; i < warnings->len; i++) {
+		const DeferredWarning *warning = warnings->pdata[i];
+
+		nm_log (warning->level, LOGD_SETTINGS, NULL,
+		        warning->uuid,
+		        "keyfile: %s",
+		        warning->message);
+	}
+}
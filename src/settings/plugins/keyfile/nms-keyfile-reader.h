@@ -31,4 +31,10 @@ NMConnection *nms_keyfile_reader_from_keyfile (GKeyFile *key_file,
 
 NMConnection *nms_keyfile_reader_from_file (const char *filename, GError **error);
 
+NMConnection *nms_keyfile_reader_from_file_deferred (const char *filename,
+                                                     GPtrArray **out_warnings,
+                                                     GError **error);
+
+void nms_keyfile_reader_log_warnings (const GPtrArray *warnings);
+
 #endif /* __NMS_KEYFILE_READER_H__ */
@@ -40,6 +40,27 @@ int dhcp_network_send_raw_socket(int s, const union sockaddr_union *link,
 int dhcp_network_send_udp_socket(int s, be32_t address, uint16_t port,
                                  const void *packet, size_t len);
 
+/* NM: a packet socket shared by the DHCP clients of all interfaces. The
+ * received packets are dispatched by ifindex and xid. */
+typedef struct DHCPRawMuxSlot DHCPRawMuxSlot;
+typedef void (*dhcp_raw_mux_handler_t)(DHCPPacket *packet, size_t len, bool checksum, void *userdata);
+
+int dhcp_network_raw_link(int ifindex, union sockaddr_union *link,
+                          size_t mac_addr_len, uint16_t arp_type);
+int dhcp_raw_mux_add(sd_event *event, int64_t priority, int ifindex,
+                     uint32_t xid, uint16_t port,
+                     dhcp_raw_mux_handler_t handler, void *userdata,
+                     DHCPRawMuxSlot **ret);
+DHCPRawMuxSlot *dhcp_raw_mux_slot_free(DHCPRawMuxSlot *slot);
+int dhcp_raw_mux_slot_get_fd(DHCPRawMuxSlot *slot);
+
+/* NM: the receive path after recvmsg(). Returns 1 if a client took the packet.
+ * Exposed for tests, which also replace the packet socket, as opening it needs
+ * CAP_NET_RAW. */
+int dhcp_raw_mux_dispatch(uint16_t port, int ifindex, DHCPPacket *packet,
+                          size_t len, bool checksum);
+extern int (*dhcp_raw_mux_open_socket)(uint16_t port);
+
 int dhcp_option_append(DHCPMessage *message, size_t size, size_t *offset, uint8_t overload,
                        uint8_t code, size_t optlen, const void *optval);
 
@@ -30,8 +30,12 @@
 #include <linux/if_infiniband.h>
 #include <linux/if_packet.h>
 
+#include "sd-event.h"
+
+#include "alloc-util.h"
 #include "dhcp-internal.h"
 #include "fd-util.h"
+#include "list.h"
 #include "socket-util.h"
 
 static int _bind_raw_socket(int ifindex, union sockaddr_union *link,
@@ -129,17 +133,18 @@ static int _bind_raw_socket(int ifindex, union sockaddr_union *link,
         return r;
 }
 
+static const uint8_t eth_bcast[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+/* Default broadcast address for IPoIB */
+static const uint8_t ib_bcast[] = {
+        0x00, 0xff, 0xff, 0xff, 0xff, 0x12, 0x40, 0x1b,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0xff, 0xff, 0xff, 0xff
+  };
+
 int dhcp_network_bind_raw_socket(int ifindex, union sockaddr_union *link,
                                  uint32_t xid, const uint8_t *mac_addr,
                                  size_t mac_addr_len, uint16_t arp_type,
                                  uint16_t port) {
-        static const uint8_t eth_bcast[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
-        /* Default broadcast address for IPoIB */
-        static const uint8_t ib_bcast[] = {
-                0x00, 0xff, 0xff, 0xff, 0xff, 0x12, 0x40, 0x1b,
-                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-                0xff, 0xff, 0xff, 0xff
-          };
         struct ether_addr eth_mac = { { 0, 0, 0, 0, 0, 0 } };
         const uint8_t *bcast_addr = NULL;
         uint8_t dhcp_hlen = 0;
@@ -161,6 +166,321 @@ int dhcp_network_bind_raw_socket(int ifindex, union sockaddr_union *link,
                                 bcast_addr, &eth_mac, arp_type, dhcp_hlen, port);
 }
 
+/* NM: shared packet socket
+ *
+ * Instead of binding a packet socket with a filter for its xid and MAC
+ * address per client, all clients that use the same port share one packet
+ * socket, which is not bound to an interface. The filter only accepts DHCP
+ * replies and the packets are dispatched to the client registered for the
+ * receiving interface and the xid of the packet. The clients verify the rest,
+ * like with the UDP socket. Sending works with the same socket, as the
+ * destination link address contains the ifindex. */
+
+typedef struct DHCPRawMux DHCPRawMux;
+
+struct DHCPRawMuxSlot {
+        DHCPRawMux *mux;
+        int ifindex;
+        uint32_t xid;
+        dhcp_raw_mux_handler_t handler;
+        void *userdata;
+        LIST_FIELDS(DHCPRawMuxSlot, slots);
+};
+
+struct DHCPRawMux {
+        sd_event *event;
+        sd_event_source *receive_message;
+        int fd;
+        uint16_t port;
+        LIST_HEAD(DHCPRawMuxSlot, slots);
+        LIST_FIELDS(DHCPRawMux, muxes);
+};
+
+static LIST_HEAD(DHCPRawMux, raw_muxes);
+
+int dhcp_network_raw_link(int ifindex, union sockaddr_union *link,
+                          size_t mac_addr_len, uint16_t arp_type) {
+        const uint8_t *bcast_addr;
+
+        assert_return(ifindex > 0, -EINVAL);
+        assert_return(link, -EINVAL);
+
+        if (arp_type == ARPHRD_ETHER) {
+                assert_return(mac_addr_len == ETH_ALEN, -EINVAL);
+                bcast_addr = eth_bcast;
+        } else if (arp_type == ARPHRD_INFINIBAND) {
+                assert_return(mac_addr_len == INFINIBAND_ALEN, -EINVAL);
+                bcast_addr = ib_bcast;
+        } else
+                return -EINVAL;
+
+        link->ll = (struct sockaddr_ll) {
+                .sll_family = AF_PACKET,
+                .sll_protocol = htobe16(ETH_P_IP),
+                .sll_ifindex = ifindex,
+                .sll_hatype = htobe16(arp_type),
+                .sll_halen = mac_addr_len,
+        };
+        memcpy(link->ll.sll_addr, bcast_addr, mac_addr_len);
+        return 0;
+}
+
+static int raw_mux_open_packet_socket(uint16_t port) {
+        struct sock_filter filter[] = {
+                BPF_STMT(BPF_LD + BPF_W + BPF_LEN, 0),                                 /* A <- packet length */
+                BPF_JUMP(BPF_JMP + BPF_JGE + BPF_K, sizeof(DHCPPacket), 1, 0),         /* packet >= DHCPPacket ? */
+                BPF_STMT(BPF_RET + BPF_K, 0),                                          /* ignore */
+                BPF_STMT(BPF_LD + BPF_B + BPF_ABS, offsetof(DHCPPacket, ip.protocol)), /* A <- IP protocol */
+                BPF_JUMP(BPF_JMP + BPF_JEQ + BPF_K, IPPROTO_UDP, 1, 0),                /* IP protocol == UDP ? */
+                BPF_STMT(BPF_RET + BPF_K, 0),                                          /* ignore */
+                BPF_STMT(BPF_LD + BPF_H + BPF_ABS, offsetof(DHCPPacket, ip.frag_off)), /* A <- Flags + Fragment offset */
+                BPF_STMT(BPF_ALU + BPF_AND + BPF_K, 0x3fff),                           /* A <- A & 0x3fff (More Fragments bit + Fragment offset) */
+                BPF_JUMP(BPF_JMP + BPF_JEQ + BPF_K, 0, 1, 0),                          /* A == 0 ? */
+                BPF_STMT(BPF_RET + BPF_K, 0),                                          /* ignore */
+                BPF_STMT(BPF_LD + BPF_H + BPF_ABS, offsetof(DHCPPacket, udp.dest)),    /* A <- UDP destination port */
+                BPF_JUMP(BPF_JMP + BPF_JEQ + BPF_K, port, 1, 0),                       /* UDP destination port == DHCP client port ? */
+                BPF_STMT(BPF_RET + BPF_K, 0),                                          /* ignore */
+                BPF_STMT(BPF_LD + BPF_B + BPF_ABS, offsetof(DHCPPacket, dhcp.op)),     /* A <- DHCP op */
+                BPF_JUMP(BPF_JMP + BPF_JEQ + BPF_K, BOOTREPLY, 1, 0),                  /* op == BOOTREPLY ? */
+                BPF_STMT(BPF_RET + BPF_K, 0),                                          /* ignore */
+                BPF_STMT(BPF_LD + BPF_W + BPF_ABS, offsetof(DHCPPacket, dhcp.magic)),  /* A <- DHCP magic cookie */
+                BPF_JUMP(BPF_JMP + BPF_JEQ + BPF_K, DHCP_MAGIC_COOKIE, 1, 0),          /* cookie == DHCP magic cookie ? */
+                BPF_STMT(BPF_RET + BPF_K, 0),                                          /* ignore */
+                BPF_STMT(BPF_RET + BPF_K, 65535),                                      /* return all */
+        };
+        struct sock_fprog fprog = {
+                .len = ELEMENTSOF(filter),
+                .filter = filter
+        };
+        _cleanup_close_ int s = -1;
+        int r, on = 1;
+
+        /* not bound to an interface: receive on all of them. */
+        s = socket(AF_PACKET, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, htobe16(ETH_P_IP));
+        if (s < 0)
+                return -errno;
+
+        r = setsockopt(s, SOL_PACKET, PACKET_AUXDATA, &on, sizeof(on));
+        if (r < 0)
+                return -errno;
+
+        r = setsockopt(s, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog));
+        if (r < 0)
+                return -errno;
+
+        r = s;
+        s = -1;
+
+        return r;
+}
+
+int (*dhcp_raw_mux_open_socket)(uint16_t port) = raw_mux_open_packet_socket;
+
+static bool raw_mux_dispatch(DHCPRawMux *mux, int ifindex, DHCPPacket *packet,
+                             size_t len, bool checksum) {
+        DHCPRawMuxSlot *slot;
+        uint32_t xid;
+
+        xid = be32toh(packet->dhcp.xid);
+
+        LIST_FOREACH(slots, slot, mux->slots) {
+                if (slot->ifindex == ifindex && slot->xid == xid) {
+                        /* the handler may free the slot and the mux. */
+                        slot->handler(packet, len, checksum, slot->userdata);
+                        return true;
+                }
+        }
+
+        return false;
+}
+
+int dhcp_raw_mux_dispatch(uint16_t port, int ifindex, DHCPPacket *packet,
+                          size_t len, bool checksum) {
+        DHCPRawMux *mux;
+
+        assert_return(packet, -EINVAL);
+        assert_return(len >= sizeof(DHCPPacket), -EINVAL);
+
+        LIST_FOREACH(muxes, mux, raw_muxes) {
+                if (mux->port == port)
+                        return raw_mux_dispatch(mux, ifindex, packet, len, checksum);
+        }
+
+        return 0;
+}
+
+static int raw_mux_receive(sd_event_source *s, int fd, uint32_t revents, void *userdata) {
+        DHCPRawMux *mux = userdata;
+        _cleanup_free_ DHCPPacket *packet = NULL;
+        uint8_t cmsgbuf[CMSG_LEN(sizeof(struct tpacket_auxdata))];
+        union sockaddr_union sa = {};
+        struct iovec iov = {};
+        struct msghdr msg = {
+                .msg_name = &sa,
+                .msg_namelen = sizeof(sa),
+                .msg_iov = &iov,
+                .msg_iovlen = 1,
+                .msg_control = cmsgbuf,
+                .msg_controllen = sizeof(cmsgbuf),
+        };
+        struct cmsghdr *cmsg;
+        bool checksum = true;
+        ssize_t buflen, len;
+
+        /* The socket serves the clients of all interfaces. Returning an error
+         * would disable the event source and stop DHCP everywhere, so only log
+         * and drop the datagram. */
+
+        buflen = next_datagram_size_fd(fd);
+        if (buflen < 0) {
+                log_debug_errno(buflen, "DHCP: shared packet socket: failed to get the datagram size, dropping it: %m");
+                (void) recv(fd, NULL, 0, MSG_DONTWAIT);
+                return 0;
+        }
+
+        packet = malloc0(MAX(buflen, 1));
+        if (!packet) {
+                log_debug_errno(ENOMEM, "DHCP: shared packet socket: failed to allocate %zd bytes, dropping the datagram: %m", buflen);
+                (void) recv(fd, NULL, 0, MSG_DONTWAIT);
+                return 0;
+        }
+
+        iov.iov_base = packet;
+        iov.iov_len = buflen;
+
+        len = recvmsg(fd, &msg, 0);
+        if (len < 0) {
+                if (!IN_SET(errno, EAGAIN, EINTR))
+                        log_debug_errno(errno, "DHCP: shared packet socket: failed to receive: %m");
+                return 0;
+        } else if ((size_t)len < sizeof(DHCPPacket))
+                return 0;
+
+        /* a local DHCP server's replies */
+        if (sa.ll.sll_pkttype == PACKET_OUTGOING)
+                return 0;
+
+        CMSG_FOREACH(cmsg, &msg) {
+                if (cmsg->cmsg_level == SOL_PACKET &&
+                    cmsg->cmsg_type == PACKET_AUXDATA &&
+                    cmsg->cmsg_len == CMSG_LEN(sizeof(struct tpacket_auxdata))) {
+                        struct tpacket_auxdata *aux = (struct tpacket_auxdata*)CMSG_DATA(cmsg);
+
+                        checksum = !(aux->tp_status & TP_STATUS_CSUMNOTREADY);
+                        break;
+                }
+        }
+
+        (void) raw_mux_dispatch(mux, sa.ll.sll_ifindex, packet, len, checksum);
+
+        return 0;
+}
+
+static DHCPRawMux *raw_mux_free(DHCPRawMux *mux) {
+        if (!mux)
+                return NULL;
+
+        assert(!mux->slots);
+
+        LIST_REMOVE(muxes, raw_muxes, mux);
+        mux->receive_message = sd_event_source_unref(mux->receive_message);
+        mux->fd = safe_close(mux->fd);
+        mux->event = sd_event_unref(mux->event);
+        return mfree(mux);
+}
+
+int dhcp_raw_mux_add(sd_event *event, int64_t priority, int ifindex,
+                     uint32_t xid, uint16_t port,
+                     dhcp_raw_mux_handler_t handler, void *userdata,
+                     DHCPRawMuxSlot **ret) {
+        DHCPRawMux *mux;
+        DHCPRawMuxSlot *slot;
+        int r;
+
+        assert_return(event, -EINVAL);
+        assert_return(ifindex > 0, -EINVAL);
+        assert_return(handler, -EINVAL);
+        assert_return(ret, -EINVAL);
+
+        LIST_FOREACH(muxes, mux, raw_muxes) {
+                if (mux->port == port)
+                        break;
+        }
+
+        if (mux) {
+                if (mux->event != event)
+                        return -EBUSY;
+        } else {
+                mux = new0(DHCPRawMux, 1);
+                if (!mux)
+                        return -ENOMEM;
+
+                mux->fd = -1;
+                mux->port = port;
+                mux->event = sd_event_ref(event);
+                LIST_PREPEND(muxes, raw_muxes, mux);
+
+                r = dhcp_raw_mux_open_socket(port);
+                if (r < 0)
+                        goto fail;
+                mux->fd = r;
+
+                r = sd_event_add_io(event, &mux->receive_message, mux->fd, EPOLLIN,
+                                    raw_mux_receive, mux);
+                if (r < 0)
+                        goto fail;
+
+                r = sd_event_source_set_priority(mux->receive_message, priority);
+                if (r < 0)
+                        goto fail;
+
+                (void) sd_event_source_set_description(mux->receive_message, "dhcp4-shared-receive-message");
+        }
+
+        slot = new0(DHCPRawMuxSlot, 1);
+        if (!slot) {
+                r = -ENOMEM;
+                goto fail;
+        }
+
+        slot->mux = mux;
+        slot->ifindex = ifindex;
+        slot->xid = xid;
+        slot->handler = handler;
+        slot->userdata = userdata;
+        LIST_PREPEND(slots, mux->slots, slot);
+
+        *ret = slot;
+        return 0;
+
+fail:
+        if (!mux->slots)
+                raw_mux_free(mux);
+        return r;
+}
+
+DHCPRawMuxSlot *dhcp_raw_mux_slot_free(DHCPRawMuxSlot *slot) {
+        DHCPRawMux *mux;
+
+        if (!slot)
+                return NULL;
+
+        mux = slot->mux;
+        LIST_REMOVE(slots, mux->slots, slot);
+        free(slot);
+
+        if (!mux->slots)
+                raw_mux_free(mux);
+
+        return NULL;
+}
+
+int dhcp_raw_mux_slot_get_fd(DHCPRawMuxSlot *slot) {
+        assert_return(slot, -EINVAL);
+
+        return slot->mux->fd;
+}
+
 int dhcp_network_bind_udp_socket(int ifindex, be32_t address, uint16_t port) {
         union sockaddr_union src = {
                 .in.sin_family = AF_INET,
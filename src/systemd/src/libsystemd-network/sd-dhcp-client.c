@@ -60,6 +60,8 @@ struct sd_dhcp_client {
         uint16_t port;
         union sockaddr_union link;
         sd_event_source *receive_message;
+        bool shared_raw_socket;
+        DHCPRawMuxSlot *raw_slot;
         bool request_broadcast;
         uint8_t *req_opts;
         size_t req_opts_allocated;
@@ -447,6 +449,15 @@ int sd_dhcp_client_set_client_port(
         return 0;
 }
 
+int sd_dhcp_client_set_shared_raw_socket(sd_dhcp_client *client, int b) {
+        assert_return(client, -EINVAL);
+        assert_return(IN_SET(client->state, DHCP_STATE_INIT, DHCP_STATE_STOPPED), -EBUSY);
+
+        client->shared_raw_socket = !!b;
+
+        return 0;
+}
+
 int sd_dhcp_client_set_mtu(sd_dhcp_client *client, uint32_t mtu) {
         assert_return(client, -EINVAL);
         assert_return(mtu >= DHCP_DEFAULT_MIN_SIZE, -ERANGE);
@@ -481,6 +492,7 @@ static int client_initialize(sd_dhcp_client *client) {
         client->receive_message = sd_event_source_unref(client->receive_message);
 
         client->fd = asynchronous_close(client->fd);
+        client->raw_slot = dhcp_raw_mux_slot_free(client->raw_slot);
 
         client->timeout_resend = sd_event_source_unref(client->timeout_resend);
 
@@ -701,6 +713,10 @@ static int dhcp_client_send_raw(
         dhcp_packet_append_ip_headers(packet, INADDR_ANY, client->port,
                                       INADDR_BROADCAST, DHCP_PORT_SERVER, len);
 
+        if (client->raw_slot)
+                return dhcp_network_send_raw_socket(dhcp_raw_mux_slot_get_fd(client->raw_slot),
+                                                    &client->link, packet, len);
+
         return dhcp_network_send_raw_socket(client->fd, &client->link,
                                             packet, len);
 }
@@ -1144,6 +1160,41 @@ static int client_initialize_events(sd_dhcp_client *client, sd_event_io_handler_
         return 0;
 }
 
+static void client_receive_packet_shared(DHCPPacket *packet, size_t len, bool checksum, void *userdata);
+
+static int client_open_raw(sd_dhcp_client *client) {
+        int r;
+
+        assert(client);
+        assert(client->fd < 0);
+        assert(!client->raw_slot);
+
+        if (client->shared_raw_socket) {
+                r = dhcp_network_raw_link(client->ifindex, &client->link,
+                                          client->mac_addr_len, client->arp_type);
+                if (r >= 0)
+                        r = dhcp_raw_mux_add(client->event, client->event_priority,
+                                             client->ifindex, client->xid, client->port,
+                                             client_receive_packet_shared, client,
+                                             &client->raw_slot);
+                if (r >= 0)
+                        return client_initialize_time_events(client);
+
+                /* NM: fall back to a packet socket of our own. */
+                log_dhcp_client_errno(client, r, "Could not use the shared packet socket, using a separate one: %m");
+        }
+
+        r = dhcp_network_bind_raw_socket(client->ifindex, &client->link,
+                                         client->xid, client->mac_addr,
+                                         client->mac_addr_len, client->arp_type,
+                                         client->port);
+        if (r < 0)
+                return r;
+        client->fd = r;
+
+        return client_initialize_events(client, client_receive_message_raw);
+}
+
 static int client_start_delayed(sd_dhcp_client *client) {
         int r;
 
@@ -1151,24 +1202,22 @@ static int client_start_delayed(sd_dhcp_client *client) {
         assert_return(client->event, -EINVAL);
         assert_return(client->ifindex > 0, -EINVAL);
         assert_return(client->fd < 0, -EBUSY);
+        assert_return(!client->raw_slot, -EBUSY);
         assert_return(client->xid == 0, -EINVAL);
         assert_return(IN_SET(client->state, DHCP_STATE_INIT, DHCP_STATE_INIT_REBOOT), -EBUSY);
 
         client->xid = random_u32();
 
-        r = dhcp_network_bind_raw_socket(client->ifindex, &client->link,
-                                         client->xid, client->mac_addr,
-                                         client->mac_addr_len, client->arp_type, client->port);
+        if (IN_SET(client->state, DHCP_STATE_INIT, DHCP_STATE_INIT_REBOOT))
+                client->start_time = now(clock_boottime_or_monotonic());
+
+        r = client_open_raw(client);
         if (r < 0) {
                 client_stop(client, r);
                 return r;
         }
-        client->fd = r;
 
-        if (IN_SET(client->state, DHCP_STATE_INIT, DHCP_STATE_INIT_REBOOT))
-                client->start_time = now(clock_boottime_or_monotonic());
-
-        return client_initialize_events(client, client_receive_message_raw);
+        return 0;
 }
 
 static int client_start(sd_dhcp_client *client) {
@@ -1202,21 +1251,18 @@ static int client_timeout_t2(sd_event_source *s, uint64_t usec, void *userdata)
 
         client->receive_message = sd_event_source_unref(client->receive_message);
         client->fd = asynchronous_close(client->fd);
+        client->raw_slot = dhcp_raw_mux_slot_free(client->raw_slot);
 
         client->state = DHCP_STATE_REBINDING;
         client->attempt = 1;
 
-        r = dhcp_network_bind_raw_socket(client->ifindex, &client->link,
-                                         client->xid, client->mac_addr,
-                                         client->mac_addr_len, client->arp_type,
-                                         client->port);
+        r = client_open_raw(client);
         if (r < 0) {
                 client_stop(client, r);
                 return 0;
         }
-        client->fd = r;
 
-        return client_initialize_events(client, client_receive_message_raw);
+        return 0;
 }
 
 static int client_timeout_t1(sd_event_source *s, uint64_t usec, void *userdata) {
@@ -1576,6 +1622,7 @@ static int client_handle_message(sd_dhcp_client *client, DHCPMessage *message, i
                         client->receive_message =
                                 sd_event_source_unref(client->receive_message);
                         client->fd = asynchronous_close(client->fd);
+                        client->raw_slot = dhcp_raw_mux_slot_free(client->raw_slot);
 
                         if (IN_SET(client->state, DHCP_STATE_REQUESTING,
                                    DHCP_STATE_REBOOTING))
@@ -1813,6 +1860,44 @@ static int client_receive_message_raw(
         return client_handle_message(client, &packet->dhcp, len);
 }
 
+static void client_receive_packet_shared(DHCPPacket *packet, size_t len, bool checksum, void *userdata) {
+        sd_dhcp_client *client = userdata;
+        const struct ether_addr zero_mac = {};
+        const struct ether_addr *expected_chaddr;
+        uint8_t expected_hlen;
+        int r;
+
+        assert(client);
+
+        /* The shared socket only filters on the port and the demultiplexer
+         * on ifindex and xid. Check the rest of what the filter of
+         * dhcp_network_bind_raw_socket() would check. */
+        if (packet->dhcp.htype != client->arp_type)
+                return;
+
+        if (client->arp_type == ARPHRD_ETHER) {
+                expected_hlen = ETH_ALEN;
+                expected_chaddr = (const struct ether_addr *) &client->mac_addr;
+        } else {
+                expected_hlen = 0;
+                expected_chaddr = &zero_mac;
+        }
+
+        if (packet->dhcp.hlen != expected_hlen)
+                return;
+
+        if (memcmp(&packet->dhcp.chaddr[0], expected_chaddr, ETH_ALEN))
+                return;
+
+        r = dhcp_packet_verify_headers(packet, len, checksum, client->port);
+        if (r < 0)
+                return;
+
+        len -= DHCP_IP_UDP_SIZE;
+
+        (void) client_handle_message(client, &packet->dhcp, len);
+}
+
 int sd_dhcp_client_start(sd_dhcp_client *client) {
         int r;
 
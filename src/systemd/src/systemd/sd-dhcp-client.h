@@ -142,6 +142,9 @@ int sd_dhcp_client_set_mtu(
 int sd_dhcp_client_set_client_port(
                 sd_dhcp_client *client,
                 uint16_t port);
+int sd_dhcp_client_set_shared_raw_socket(
+                sd_dhcp_client *client,
+                int b);
 int sd_dhcp_client_set_hostname(
                 sd_dhcp_client *client,
                 const char *hostname);
@@ -319,16 +319,130 @@ test_config_global_dns (void)
 }
 
 #if WITH_CONCHECK
+#define CONCHECK_SERVER_DELAY_MSEC 300
+#define CONCHECK_N_CHECKS          4
+
+typedef struct {
+	int n_open;
+	int n_open_max;
+} ConcheckServer;
+
+static void
+concheck_server_connection_open (ConcheckServer *server)
+{
+	int n_open, n_open_max;
+
+	n_open = g_atomic_int_add (&server->n_open, 1) + 1;
+	do {
+		n_open_max = g_atomic_int_get (&server->n_open_max);
+		if (n_open <= n_open_max)
+			break;
+	} while (!g_atomic_int_compare_and_exchange (&server->n_open_max, n_open_max, n_open));
+}
+
+static gboolean
+concheck_server_run_cb (GThreadedSocketService *service,
+                        GSocketConnection *connection,
+                        GObject *source_object,
+                        gpointer user_data)
+{
+	ConcheckServer *server = user_data;
+	static const char response[] = "HTTP/1.1 204 No Content\r\n"
+	                               "X-NetworkManager-Status: online\r\n"
+	                               "Connection: close\r\n"
+	                               "\r\n";
+	GInputStream *in = g_io_stream_get_input_stream (G_IO_STREAM (connection));
+	GOutputStream *out = g_io_stream_get_output_stream (G_IO_STREAM (connection));
+	nm_auto_free_gstring GString *request = g_string_new (NULL);
+	char buf[256];
+	gssize n;
+	guint i;
+
+	concheck_server_connection_open (server);
+
+	/* read the request headers before answering. */
+	while (!strstr (request->str, "\r\n\r\n")) {
+		n = g_input_stream_read (in, buf, sizeof (buf), NULL, NULL);
+		if (n <= 0) {
+			g_atomic_int_add (&server->n_open, -1);
+			return TRUE;
+		}
+		g_string_append_len (request, buf, n);
+	}
+
+	/* a slow uplink. The checks must not wait for each other, so give the
+	 * other checks a generous chance to connect while this one is pending. */
+	g_usleep (CONCHECK_SERVER_DELAY_MSEC * 1000);
+	for (i = 0; i < 100 && g_atomic_int_get (&server->n_open_max) < CONCHECK_N_CHECKS; i++)
+		g_usleep (50 * 1000);
+
+	/* done with @server before answering: the test may return right after
+	 * the last response. */
+	g_atomic_int_add (&server->n_open, -1);
+
+	g_output_stream_write_all (out, response, sizeof (response) - 1, NULL, NULL, NULL);
+	g_io_stream_close (G_IO_STREAM (connection), NULL, NULL);
+	return TRUE;
+}
+
+typedef struct {
+	GMainLoop *loop;
+	guint remaining;
+	NMConnectivityState states[CONCHECK_N_CHECKS];
+} ConcheckData;
+
+static void
+concheck_done_cb (GObject *source, GAsyncResult *result, gpointer user_data)
+{
+	ConcheckData *data = user_data;
+	GError *error = NULL;
+	guint idx;
+
+	nm_assert (data->remaining > 0);
+	idx = CONCHECK_N_CHECKS - data->remaining;
+	data->states[idx] = nm_connectivity_check_finish (NM_CONNECTIVITY (source), result, &error);
+	g_assert_no_error (error);
+
+	if (--data->remaining == 0)
+		g_main_loop_quit (data->loop);
+}
+
 static void
 test_config_connectivity_check (void)
 {
 	const char *CONFIG_INTERN = BUILDDIR"/test-connectivity-check-intern.conf";
+	gs_unref_object GSocketService *service = NULL;
+	gs_unref_object GSocketAddress *addr = NULL;
+	gs_unref_object GSocketAddress *effective_addr = NULL;
+	gs_unref_object GInetAddress *loopback = NULL;
+	gs_free char *uri = NULL;
+	GError *error = NULL;
 	NMConfig *config;
 	NMConnectivity *connectivity;
+	ConcheckData data = { };
+	ConcheckServer server = { };
+	gint64 start_msec, elapsed_msec;
+	guint i;
+
+	/* a local stand-in for the connectivity check server. */
+	service = g_threaded_socket_service_new (CONCHECK_N_CHECKS);
+	g_signal_connect (service, "run", G_CALLBACK (concheck_server_run_cb), &server);
+	loopback = g_inet_address_new_loopback (G_SOCKET_FAMILY_IPV4);
+	addr = g_inet_socket_address_new (loopback, 0);
+	g_socket_listener_add_address (G_SOCKET_LISTENER (service), addr,
+	                               G_SOCKET_TYPE_STREAM, G_SOCKET_PROTOCOL_TCP,
+	                               NULL, &effective_addr, &error);
+	g_assert_no_error (error);
+	g_socket_service_start (service);
+
+	uri = g_strdup_printf ("http://127.0.0.1:%u/check",
+	                       (guint) g_inet_socket_address_get_port (G_INET_SOCKET_ADDRESS (effective_addr)));
 
 	g_assert (g_file_set_contents (CONFIG_INTERN, "", 0, NULL));
 	config = setup_config (NULL, SRCDIR "/NetworkManager.conf", CONFIG_INTERN, NULL,
-	                       "/no/such/dir", "", NULL);
+	                       "/no/such/dir", "",
+	                       "--connectivity-uri", uri,
+	                       NULL);
 	connectivity = nm_connectivity_get();
 
 	g_assert (nm_connectivity_check_enabled (connectivity));
@@ -347,6 +461,27 @@ test_config_connectivity_check (void)
 
 	g_assert (nm_connectivity_check_enabled (connectivity));
 
+	/* run several checks at once. They are not bound to an interface,
+	 * because that requires privileges. */
+	data.loop = g_main_loop_new (NULL, FALSE);
+	data.remaining = CONCHECK_N_CHECKS;
+	start_msec = nm_utils_get_monotonic_timestamp_ms ();
+	for (i = 0; i < CONCHECK_N_CHECKS; i++)
+		nm_connectivity_check_async (connectivity, NULL, concheck_done_cb, &data);
+
+	g_assert (nmtst_main_loop_run (data.loop, 10000));
+	elapsed_msec = nm_utils_get_monotonic_timestamp_ms () - start_msec;
+
+	for (i = 0; i < CONCHECK_N_CHECKS; i++)
+		g_assert_cmpint (data.states[i], ==, NM_CONNECTIVITY_FULL);
+
+	/* the checks ran concurrently, not one after the other. */
+	g_assert_cmpint (elapsed_msec, >=, CONCHECK_SERVER_DELAY_MSEC);
+	g_assert_cmpint (g_atomic_int_get (&server.n_open_max), ==, CONCHECK_N_CHECKS);
+
+	g_main_loop_unref (data.loop);
+	g_socket_service_stop (service);
+
 	g_object_unref (connectivity);
 	g_object_unref (config);
 
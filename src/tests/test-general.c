@@ -1020,20 +1020,39 @@ test_connection_sort_autoconnect_priority (void)
 static NMMatchSpecMatchType
 _test_match_spec_device (const GSList *specs, const char *match_str)
 {
+	NMMatchSpecDevice *compiled;
+	NMMatchSpecMatchType m, m_compiled;
+	gs_free char *s = NULL;
+	const char *interface_name = NULL;
+	const char *driver = NULL;
+	const char *driver_version = NULL;
+	const char *s390_subchannels = NULL;
+
 	if (match_str && g_str_has_prefix (match_str, MATCH_S390))
-		return nm_match_spec_device (specs, NULL, NULL, NULL, NULL, NULL, &match_str[NM_STRLEN (MATCH_S390)]);
-	if (match_str && g_str_has_prefix (match_str, MATCH_DRIVER)) {
-		gs_free char *s = g_strdup (&match_str[NM_STRLEN (MATCH_DRIVER)]);
+		s390_subchannels = &match_str[NM_STRLEN (MATCH_S390)];
+	else if (match_str && g_str_has_prefix (match_str, MATCH_DRIVER)) {
 		char *t;
 
+		s = g_strdup (&match_str[NM_STRLEN (MATCH_DRIVER)]);
 		t = strchr (s, '|');
 		if (t) {
 			t[0] = '\0';
 			t++;
 		}
-		return nm_match_spec_device (specs, NULL, NULL, s, t, NULL, NULL);
-	}
-	return nm_match_spec_device (specs, match_str, NULL, NULL, NULL, NULL, NULL);
+		driver = s;
+		driver_version = t;
+	} else
+		interface_name = match_str;
+
+	m = nm_match_spec_device (specs, interface_name, NULL, driver, driver_version, NULL, s390_subchannels);
+
+	/* the pre-parsed specs must give the same result. */
+	compiled = nm_match_spec_device_compile (specs);
+	m_compiled = nm_match_spec_device_compiled (compiled, interface_name, NULL, driver, driver_version, NULL, s390_subchannels);
+	nm_match_spec_device_free (compiled);
+	g_assert_cmpint (m, ==, m_compiled);
+
+	return m;
 }
 
 static void
@@ -191,6 +191,48 @@ test_compare_with_source (void)
 	g_object_unref (b);
 }
 
+static void
+test_compare_after_change (void)
+{
+	NMIP4Config *a, *b;
+
+	a = nmtst_ip4_config_new (1);
+	b = nmtst_ip4_config_new (2);
+
+	g_assert (nm_ip4_config_equal (a, b));
+	g_assert (nm_ip4_config_equal (a, NULL));
+
+	/* the cached hash must be invalidated by each change. */
+	nm_ip4_config_add_address (a, nmtst_platform_ip4_address ("1.2.3.4", NULL, 24));
+	g_assert (!nm_ip4_config_equal (a, b));
+	g_assert (!nm_ip4_config_equal (NULL, a));
+	nm_ip4_config_add_address (b, nmtst_platform_ip4_address ("1.2.3.4", NULL, 24));
+	g_assert (nm_ip4_config_equal (a, b));
+
+	nm_ip4_config_add_nameserver (a, nmtst_inet4_from_string ("8.8.8.8"));
+	g_assert (!nm_ip4_config_equal (a, b));
+	nm_ip4_config_add_nameserver (b, nmtst_inet4_from_string ("8.8.8.8"));
+	g_assert (nm_ip4_config_equal (a, b));
+
+	nm_ip4_config_set_nis_domain (a, "example.com");
+	g_assert (!nm_ip4_config_equal (a, b));
+	nm_ip4_config_set_nis_domain (b, "example.com");
+	g_assert (nm_ip4_config_equal (a, b));
+
+	nm_ip4_config_add_search (a, "foo");
+	nm_ip4_config_add_search (b, "bar");
+	g_assert (!nm_ip4_config_equal (a, b));
+	nm_ip4_config_reset_searches (a);
+	nm_ip4_config_reset_searches (b);
+	g_assert (nm_ip4_config_equal (a, b));
+
+	nm_ip4_config_reset_addresses (a);
+	g_assert (!nm_ip4_config_equal (a, b));
+
+	g_object_unref (a);
+	g_object_unref (b);
+}
+
 static void
 test_add_address_with_source (void)
 {
@@ -339,6 +381,7 @@ main (int argc, char **argv)
 
 	g_test_add_func ("/ip4-config/subtract", test_subtract);
 	g_test_add_func ("/ip4-config/compare-with-source", test_compare_with_source);
+	g_test_add_func ("/ip4-config/compare-after-change", test_compare_after_change);
 	g_test_add_func ("/ip4-config/add-address-with-source", test_add_address_with_source);
 	g_test_add_func ("/ip4-config/add-route-with-source", test_add_route_with_source);
 	g_test_add_func ("/ip4-config/merge-subtract-mtu", test_merge_subtract_mtu);
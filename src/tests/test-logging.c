@@ -0,0 +1,219 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Copyright (C) 2018 Red Hat, Inc.
+ */
+
+#include "nm-default.h"
+
+#include "nm-test-utils-core.h"
+
+/*****************************************************************************/
+
+/* The messages are written with g_log(), as the tests don't open the syslog
+ * or journal backend. Capture them, possibly from the writer thread. */
+static struct {
+	GMutex lock;
+	GPtrArray *messages;
+
+	/* while held by the test, the writer thread blocks in the handler. */
+	GMutex gate;
+	volatile gint n_in_handler;
+} capture;
+
+static void
+_capture_handler (const char *log_domain,
+                  GLogLevelFlags log_level,
+                  const char *message,
+                  gpointer user_data)
+{
+	g_atomic_int_inc (&capture.n_in_handler);
+	g_mutex_lock (&capture.gate);
+	g_mutex_unlock (&capture.gate);
+	g_atomic_int_add (&capture.n_in_handler, -1);
+
+	g_mutex_lock (&capture.lock);
+	g_ptr_array_add (capture.messages, g_strdup (message));
+	g_mutex_unlock (&capture.lock);
+}
+
+static void
+_capture_start (void)
+{
+	g_assert (!capture.messages);
+	capture.messages = g_ptr_array_new_with_free_func (g_free);
+}
+
+static GPtrArray *
+_capture_stop (void)
+{
+	GPtrArray *messages;
+
+	g_mutex_lock (&capture.lock);
+	messages = g_steal_pointer (&capture.messages);
+	g_mutex_unlock (&capture.lock);
+	return messages;
+}
+
+static guint
+_capture_count (const char *needle)
+{
+	guint i, n = 0;
+
+	g_mutex_lock (&capture.lock);
+	for (i = 0; i < capture.messages->len; i++) {
+		if (strstr (capture.messages->pdata[i], needle))
+			n++;
+	}
+	g_mutex_unlock (&capture.lock);
+	return n;
+}
+
+/*****************************************************************************/
+
+static void
+test_async_overflow (void)
+{
+	gs_unref_ptrarray GPtrArray *messages = NULL;
+	guint n_written_before, n_dropped_before;
+	guint n_written, n_dropped;
+	const guint n_extra = 10;
+	guint i;
+
+	nm_logging_async_get_stats (&n_written_before, &n_dropped_before);
+
+	_capture_start ();
+	nm_logging_async_start ();
+
+	/* stall the writer on the first message, so that the ring fills up. */
+	g_mutex_lock (&capture.gate);
+	nm_log_info (LOGD_CORE, "test-async: first");
+	for (i = 0; i < 5000 && !g_atomic_int_get (&capture.n_in_handler); i++)
+		g_usleep (1000);
+	g_assert_cmpint (g_atomic_int_get (&capture.n_in_handler), ==, 1);
+
+	for (i = 0; i < NM_LOGGING_ASYNC_RING_SIZE + n_extra; i++)
+		nm_log_info (LOGD_CORE, "test-async: message %u", i);
+
+	nm_logging_async_get_stats (&n_written, &n_dropped);
+	g_assert_cmpint (n_dropped - n_dropped_before, ==, n_extra);
+
+	g_mutex_unlock (&capture.gate);
+	nm_logging_async_stop ();
+
+	nm_logging_async_get_stats (&n_written, &n_dropped);
+	g_assert_cmpint (n_written - n_written_before, ==, 1 + NM_LOGGING_ASYNC_RING_SIZE);
+	g_assert_cmpint (n_dropped - n_dropped_before, ==, n_extra);
+
+	messages = _capture_stop ();
+	g_assert_cmpint (messages->len, ==, 1 + NM_LOGGING_ASYNC_RING_SIZE + 1);
+	g_assert (strstr (messages->pdata[0], "test-async: first"));
+	g_assert (strstr (messages->pdata[NM_LOGGING_ASYNC_RING_SIZE], "test-async: message 4095"));
+	g_assert (strstr (messages->pdata[messages->len - 1], "dropped 10 messages"));
+}
+
+static void
+test_async_flush_on_error (void)
+{
+	gs_unref_ptrarray GPtrArray *messages = NULL;
+	guint i;
+
+	_capture_start ();
+	nm_logging_async_start ();
+
+	for (i = 0; i < 20; i++)
+		nm_log_info (LOGD_CORE, "test-flush: message %u", i);
+
+	/* an error is written synchronously, after everything queued before. */
+	nm_log_err (LOGD_CORE, "test-flush: error");
+	g_assert_cmpint (_capture_count ("test-flush: "), ==, 21);
+
+	nm_logging_async_stop ();
+
+	messages = _capture_stop ();
+	g_assert_cmpint (messages->len, ==, 21);
+	for (i = 0; i < 20; i++)
+		g_assert (strstr (messages->pdata[i], "test-flush: message"));
+	g_assert (strstr (messages->pdata[20], "test-flush: error"));
+}
+
+/*****************************************************************************/
+
+static void
+test_rate_limit (void)
+{
+	gs_unref_ptrarray GPtrArray *messages = NULL;
+	guint n_suppressed_before;
+	guint i;
+
+	n_suppressed_before = nm_logging_rate_limit_get_suppressed ();
+
+	/* 5 messages per domain within 5 seconds: one more per second. */
+	nm_logging_set_rate_limit (5, 5);
+	_capture_start ();
+
+	/* the burst */
+	for (i = 0; i < 8; i++)
+		nm_log_info (LOGD_CORE, "test-rate: core %u", i);
+	g_assert_cmpint (_capture_count ("test-rate: core"), ==, 5);
+	g_assert_cmpint (nm_logging_rate_limit_get_suppressed () - n_suppressed_before, ==, 3);
+
+	/* other domains and warnings are not affected. */
+	nm_log_info (LOGD_DEVICE, "test-rate: device");
+	nm_log_warn (LOGD_CORE, "test-rate: warning");
+	g_assert_cmpint (_capture_count ("test-rate: device"), ==, 1);
+	g_assert_cmpint (_capture_count ("test-rate: warning"), ==, 1);
+
+	/* one token was refilled. */
+	g_usleep (1100 * 1000);
+	nm_log_info (LOGD_CORE, "test-rate: refilled");
+	nm_log_info (LOGD_CORE, "test-rate: empty again");
+	g_assert_cmpint (nm_logging_rate_limit_get_suppressed () - n_suppressed_before, ==, 4);
+
+	nm_logging_set_rate_limit (0, 0);
+	nm_log_info (LOGD_CORE, "test-rate: disabled");
+
+	messages = _capture_stop ();
+	g_assert_cmpint (messages->len, ==, 5 + 2 + 2 + 1);
+	for (i = 0; i < 5; i++)
+		g_assert (strstr (messages->pdata[i], "test-rate: core"));
+	g_assert (strstr (messages->pdata[7], "suppressed 3 messages of domain CORE due to rate limiting"));
+	g_assert (strstr (messages->pdata[8], "test-rate: refilled"));
+	g_assert (strstr (messages->pdata[9], "test-rate: disabled"));
+}
+
+/*****************************************************************************/
+
+NMTST_DEFINE ();
+
+int
+main (int argc, char **argv)
+{
+	nmtst_init_with_logging (&argc, &argv, "INFO", "ALL");
+
+	/* the tests log at level INFO and need to see those messages. */
+	g_assert (nm_logging_setup ("INFO", "ALL", NULL, NULL));
+
+	g_mutex_init (&capture.lock);
+	g_mutex_init (&capture.gate);
+	g_log_set_handler (G_LOG_DOMAIN, G_LOG_LEVEL_MASK, _capture_handler, NULL);
+
+	g_test_add_func ("/logging/async/overflow", test_async_overflow);
+	g_test_add_func ("/logging/async/flush-on-error", test_async_flush_on_error);
+	g_test_add_func ("/logging/rate-limit", test_rate_limit);
+
+	return g_test_run ();
+}
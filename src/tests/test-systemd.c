@@ -21,6 +21,11 @@
 
 #include "systemd/nm-sd.h"
 
+#include <sys/socket.h>
+
+#include "nm-sd-adapt.h"
+#include "dhcp-internal.h"
+
 #include "nm-test-utils-core.h"
 
 /*****************************************************************************
@@ -93,6 +98,125 @@ test_dhcp_create (void)
 
 /*****************************************************************************/
 
+typedef struct {
+	DHCPRawMuxSlot *slot;
+	guint n_called;
+	gboolean free_slot;
+} TestRawMuxClient;
+
+static int _test_raw_mux_n_opened;
+static int _test_raw_mux_peer_fd = -1;
+
+static int
+_test_raw_mux_open_socket (uint16_t port)
+{
+	int fds[2];
+
+	g_assert (socketpair (AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0, fds) == 0);
+	nm_close (_test_raw_mux_peer_fd);
+	_test_raw_mux_peer_fd = fds[1];
+	_test_raw_mux_n_opened++;
+	return fds[0];
+}
+
+static void
+_test_raw_mux_handler (DHCPPacket *packet, size_t len, bool checksum, void *userdata)
+{
+	TestRawMuxClient *client = userdata;
+
+	g_assert (packet);
+	g_assert_cmpint (len, ==, sizeof (DHCPPacket));
+	client->n_called++;
+	if (client->free_slot)
+		client->slot = dhcp_raw_mux_slot_free (client->slot);
+}
+
+static int
+_test_raw_mux_dispatch (uint16_t port, int ifindex, uint32_t xid)
+{
+	DHCPPacket packet = { };
+
+	packet.dhcp.xid = htobe32 (xid);
+	return dhcp_raw_mux_dispatch (port, ifindex, &packet, sizeof (packet), TRUE);
+}
+
+static void
+test_dhcp_raw_mux (void)
+{
+	int (*open_socket_orig) (uint16_t port) = dhcp_raw_mux_open_socket;
+	sd_event *event = NULL;
+	sd_event *other_event = NULL;
+	TestRawMuxClient a = { }, b = { }, c = { }, d = { };
+	int r;
+
+	dhcp_raw_mux_open_socket = _test_raw_mux_open_socket;
+	_test_raw_mux_n_opened = 0;
+
+	g_assert_cmpint (sd_event_new (&event), >=, 0);
+	g_assert_cmpint (sd_event_new (&other_event), >=, 0);
+
+	/* one socket for all clients on the same port. */
+	r = dhcp_raw_mux_add (event, 0, 1, 0x1111, 68, _test_raw_mux_handler, &a, &a.slot);
+	g_assert_cmpint (r, ==, 0);
+	r = dhcp_raw_mux_add (event, 0, 2, 0x1111, 68, _test_raw_mux_handler, &b, &b.slot);
+	g_assert_cmpint (r, ==, 0);
+	r = dhcp_raw_mux_add (event, 0, 1, 0x2222, 68, _test_raw_mux_handler, &c, &c.slot);
+	g_assert_cmpint (r, ==, 0);
+	g_assert_cmpint (_test_raw_mux_n_opened, ==, 1);
+	g_assert_cmpint (dhcp_raw_mux_slot_get_fd (a.slot), >=, 0);
+	g_assert_cmpint (dhcp_raw_mux_slot_get_fd (a.slot), ==, dhcp_raw_mux_slot_get_fd (b.slot));
+	g_assert_cmpint (dhcp_raw_mux_slot_get_fd (a.slot), ==, dhcp_raw_mux_slot_get_fd (c.slot));
+
+	/* a different event loop cannot share it. */
+	r = dhcp_raw_mux_add (other_event, 0, 3, 0x3333, 68, _test_raw_mux_handler, &d, &d.slot);
+	g_assert_cmpint (r, ==, -EBUSY);
+	g_assert (!d.slot);
+
+	/* dispatched by ifindex and xid. */
+	g_assert_cmpint (_test_raw_mux_dispatch (68, 1, 0x1111), ==, 1);
+	g_assert_cmpint (a.n_called, ==, 1);
+	g_assert_cmpint (_test_raw_mux_dispatch (68, 2, 0x1111), ==, 1);
+	g_assert_cmpint (b.n_called, ==, 1);
+	g_assert_cmpint (_test_raw_mux_dispatch (68, 1, 0x2222), ==, 1);
+	g_assert_cmpint (c.n_called, ==, 1);
+	g_assert_cmpint (a.n_called, ==, 1);
+
+	/* nobody is interested in these. */
+	g_assert_cmpint (_test_raw_mux_dispatch (68, 2, 0x2222), ==, 0);
+	g_assert_cmpint (_test_raw_mux_dispatch (68, 3, 0x1111), ==, 0);
+	g_assert_cmpint (_test_raw_mux_dispatch (67, 1, 0x1111), ==, 0);
+	g_assert_cmpint (a.n_called + b.n_called + c.n_called, ==, 3);
+
+	a.slot = dhcp_raw_mux_slot_free (a.slot);
+	g_assert_cmpint (_test_raw_mux_dispatch (68, 1, 0x1111), ==, 0);
+	g_assert_cmpint (a.n_called, ==, 1);
+
+	/* the handlers may drop their slot, even the last one. */
+	b.free_slot = TRUE;
+	c.free_slot = TRUE;
+	g_assert_cmpint (_test_raw_mux_dispatch (68, 2, 0x1111), ==, 1);
+	g_assert (!b.slot);
+	g_assert_cmpint (_test_raw_mux_dispatch (68, 1, 0x2222), ==, 1);
+	g_assert (!c.slot);
+	g_assert_cmpint (_test_raw_mux_dispatch (68, 1, 0x2222), ==, 0);
+
+	/* the socket went away with the last slot. */
+	r = dhcp_raw_mux_add (other_event, 0, 3, 0x3333, 68, _test_raw_mux_handler, &d, &d.slot);
+	g_assert_cmpint (r, ==, 0);
+	g_assert_cmpint (_test_raw_mux_n_opened, ==, 2);
+	g_assert_cmpint (_test_raw_mux_dispatch (68, 3, 0x3333), ==, 1);
+	g_assert_cmpint (d.n_called, ==, 1);
+	d.slot = dhcp_raw_mux_slot_free (d.slot);
+
+	sd_event_unref (event);
+	sd_event_unref (other_event);
+	nm_close (_test_raw_mux_peer_fd);
+	_test_raw_mux_peer_fd = -1;
+	dhcp_raw_mux_open_socket = open_socket_orig;
+}
+
+/*****************************************************************************/
+
 static void
 test_lldp_create (void)
 {
@@ -181,6 +305,7 @@ main (int argc, char **argv)
 	nmtst_init_assert_logging (&argc, &argv, "INFO", "ALL");
 
 	g_test_add_func ("/systemd/dhcp/create", test_dhcp_create);
+	g_test_add_func ("/systemd/dhcp/raw-mux", test_dhcp_raw_mux);
 	g_test_add_func ("/systemd/lldp/create", test_lldp_create);
 	g_test_add_func ("/systemd/sd-event", test_sd_event);
 